@@ -0,0 +1,133 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <string>
+
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h> // For getrusage
+#define BENCH_HAS_RUSAGE 1
+#endif
+
+#include "Warehouse.hpp"
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+
+/**
+ * @brief Benchmark for the memory cost of building and tearing down a warehouse.
+ *
+ * Replaces the global allocation functions of this program with counting
+ * versions, then fills a warehouse with products (names long enough to
+ * defeat the small-string optimisation) and destroys it again, twice: first
+ * handing it products allocated by the caller (addProduct), then letting it
+ * build them in its own pool (createProduct). Reports heap allocations, frees,
+ * time per phase and the peak resident set size.
+ */
+namespace
+{
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> frees{0};
+    std::atomic<std::size_t> allocatedBytes{0};
+}
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *block = std::malloc(size ? size : 1))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *block) noexcept
+{
+    if (block)
+    {
+        frees.fetch_add(1, std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void operator delete(void *block, std::size_t) noexcept
+{
+    operator delete(block);
+}
+
+static long peakRssKiB()
+{
+#ifdef BENCH_HAS_RUSAGE
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+#else
+    return -1;
+#endif
+}
+
+int main()
+{
+    constexpr int productCount = 1000000;
+
+    auto fill = [](Warehouse &warehouse, bool inPlace)
+    {
+        warehouse.reserve(productCount);
+        for (int i = 0; i < productCount; ++i)
+        {
+            std::string name = "Catalog product #" + std::to_string(i);
+            Money price = Money::fromCents(100 + (i % 1000) * 100);
+            if (inPlace)
+            {
+                static constexpr ProductType types[] = {ProductType::Electronic, ProductType::Clothing, ProductType::Food};
+                static const std::string attributes[] = {"2 years", "M", "2025-12-31"};
+                static constexpr double weights[] = {1.0, 0.3, 0.2};
+                warehouse.createProduct(types[i % 3], name, price, 5, weights[i % 3], attributes[i % 3]);
+                continue;
+            }
+            switch (i % 3)
+            {
+            case 0:
+                warehouse.addProduct(std::make_unique<Electronic>(name, price, 5, 1.0, "2 years"));
+                break;
+            case 1:
+                warehouse.addProduct(std::make_unique<Clothing>(name, price, 5, 0.3, "M"));
+                break;
+            default:
+                warehouse.addProduct(std::make_unique<Food>(name, price, 5, 0.2, "2025-12-31"));
+                break;
+            }
+        }
+    };
+
+    std::cout << std::fixed << std::setprecision(2) << "products: " << productCount << "\n";
+    for (int round = 1; round <= 2; ++round)
+    {
+        auto warehouse = std::make_unique<Warehouse>();
+
+        std::size_t allocationsBefore = allocations.load();
+        std::size_t bytesBefore = allocatedBytes.load();
+        auto start = std::chrono::steady_clock::now();
+        fill(*warehouse, round == 2);
+        double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::size_t buildAllocations = allocations.load() - allocationsBefore;
+        std::size_t buildBytes = allocatedBytes.load() - bytesBefore;
+
+        std::size_t freesBefore = frees.load();
+        start = std::chrono::steady_clock::now();
+        warehouse.reset();
+        double teardownMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::size_t teardownFrees = frees.load() - freesBefore;
+
+        std::cout << "round " << round << (round == 2 ? " (createProduct):\n" : " (addProduct):\n")
+                  << "  build:    " << buildMs << " ms, " << buildAllocations << " allocations, "
+                  << buildBytes / (1024.0 * 1024.0) << " MiB requested\n"
+                  << "  teardown: " << teardownMs << " ms, " << teardownFrees << " frees\n";
+    }
+    std::cout << "peak RSS: " << peakRssKiB() / 1024.0 << " MiB\n";
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Warehouse.hpp"
+#include "CatalogVersions.hpp"
+#include "CatalogWriter.hpp"
+#include "Clothing.hpp"
+
+/**
+ * @brief Benchmark for multi-version catalog views.
+ *
+ * One million products. Times publishing the first version, publishing with
+ * no change, after 100 setPrice calls and after a bulk reprice, acquiring
+ * and releasing a view, and exporting a view as catalog text. Then runs three reader threads that acquire views and
+ * scan them in full while the main thread reprices every product to one new
+ * price and publishes, 50 times over; every view must show a single price
+ * across the whole catalog (no half-applied reprice).
+ */
+int main()
+{
+    constexpr int productCount = 1000000;
+    constexpr int publishRounds = 50;
+    constexpr int readerThreads = 3;
+
+    Warehouse warehouse;
+    warehouse.reserve(productCount);
+    for (int i = 0; i < productCount; ++i)
+    {
+        warehouse.addProduct(std::make_unique<Clothing>("Item " + std::to_string(i), Money::fromCents(100), 5, 0.3, "M"));
+    }
+    const int firstId = warehouse.getStore().ids().front();
+
+    auto elapsedMs = [](auto start)
+    { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); };
+
+    auto start = std::chrono::steady_clock::now();
+    CatalogVersions versions(warehouse);
+    const double first = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    versions.publish(warehouse);
+    const double unchanged = elapsedMs(start);
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        warehouse.setPrice(firstId + i * 9973, Money::fromCents(150));
+    }
+    start = std::chrono::steady_clock::now();
+    versions.publish(warehouse);
+    const double fewPrices = elapsedMs(start);
+
+    warehouse.reprice(PriceAdjustment::set(Money::fromCents(100)));
+    start = std::chrono::steady_clock::now();
+    versions.publish(warehouse);
+    const double reprice = elapsedMs(start);
+
+    constexpr int acquisitions = 1000000;
+    start = std::chrono::steady_clock::now();
+    std::size_t sizes = 0;
+    for (int i = 0; i < acquisitions; ++i)
+    {
+        sizes += versions.acquire().size();
+    }
+    const double acquireNs = elapsedMs(start) * 1e6 / acquisitions;
+
+    std::string exported;
+    start = std::chrono::steady_clock::now();
+    {
+        CatalogView view = versions.acquire();
+        CatalogWriter::appendText(view, exported);
+    }
+    const double exportMs = elapsedMs(start);
+
+    std::atomic<bool> done{false};
+    std::atomic<long long> viewsRead{0};
+    std::atomic<long long> tornViews{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < readerThreads; ++t)
+    {
+        readers.emplace_back([&]
+                             {
+            while (!done.load(std::memory_order_acquire))
+            {
+                CatalogView view = versions.acquire();
+                const Money price = view.price(0);
+                bool uniform = true;
+                for (std::size_t slot = 0; slot < view.size(); ++slot)
+                    uniform = uniform && view.price(slot) == price;
+                tornViews += uniform ? 0 : 1;
+                ++viewsRead;
+            } });
+    }
+    std::size_t mostRetired = 0;
+    start = std::chrono::steady_clock::now();
+    for (int round = 1; round <= publishRounds; ++round)
+    {
+        warehouse.reprice(PriceAdjustment::set(Money::fromCents(100 + round)));
+        versions.publish(warehouse);
+        mostRetired = std::max(mostRetired, versions.retiredVersions());
+    }
+    const double concurrent = elapsedMs(start);
+    done.store(true, std::memory_order_release);
+    for (std::thread &reader : readers)
+        reader.join();
+    versions.publish(warehouse); // Frees the versions the readers held last
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "products:                   " << productCount << " (" << sizes / acquisitions << " per view)\n"
+              << "first publish:              " << first << " ms\n"
+              << "publish, nothing changed:   " << unchanged << " ms\n"
+              << "publish, 100 setPrice:      " << fewPrices << " ms\n"
+              << "publish, bulk reprice:      " << reprice << " ms\n"
+              << "acquire + release a view:   " << acquireNs << " ns\n"
+              << "export a view as text:      " << exportMs << " ms (" << exported.size() / 1024 << " KiB)\n"
+              << "concurrent:                 " << publishRounds << " reprice + publish rounds in " << concurrent
+              << " ms while " << readerThreads << " readers scanned " << viewsRead.load() << " full views\n"
+              << "  torn views:               " << tornViews.load() << "\n"
+              << "  most versions retired:    " << mostRetired << ", " << versions.retiredVersions()
+              << " left at the end (current version " << versions.version() << ")\n";
+    return 0;
+}
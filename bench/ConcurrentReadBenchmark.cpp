@@ -0,0 +1,122 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "Warehouse.hpp"
+#include "ConcurrentWarehouse.hpp"
+#include "Food.hpp"
+
+/**
+ * @brief Benchmark for read scaling across threads.
+ *
+ * One million products; every thread performs four million random reads of
+ * price and quantity, so the total work grows with the thread count and
+ * perfect scaling keeps the wall time flat. Runs 1, 2, 4, 8 and 16 threads
+ * against ConcurrentWarehouse::read and against a Warehouse guarded by one
+ * std::shared_mutex (findProductById under a shared lock), and prints the
+ * aggregate reads per second and the speed-up over one thread.
+ *
+ * Scaling can only be near-linear up to the number of hardware threads, which
+ * is printed first; beyond that the threads share cores.
+ */
+int main()
+{
+    constexpr int productCount = 1000000;
+    constexpr int readsPerThread = 4000000;
+    const unsigned threadCounts[] = {1, 2, 4, 8, 16};
+
+    Warehouse warehouse;
+    warehouse.reserve(productCount);
+    for (int i = 0; i < productCount; ++i)
+    {
+        warehouse.addProduct(std::make_unique<Food>("Item", Money::fromCents(100 + i % 5000), 5, 0.2, "2025-12-31"));
+    }
+    const int firstId = warehouse.getStore().ids().front();
+    ConcurrentWarehouse concurrent(warehouse);
+    std::shared_mutex warehouseMutex;
+
+    // Runs body(seed) on the given number of threads, started together, and returns the wall time
+    auto runThreads = [](unsigned threads, auto &&body)
+    {
+        std::atomic<unsigned> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]
+                                 {
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                body(0x9E3779B97F4A7C15ull * (t + 1)); });
+        }
+        while (ready.load() != threads)
+            std::this_thread::yield();
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread &worker : workers)
+            worker.join();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // Per-thread xorshift, so picking IDs shares no state between threads
+    auto nextId = [firstId](std::uint64_t &state)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return firstId + static_cast<int>(state % productCount);
+    };
+
+    std::atomic<long long> checksum{0};
+    auto concurrentReads = [&](std::uint64_t state)
+    {
+        long long units = 0;
+        for (int r = 0; r < readsPerThread; ++r)
+        {
+            if (auto reading = concurrent.read(nextId(state)))
+                units += reading->quantity + reading->price.cents();
+        }
+        checksum.fetch_add(units);
+    };
+    auto lockedReads = [&](std::uint64_t state)
+    {
+        long long units = 0;
+        for (int r = 0; r < readsPerThread; ++r)
+        {
+            std::shared_lock lock(warehouseMutex);
+            if (auto product = warehouse.findProductById(nextId(state)))
+                units += (*product)->getQuantity() + (*product)->getPrice().cents();
+        }
+        checksum.fetch_add(units);
+    };
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n"
+              << "products:         " << productCount << ", " << readsPerThread << " reads per thread\n\n"
+              << "threads   ConcurrentWarehouse (M reads/s, speed-up)   shared_mutex Warehouse (M reads/s, speed-up)\n"
+              << std::fixed << std::setprecision(2);
+    double concurrentBase = 0;
+    double lockedBase = 0;
+    for (unsigned threads : threadCounts)
+    {
+        const double reads = static_cast<double>(readsPerThread) * threads / 1e6;
+        const double concurrentRate = reads / runThreads(threads, concurrentReads);
+        const double lockedRate = reads / runThreads(threads, lockedReads);
+        if (threads == 1)
+        {
+            concurrentBase = concurrentRate;
+            lockedBase = lockedRate;
+        }
+        std::cout << std::setw(7) << threads << std::setw(15) << concurrentRate << std::setw(10)
+                  << concurrentRate / concurrentBase << "x" << std::setw(34) << lockedRate << std::setw(10)
+                  << lockedRate / lockedBase << "x\n";
+    }
+    std::cout << "\naccesses counted: " << concurrent.accessCount() << " (checksum " << checksum.load() << ")\n";
+    return 0;
+}
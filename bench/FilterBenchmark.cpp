@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Warehouse.hpp"
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+#include "CatalogWriter.hpp"
+
+/**
+ * @brief Benchmark for the Warehouse bitmap indexes.
+ *
+ * Evaluates "clothing in size M or L, or electronics without a 3 year
+ * warranty, that are in stock" over one million products three ways: a
+ * dynamic_cast and a field check per Product object, a scan of the type,
+ * attribute and quantity columns, and word-level AND/OR/NOT over the bitmap
+ * indexes. Then reprices and exports the result through the bitmap selection.
+ */
+int main()
+{
+    constexpr int productCount = 1000000;
+    constexpr int rounds = 10;
+
+    const char *sizes[] = {"XS", "S", "M", "L", "XL"};
+    const char *warranties[] = {"1 year", "2 years", "3 years"};
+    Warehouse warehouse;
+    warehouse.reserve(productCount);
+    for (int i = 0; i < productCount; ++i)
+    {
+        Money price = Money::fromCents(100 + (i % 1000) * 100);
+        const int quantity = i % 7 == 0 ? 0 : 5;
+        switch (i % 3)
+        {
+        case 0:
+            warehouse.addProduct(std::make_unique<Electronic>("Item", price, quantity, 1.0, warranties[i / 3 % 3]));
+            break;
+        case 1:
+            warehouse.addProduct(std::make_unique<Clothing>("Item", price, quantity, 0.3, sizes[i / 3 % 5]));
+            break;
+        default:
+            warehouse.addProduct(std::make_unique<Food>("Item", price, quantity, 0.2, "2025-12-31"));
+            break;
+        }
+    }
+
+    auto timeMs = [](auto &&body)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r)
+        {
+            body();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+    };
+
+    std::size_t perObjectCount = 0;
+    double perObject = timeMs([&]
+                              {
+        std::vector<int> ids;
+        for (const auto &p : warehouse.getProducts())
+        {
+            bool match = false;
+            if (const auto *clothing = dynamic_cast<const Clothing *>(p))
+                match = clothing->getSize() == "M" || clothing->getSize() == "L";
+            else if (const auto *electronic = dynamic_cast<const Electronic *>(p))
+                match = electronic->getWarranty() != "3 years";
+            if (match && p->getQuantity() > 0)
+                ids.push_back(p->getId());
+        }
+        perObjectCount = ids.size(); });
+
+    const ProductStore &store = warehouse.getStore();
+    const InternedString m("M"), l("L"), threeYears("3 years");
+    std::size_t columnCount = 0;
+    double columns = timeMs([&]
+                            {
+        auto types = store.types();
+        auto attributes = store.attributeHandles();
+        auto quantities = store.quantities();
+        std::vector<std::uint8_t> mask(store.size());
+        for (std::size_t slot = 0; slot < store.size(); ++slot)
+        {
+            const bool clothing = types[slot] == ProductType::Clothing && (attributes[slot] == m || attributes[slot] == l);
+            const bool electronic = types[slot] == ProductType::Electronic && !(attributes[slot] == threeYears);
+            mask[slot] = (clothing || electronic) && quantities[slot] > 0;
+        }
+        columnCount = std::count(mask.begin(), mask.end(), std::uint8_t{1}); });
+
+    Bitmap selection;
+    double bitmaps = timeMs([&]
+                            {
+        selection = (warehouse.idsWithAttribute(ProductType::Clothing, m) |
+                     warehouse.idsWithAttribute(ProductType::Clothing, l) |
+                     (warehouse.idsOfType(ProductType::Electronic) -
+                      warehouse.idsWithAttribute(ProductType::Electronic, threeYears))) &
+                    warehouse.inStockIds(); });
+
+    std::vector<std::uint8_t> mask;
+    double toMask = timeMs([&]
+                           {
+        mask.assign(store.size(), 1);
+        selection.select(store.ids(), mask); });
+
+    ProductFilter filter;
+    filter.selection = selection;
+    std::size_t repriced = 0;
+    double reprice = timeMs([&] { repriced = warehouse.reprice(PriceAdjustment::multiply(0.99), filter); });
+
+    auto start = std::chrono::steady_clock::now();
+    auto exported = CatalogWriter::saveFile("filtered_catalog.txt", warehouse, selection);
+    double exportMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::remove("filtered_catalog.txt");
+
+    std::size_t indexBytes = warehouse.allProductIds().bytes() + warehouse.inStockIds().bytes();
+    for (ProductType type : {ProductType::Electronic, ProductType::Clothing, ProductType::Food})
+        indexBytes += warehouse.idsOfType(type).bytes();
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "products:                  " << productCount << " (" << selection.size() << " selected)\n"
+              << "dynamic_cast per product:  " << perObject << " ms (" << perObjectCount << ")\n"
+              << "column scan:               " << columns << " ms (" << columnCount << ")\n"
+              << "bitmap AND/OR/NOT:         " << bitmaps << " ms\n"
+              << "bitmap to slot mask:       " << toMask << " ms\n"
+              << "reprice (selection):       " << reprice << " ms (" << repriced << " products)\n"
+              << "export (selection):        " << exportMs << " ms ("
+              << (exported ? *exported : 0) << " products)\n"
+              << "type/stock/all bitmaps:    " << indexBytes / 1024.0 << " KiB\n";
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "Warehouse.hpp"
+#include "OrderManager.hpp"
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+
+/**
+ * @brief Benchmark for order fulfillment throughput.
+ *
+ * One million orders of 1 to 8 lines over 200,000 products (a third each of
+ * electronics, clothing and food with dates spread over a year) whose stock
+ * covers roughly 80% of the demand. Fulfills them once with a per-line loop
+ * (findProductById and updateQuantity for every line) and once with
+ * OrderManager::processAllOrders, each on a fresh warehouse, then restocks
+ * and runs processAllOrders again over the orders left partially fulfilled
+ * or backordered.
+ */
+int main()
+{
+    constexpr int productCount = 200000;
+    constexpr int orderCount = 1000000;
+
+    auto makeWarehouse = []
+    {
+        Warehouse warehouse;
+        warehouse.reserve(productCount);
+        const char *sizes[] = {"S", "M", "L"};
+        for (int i = 0; i < productCount; ++i)
+        {
+            Money price = Money::fromCents(100 + i % 5000);
+            switch (i % 3)
+            {
+            case 0:
+                warehouse.addProduct(std::make_unique<Electronic>("Item", price, 45, 1.0, "2 years"));
+                break;
+            case 1:
+                warehouse.addProduct(std::make_unique<Clothing>("Item", price, 45, 0.3, sizes[i / 3 % 3]));
+                break;
+            default:
+            {
+                const std::string month = std::to_string(101 + i / 3 % 12).substr(1);
+                const std::string day = std::to_string(101 + i / 36 % 28).substr(1);
+                warehouse.addProduct(std::make_unique<Food>("Item", price, 45, 0.2, "2026-" + month + "-" + day));
+                break;
+            }
+            }
+        }
+        return warehouse;
+    };
+
+    Warehouse warehouse = makeWarehouse();
+    const int firstId = warehouse.getStore().ids().front();
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, productCount - 1);
+    std::uniform_int_distribution<int> lines(1, 8);
+    std::uniform_int_distribution<int> quantity(1, 4);
+    OrderManager orderManager;
+    std::size_t lineCount = 0;
+    for (int o = 0; o < orderCount; ++o)
+    {
+        Order order;
+        for (int n = lines(rng); n > 0; --n)
+        {
+            order.addItem(firstId + pick(rng), quantity(rng));
+        }
+        lineCount += order.itemCount();
+        orderManager.createOrder(order);
+    }
+
+    auto elapsedMs = [](auto start)
+    { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); };
+
+    // Per-line baseline on its own copy of the stock
+    Warehouse baselineWarehouse = makeWarehouse();
+    const int baselineOffset = baselineWarehouse.getStore().ids().front() - firstId; // New products got new IDs
+    auto start = std::chrono::steady_clock::now();
+    long long baselineShipped = 0;
+    for (const Order &order : orderManager.getOrders())
+    {
+        for (const auto &[productId, wanted] : order.getItems())
+        {
+            const int id = productId + baselineOffset;
+            if (auto product = baselineWarehouse.findProductById(id))
+            {
+                const int units = std::min(wanted, (*product)->getQuantity());
+                baselineWarehouse.updateQuantity(id, -units);
+                baselineShipped += units;
+            }
+        }
+    }
+    double baseline = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    FulfillmentSummary first = orderManager.processAllOrders(warehouse);
+    double batch = elapsedMs(start);
+
+    for (int i = 0; i < productCount; ++i)
+    {
+        warehouse.updateQuantity(firstId + i, 20);
+    }
+    start = std::chrono::steady_clock::now();
+    FulfillmentSummary second = orderManager.processAllOrders(warehouse);
+    double retry = elapsedMs(start);
+
+    auto perSecond = [](std::size_t count, double ms) { return count / ms / 1000.0; };
+    std::cout << std::fixed << std::setprecision(2)
+              << "orders:                   " << orderCount << " (" << lineCount << " lines)\n"
+              << "per-line loop:            " << baseline << " ms (" << baselineShipped << " units shipped)\n"
+              << "processAllOrders:         " << batch << " ms, " << perSecond(orderCount, batch)
+              << " M orders/s (" << first.unitsShipped << " units shipped)\n"
+              << "  fulfilled / partial / backordered: " << first.fulfilled << " / "
+              << first.partiallyFulfilled << " / " << first.backordered << "\n"
+              << "after restocking:         " << retry << " ms for " << second.ordersProcessed << " orders ("
+              << second.fulfilled << " fulfilled, " << second.unitsOutstanding << " units outstanding)\n";
+    return 0;
+}
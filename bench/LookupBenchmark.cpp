@@ -0,0 +1,69 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include "Warehouse.hpp"
+#include "Electronic.hpp"
+#include "RandomGenerator.hpp"
+
+/**
+ * @brief Benchmark for Warehouse::findProductById.
+ *
+ * Builds catalogs of growing size and measures the average cost of a lookup
+ * through the ID index next to a plain linear scan over getProducts(). The
+ * indexed column should stay roughly flat while the scan grows with the catalog.
+ */
+int main()
+{
+    constexpr int lookups = 200000;
+    const std::vector<int> catalogSizes = {1000, 10000, 100000, 500000};
+
+    std::cout << std::setw(10) << "products"
+              << std::setw(18) << "indexed ns/op"
+              << std::setw(18) << "scan ns/op" << "\n";
+
+    for (int size : catalogSizes)
+    {
+        Warehouse warehouse;
+        for (int i = 0; i < size; ++i)
+        {
+            warehouse.addProduct(std::make_unique<Electronic>("Item", Money::fromCents(1000 + i % 100 * 100), 5, 1.0, "2 years"));
+        }
+        auto products = warehouse.getProducts();
+        int firstId = products.front()->getId();
+        int lastId = products.back()->getId();
+
+        std::vector<int> ids(lookups);
+        RandomGenerator::fillInts(ids, firstId, lastId);
+
+        Money checksum;
+        auto start = std::chrono::steady_clock::now();
+        for (int id : ids)
+        {
+            auto result = warehouse.findProductById(id);
+            checksum += result ? (*result)->getPrice() : Money();
+        }
+        auto indexedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        // The scan is much slower, so only a slice of the lookups is timed for it
+        int scanLookups = std::max(1, lookups / (size / 1000));
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < scanLookups; ++i)
+        {
+            int id = ids[i];
+            auto it = std::find_if(products.begin(), products.end(),
+                                   [id](const Product *p) { return p->getId() == id; });
+            checksum += it != products.end() ? (*it)->getPrice() : Money();
+        }
+        auto scanNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::setw(10) << size
+                  << std::setw(18) << std::fixed << std::setprecision(1) << indexedNs / lookups
+                  << std::setw(18) << scanNs / scanLookups
+                  << "   (checksum " << checksum << ")\n";
+    }
+    return 0;
+}
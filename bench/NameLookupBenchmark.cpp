@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Warehouse.hpp"
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+#include "RandomGenerator.hpp"
+
+/**
+ * @brief Benchmark for name lookups at one million products.
+ *
+ * Measures exact lookups through Warehouse::findProductByName (hash index)
+ * and "starts with" lookups through findProductsByPrefix (ordered index)
+ * next to the linear scans they replace, plus the cost of keeping the indexes
+ * up to date while renaming. The scans are much slower, so only a slice of
+ * the lookups is timed for them.
+ */
+int main()
+{
+    constexpr int productCount = 1000000;
+    constexpr int lookups = 200000;
+    constexpr int scanLookups = 50;
+
+    Warehouse warehouse;
+    warehouse.reserve(productCount);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < productCount; ++i)
+    {
+        std::string name = "Catalog product #" + std::to_string(i);
+        Money price = Money::fromCents(100 + (i % 1000) * 100);
+        switch (i % 3)
+        {
+        case 0:
+            warehouse.addProduct(std::make_unique<Electronic>(name, price, 5, 1.0, "2 years"));
+            break;
+        case 1:
+            warehouse.addProduct(std::make_unique<Clothing>(name, price, 5, 0.3, "M"));
+            break;
+        default:
+            warehouse.addProduct(std::make_unique<Food>(name, price, 5, 0.2, "2025-12-31"));
+            break;
+        }
+    }
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    auto products = warehouse.getProducts();
+
+    std::vector<std::string> names(lookups);
+    std::vector<std::string> prefixes(lookups);
+    for (int i = 0; i < lookups; ++i)
+    {
+        int n = RandomGenerator::getRandomInt(0, productCount - 1);
+        names[i] = "Catalog product #" + std::to_string(n);
+        prefixes[i] = "Catalog product #" + std::to_string(n / 100); // Up to 111 matches
+    }
+    auto nsPerOp = [](auto start, int count)
+    { return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count; };
+
+    std::size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (const std::string &name : names)
+    {
+        found += warehouse.findProductByName(name).has_value();
+    }
+    double exactIndexed = nsPerOp(start, lookups);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < scanLookups; ++i)
+    {
+        const std::string &name = names[i];
+        found += std::find_if(products.begin(), products.end(),
+                              [&name](const Product *p) { return p->getName() == name; }) != products.end();
+    }
+    double exactScan = nsPerOp(start, scanLookups);
+
+    std::size_t matches = 0;
+    start = std::chrono::steady_clock::now();
+    for (const std::string &prefix : prefixes)
+    {
+        matches += warehouse.findProductsByPrefix(prefix).size();
+    }
+    double prefixIndexed = nsPerOp(start, lookups);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < scanLookups; ++i)
+    {
+        const std::string &prefix = prefixes[i];
+        matches += std::count_if(products.begin(), products.end(),
+                                 [&prefix](const Product *p) { return p->getName().starts_with(prefix); });
+    }
+    double prefixScan = nsPerOp(start, scanLookups);
+
+    const int firstId = products.front()->getId();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; ++i)
+    {
+        warehouse.renameProduct(firstId + i, "Renamed product #" + std::to_string(i));
+    }
+    double rename = nsPerOp(start, lookups);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "products:              " << productCount << " (built in " << buildMs << " ms)\n"
+              << "exact, hash index:     " << exactIndexed << " ns/op\n"
+              << "exact, linear scan:    " << exactScan << " ns/op\n"
+              << "prefix, ordered index: " << prefixIndexed << " ns/op\n"
+              << "prefix, linear scan:   " << prefixScan << " ns/op\n"
+              << "rename (index upkeep): " << rename << " ns/op\n"
+              << "checksum:              " << found << " found, " << matches << " prefix matches\n";
+    return 0;
+}
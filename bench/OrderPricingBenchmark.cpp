@@ -0,0 +1,140 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+
+#include "Warehouse.hpp"
+#include "OrderManager.hpp"
+#include "Food.hpp"
+
+/**
+ * @brief Benchmark for batch order pricing.
+ *
+ * Prices 200,000 orders of 1 to 16 lines against one million products, with
+ * about one line in a hundred referring to a product that was removed. Compares
+ * Order::totalPrice per order (one findProductById and, for a missing product,
+ * one std::cerr message per line; the messages go to a discarded buffer here)
+ * with OrderManager::priceOrders over all orders and over a tenth of them.
+ * Then reads the cached totals (OrderManager::orderTotals) the way a dashboard
+ * would: the first time, again without changes, after 100 setPrice calls
+ * (twice: the first time also builds the product-to-orders index) and after a
+ * bulk reprice.
+ */
+int main()
+{
+    constexpr int productCount = 1000000;
+    constexpr int orderCount = 200000;
+    constexpr int rounds = 5;
+
+    Warehouse warehouse;
+    warehouse.reserve(productCount);
+    for (int i = 0; i < productCount; ++i)
+    {
+        warehouse.addProduct(std::make_unique<Food>("Item", Money::fromCents(100 + i % 5000), 5, 0.2, "2025-12-31"));
+    }
+    const int firstId = warehouse.getStore().ids().front();
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, productCount - 1);
+    std::uniform_int_distribution<int> lines(1, 16);
+    std::uniform_int_distribution<int> quantity(1, 5);
+    OrderManager orderManager;
+    std::size_t lineCount = 0;
+    for (int o = 0; o < orderCount; ++o)
+    {
+        Order order;
+        for (int n = lines(rng); n > 0; --n)
+        {
+            order.addItem(firstId + pick(rng), quantity(rng));
+        }
+        lineCount += order.itemCount();
+        orderManager.createOrder(order);
+    }
+    for (int i = 0; i < productCount; i += 100)
+    {
+        warehouse.removeProduct(firstId + i);
+    }
+
+    auto timeMs = [](auto &&body)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r)
+        {
+            body();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+    };
+
+    std::ostringstream discarded;
+    std::streambuf *cerrBuffer = std::cerr.rdbuf(discarded.rdbuf());
+    Money perOrderSum;
+    double perOrder = timeMs([&]
+                             {
+        discarded.str({});
+        perOrderSum = Money();
+        for (const Order &order : orderManager.getOrders())
+            perOrderSum += order.totalPrice(warehouse); });
+    std::cerr.rdbuf(cerrBuffer);
+
+    OrderPricing pricing;
+    Money batchSum;
+    double batch = timeMs([&]
+                          {
+        pricing = orderManager.priceOrders(warehouse);
+        batchSum = Money();
+        for (Money total : pricing.totals)
+            batchSum += total; });
+
+    std::vector<std::size_t> tenth;
+    for (std::size_t index = 0; index < orderManager.getOrders().size(); index += 10)
+    {
+        tenth.push_back(index);
+    }
+    double selected = timeMs([&] { pricing = orderManager.priceOrders(warehouse, tenth); });
+
+    auto onceMs = [](auto &&body)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto sumOf = [](std::span<const Money> totals)
+    {
+        Money sum;
+        for (Money total : totals)
+            sum += total;
+        return sum;
+    };
+
+    std::span<const Money> totals;
+    double cold = onceMs([&] { totals = orderManager.orderTotals(warehouse); });
+    double warm = timeMs([&] { totals = orderManager.orderTotals(warehouse); });
+    auto setPrices = [&](Money price)
+    {
+        for (int i = 1; i <= 100; ++i)
+            warehouse.setPrice(firstId + i * 9973 + 1, price);
+    };
+    setPrices(Money::fromCents(12345));
+    double indexAndSetPrice = onceMs([&] { totals = orderManager.orderTotals(warehouse); });
+    setPrices(Money::fromCents(23456));
+    double afterSetPrice = onceMs([&] { totals = orderManager.orderTotals(warehouse); });
+    const bool adjustedExactly = sumOf(totals) == sumOf(orderManager.priceOrders(warehouse).totals);
+    warehouse.reprice(PriceAdjustment::multiply(0.99));
+    double afterReprice = onceMs([&] { totals = orderManager.orderTotals(warehouse); });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "orders:                    " << orderCount << " (" << lineCount << " lines)\n"
+              << "totalPrice per order:      " << perOrder << " ms (sum " << perOrderSum << ")\n"
+              << "priceOrders (all):         " << batch << " ms (sum " << batchSum << ", "
+              << orderManager.priceOrders(warehouse).missing.size() << " missing lines)\n"
+              << "priceOrders (every 10th):  " << selected << " ms (" << pricing.totals.size() << " orders)\n"
+              << "orderTotals, first call:   " << cold << " ms\n"
+              << "orderTotals, unchanged:    " << warm << " ms\n"
+              << "orderTotals, 100 setPrice: " << indexAndSetPrice << " ms (building the index), then "
+              << afterSetPrice << " ms ("
+              << (adjustedExactly ? "same sum as priceOrders" : "MISMATCH") << ")\n"
+              << "orderTotals, bulk reprice: " << afterReprice << " ms\n";
+    return 0;
+}
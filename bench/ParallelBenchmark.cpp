@@ -0,0 +1,130 @@
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Warehouse.hpp"
+#include "OrderManager.hpp"
+#include "TaskScheduler.hpp"
+#include "Food.hpp"
+
+/**
+ * @brief Benchmark for the bulk operations on the task scheduler.
+ *
+ * For 1, 2, 4 and 8 threads, builds the same warehouse of 500,000 products
+ * with random prices and 200,000 orders of 1 to 8 lines, then times a bulk
+ * reprice, sortByPriceAscending, priceOrders and processAllOrders, plus a
+ * parallelReduce of one million doubles. Each run's results (prices, storage
+ * order, order totals, fulfillment summary and the floating-point sum) are
+ * folded into a checksum that must be the same for every thread count.
+ */
+int main()
+{
+    constexpr int productCount = 500000;
+    constexpr int orderCount = 200000;
+    const std::size_t threadCounts[] = {1, 2, 4, 8};
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> priceCents(100, 100000);
+    std::vector<int> prices(productCount);
+    for (int &price : prices)
+        price = priceCents(rng);
+    std::uniform_int_distribution<int> pick(0, productCount - 1);
+    std::uniform_int_distribution<int> lines(1, 8);
+    std::uniform_int_distribution<int> quantity(1, 4);
+    std::vector<std::vector<std::pair<int, int>>> orderLines(orderCount); // (product index, quantity)
+    for (auto &order : orderLines)
+        for (int n = lines(rng); n > 0; --n)
+            order.emplace_back(pick(rng), quantity(rng));
+    std::uniform_real_distribution<double> real(0.0, 1.0);
+    std::vector<double> values(1000000);
+    for (double &value : values)
+        value = real(rng);
+
+    auto elapsedMs = [](auto start)
+    { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); };
+    auto mix = [](std::uint64_t hash, std::uint64_t value) { return (hash ^ value) * 0x100000001B3ull; };
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n"
+              << "products: " << productCount << ", orders: " << orderCount << "\n\n"
+              << "threads  reprice   sort  priceOrders  processAllOrders  reduce (ms)   checksum\n"
+              << std::fixed << std::setprecision(2);
+    std::uint64_t firstChecksum = 0;
+    bool deterministic = true;
+    for (std::size_t threads : threadCounts)
+    {
+        TaskScheduler::global().setThreadCount(threads);
+        Warehouse warehouse;
+        warehouse.reserve(productCount);
+        for (int i = 0; i < productCount; ++i)
+            warehouse.addProduct(std::make_unique<Food>("Item", Money::fromCents(prices[i]), 40, 0.2, "2026-01-01"));
+        const int firstId = warehouse.getStore().ids().front();
+        OrderManager orderManager;
+        for (const auto &order : orderLines)
+        {
+            Order created;
+            for (const auto &[index, units] : order)
+                created.addItem(firstId + index, units);
+            orderManager.createOrder(created);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        const PriceAdjustment steps[] = {PriceAdjustment::multiply(1.07), PriceAdjustment::add(Money::fromCents(-50)),
+                                         PriceAdjustment::clamp(Money::fromCents(99), Money::fromCents(90000))};
+        warehouse.reprice(steps);
+        const double reprice = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        warehouse.sortByPriceAscending();
+        const double sort = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        OrderPricing pricing = orderManager.priceOrders(warehouse);
+        const double pricingMs = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        FulfillmentSummary summary = orderManager.processAllOrders(warehouse);
+        const double fulfillment = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        const double sum = TaskScheduler::global().parallelReduce(
+            0, values.size(), 4096, 0.0,
+            [&](std::size_t from, std::size_t to)
+            {
+                double partial = 0.0;
+                for (std::size_t i = from; i < to; ++i)
+                    partial += values[i];
+                return partial;
+            },
+            [](double total, double partial) { return total + partial; });
+        const double reduce = elapsedMs(start);
+
+        std::uint64_t checksum = 0xCBF29CE484222325ull;
+        const ProductStore &store = warehouse.getStore();
+        for (std::size_t slot = 0; slot < store.size(); ++slot)
+        {
+            checksum = mix(checksum, static_cast<std::uint64_t>(store.ids()[slot] - firstId));
+            checksum = mix(checksum, static_cast<std::uint64_t>(store.prices()[slot].cents()));
+            checksum = mix(checksum, static_cast<std::uint64_t>(store.quantities()[slot]));
+        }
+        for (Money total : pricing.totals)
+            checksum = mix(checksum, static_cast<std::uint64_t>(total.cents()));
+        checksum = mix(checksum, static_cast<std::uint64_t>(summary.unitsShipped));
+        checksum = mix(checksum, summary.fulfilled * 1000003 + summary.partiallyFulfilled);
+        checksum = mix(checksum, std::bit_cast<std::uint64_t>(sum));
+        if (threads == threadCounts[0])
+            firstChecksum = checksum;
+        deterministic = deterministic && checksum == firstChecksum;
+
+        std::cout << std::setw(7) << threads << std::setw(9) << reprice << std::setw(7) << sort << std::setw(13)
+                  << pricingMs << std::setw(18) << fulfillment << std::setw(13) << reduce << "   " << std::hex
+                  << checksum << std::dec << "\n";
+    }
+    std::cout << "\nresults " << (deterministic ? "identical" : "DIFFER") << " across thread counts\n";
+    return deterministic ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+
+#include "Warehouse.hpp"
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+
+/**
+ * @brief Benchmark for Warehouse::reprice.
+ *
+ * Compares the old object-at-a-time repricing (Product::setPrice over
+ * standalone Product objects; the warehouse's view is read-only) with the vectorised column kernels, both over the full catalog
+ * and over a filtered subset.
+ */
+int main()
+{
+    constexpr int productCount = 1000000;
+    constexpr int rounds = 10;
+
+    Warehouse warehouse;
+    std::vector<std::unique_ptr<Product>> objects; // The same catalog as standalone objects, for the old way
+    objects.reserve(productCount);
+    for (int i = 0; i < productCount; ++i)
+    {
+        Money price = Money::fromCents(100 + (i % 1000) * 100);
+        switch (i % 3)
+        {
+        case 0:
+            objects.push_back(std::make_unique<Electronic>("Item", price, 5, 1.0, "2 years"));
+            warehouse.createProduct(ProductType::Electronic, "Item", price, 5, 1.0, "2 years");
+            break;
+        case 1:
+            objects.push_back(std::make_unique<Clothing>("Item", price, 5, 0.3, "M"));
+            warehouse.createProduct(ProductType::Clothing, "Item", price, 5, 0.3, "M");
+            break;
+        default:
+            objects.push_back(std::make_unique<Food>("Item", price, 5, 0.2, "2025-12-31"));
+            warehouse.createProduct(ProductType::Food, "Item", price, 5, 0.2, "2025-12-31");
+            break;
+        }
+    }
+
+    auto timeMs = [](auto &&body)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r)
+        {
+            body();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+    };
+
+    const std::int64_t onePercentOff = *Money::toPpm(0.99);
+    double perObject = timeMs([&]
+                              {
+        for (const auto &p : objects)
+        {
+            p->setPrice(p->getPrice().scaled(onePercentOff));
+        } });
+    double allColumns = timeMs([&] { warehouse.reprice(PriceAdjustment::multiply(0.99)); });
+
+    ProductFilter filter;
+    filter.type = ProductType::Food;
+    filter.minPrice = Money::fromCents(10000);
+    filter.maxPrice = Money::fromCents(50000);
+    const PriceAdjustment steps[] = {PriceAdjustment::multiply(1.05),
+                                     PriceAdjustment::clamp(Money::fromCents(12000), Money::fromCents(45000))};
+    double filtered = timeMs([&] { warehouse.reprice(steps, filter); });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "products:                 " << productCount << "\n"
+              << "per-object setPrice:      " << perObject << " ms\n"
+              << "column kernel (all):      " << allColumns << " ms\n"
+              << "column kernel (filtered): " << filtered << " ms\n"
+              << "stock value checksum:     " << warehouse.totalStockValue() << "\n";
+    return 0;
+}
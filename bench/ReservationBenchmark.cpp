@@ -0,0 +1,193 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentWarehouse.hpp"
+#include "Order.hpp"
+#include "Clothing.hpp"
+
+/**
+ * @brief Benchmark for concurrent stock reservation under a hot-SKU pattern.
+ *
+ * 100,000 products, of which the hottest 1% receive 90% of all order lines.
+ * Each thread reserves 500,000 orders of 1 to 4 lines, all-or-nothing, and
+ * gives every tenth one back; the hot products run out at the higher thread
+ * counts, so refused reservations are measured too. Compares
+ * ConcurrentWarehouse::reserveStock (a compare-and-swap per line, no lock)
+ * with the same stock held in a plain array behind one std::mutex, at 1, 2, 4, 8 and 16 threads, and checks that
+ * no unit was lost or created: the stock left plus the units reserved must
+ * equal the starting stock.
+ */
+int main()
+{
+    constexpr int productCount = 100000;
+    constexpr int hotCount = productCount / 100;
+    constexpr int ordersPerThread = 500000;
+    const unsigned threadCounts[] = {1, 2, 4, 8, 16};
+
+    auto startingStock = [](int index) { return index < hotCount ? 10000 : 50; };
+
+    std::vector<std::unique_ptr<Clothing>> products;
+    std::vector<int> productIds;
+    products.reserve(productCount);
+    productIds.reserve(productCount);
+    for (int i = 0; i < productCount; ++i)
+    {
+        products.push_back(std::make_unique<Clothing>("Item", Money::fromCents(100), startingStock(i), 0.3, "M"));
+        productIds.push_back(products.back()->getId());
+    }
+    const int firstId = productIds.front();
+
+    // Orders are generated up front, per thread, so the timed loops only reserve
+    std::vector<std::vector<Order>> orders(threadCounts[std::size(threadCounts) - 1]);
+    for (std::size_t t = 0; t < orders.size(); ++t)
+    {
+        std::mt19937 rng(static_cast<unsigned>(t + 1));
+        std::uniform_int_distribution<int> hot(0, hotCount - 1);
+        std::uniform_int_distribution<int> cold(hotCount, productCount - 1);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> lines(1, 4);
+        std::uniform_int_distribution<int> quantity(1, 3);
+        orders[t].resize(ordersPerThread);
+        for (Order &order : orders[t])
+        {
+            for (int n = lines(rng); n > 0; --n)
+                order.addItem(productIds[percent(rng) < 90 ? hot(rng) : cold(rng)], quantity(rng));
+        }
+    }
+
+    // Runs body(thread) on the given number of threads, started together, and returns the wall time
+    auto runThreads = [](unsigned threads, auto &&body)
+    {
+        std::atomic<unsigned> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]
+                                 {
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                body(t); });
+        }
+        while (ready.load() != threads)
+            std::this_thread::yield();
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread &worker : workers)
+            worker.join();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    struct Tally
+    {
+        std::atomic<long long> reserved{0};
+        std::atomic<long long> units{0};
+        std::atomic<long long> refused{0};
+    };
+
+    auto runLockFree = [&](unsigned threads, Tally &tally, long long &stockLeft)
+    {
+        ConcurrentWarehouse warehouse;
+        for (const auto &product : products)
+            warehouse.addProduct(*product);
+        double seconds = runThreads(threads, [&](unsigned t)
+                                    {
+            long long reserved = 0, units = 0, refused = 0;
+            for (int o = 0; o < ordersPerThread; ++o)
+            {
+                const Order &order = orders[t][o];
+                if (!warehouse.reserveStock(order))
+                {
+                    ++refused;
+                    continue;
+                }
+                ++reserved;
+                if (o % 10 == 0)
+                    warehouse.releaseStock(order);
+                else
+                    for (const auto &item : order.getItems())
+                        units += item.quantity;
+            }
+            tally.reserved += reserved;
+            tally.units += units;
+            tally.refused += refused; });
+        stockLeft = 0;
+        for (int id : productIds)
+            stockLeft += warehouse.read(id)->quantity;
+        return seconds;
+    };
+
+    auto runLocked = [&](unsigned threads, Tally &tally, long long &stockLeft)
+    {
+        std::vector<int> stock(productCount);
+        for (int i = 0; i < productCount; ++i)
+            stock[i] = startingStock(i);
+        std::mutex stockMutex;
+        double seconds = runThreads(threads, [&](unsigned t)
+                                    {
+            long long reserved = 0, units = 0, refused = 0;
+            for (int o = 0; o < ordersPerThread; ++o)
+            {
+                const Order &order = orders[t][o];
+                std::unique_lock lock(stockMutex);
+                bool enough = true;
+                for (const auto &item : order.getItems())
+                    enough = enough && stock[item.productId - firstId] >= item.quantity;
+                if (!enough)
+                {
+                    ++refused;
+                    continue;
+                }
+                for (const auto &item : order.getItems())
+                    stock[item.productId - firstId] -= item.quantity;
+                ++reserved;
+                if (o % 10 == 0)
+                    for (const auto &item : order.getItems())
+                        stock[item.productId - firstId] += item.quantity;
+                else
+                    for (const auto &item : order.getItems())
+                        units += item.quantity;
+            }
+            tally.reserved += reserved;
+            tally.units += units;
+            tally.refused += refused; });
+        stockLeft = 0;
+        for (int units : stock)
+            stockLeft += units;
+        return seconds;
+    };
+
+    long long totalStock = 0;
+    for (int i = 0; i < productCount; ++i)
+        totalStock += startingStock(i);
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n"
+              << "products:         " << productCount << " (" << hotCount << " hot, 90% of lines), "
+              << ordersPerThread << " orders per thread\n\n"
+              << "threads   reserveStock (M orders/s, refused)   std::mutex (M orders/s, refused)   units conserved\n"
+              << std::fixed << std::setprecision(2);
+    for (unsigned threads : threadCounts)
+    {
+        Tally lockFree;
+        Tally locked;
+        long long lockFreeLeft = 0;
+        long long lockedLeft = 0;
+        const double millions = static_cast<double>(ordersPerThread) * threads / 1e6;
+        const double lockFreeRate = millions / runLockFree(threads, lockFree, lockFreeLeft);
+        const double lockedRate = millions / runLocked(threads, locked, lockedLeft);
+        const bool conserved = lockFreeLeft + lockFree.units == totalStock && lockedLeft + locked.units == totalStock;
+        std::cout << std::setw(7) << threads << std::setw(15) << lockFreeRate << std::setw(10) << lockFree.refused
+                  << std::setw(25) << lockedRate << std::setw(10) << locked.refused << std::setw(18)
+                  << (conserved ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "Warehouse.hpp"
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+#include "CatalogLoader.hpp"
+#include "CatalogWriter.hpp"
+
+/**
+ * @brief Benchmark for saving the catalog as text.
+ *
+ * Compares the old save path (a dynamic_cast chain per product and iostream
+ * formatting through the Product objects) with CatalogWriter, which formats
+ * straight from the columns using the type tag. Both write into memory so
+ * that only the formatting cost is measured; the output of the new path is
+ * loaded back to check it round-trips.
+ */
+static void legacySave(std::ostream &file, const Warehouse &warehouse)
+{
+    for (const auto &p_ptr : warehouse.getProducts())
+    {
+        if (const auto *ep = dynamic_cast<const Electronic *>(p_ptr))
+        {
+            file << "Electronic " << std::quoted(ep->getName()) << " " << ep->getPrice() << " "
+                 << ep->getQuantity() << " " << ep->getWeight() << " " << std::quoted(ep->getWarranty()) << "\n";
+        }
+        else if (const auto *cp = dynamic_cast<const Clothing *>(p_ptr))
+        {
+            file << "Clothing " << std::quoted(cp->getName()) << " " << cp->getPrice() << " "
+                 << cp->getQuantity() << " " << cp->getWeight() << " " << std::quoted(cp->getSize()) << "\n";
+        }
+        else if (const auto *fp = dynamic_cast<const Food *>(p_ptr))
+        {
+            file << "Food " << std::quoted(fp->getName()) << " " << fp->getPrice() << " "
+                 << fp->getQuantity() << " " << fp->getWeight() << " " << std::quoted(fp->getExpirationDate()) << "\n";
+        }
+    }
+}
+
+int main()
+{
+    constexpr int productCount = 500000;
+    constexpr int rounds = 5;
+
+    Warehouse warehouse;
+    warehouse.reserve(productCount);
+    for (int i = 0; i < productCount; ++i)
+    {
+        Money price = Money::fromCents(125 + (i % 1000) * 100);
+        std::string name = "Item " + std::to_string(i);
+        switch (i % 3)
+        {
+        case 0:
+            warehouse.addProduct(std::make_unique<Electronic>(name, price, i % 50, 1.5, "2 years"));
+            break;
+        case 1:
+            warehouse.addProduct(std::make_unique<Clothing>(name, price, i % 50, 0.3, "M"));
+            break;
+        default:
+            warehouse.addProduct(std::make_unique<Food>(name, price, i % 50, 0.2, "2025-12-31"));
+            break;
+        }
+    }
+
+    std::size_t legacyBytes = 0;
+    std::size_t columnBytes = 0;
+    std::string text;
+    auto timeMs = [](auto &&body)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r)
+        {
+            body();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+    };
+
+    double legacy = timeMs([&]
+                           {
+        std::ostringstream out;
+        legacySave(out, warehouse);
+        legacyBytes = out.str().size(); });
+    double columns = timeMs([&]
+                            {
+        text.clear();
+        CatalogWriter::appendText(warehouse.getStore(), text);
+        columnBytes = text.size(); });
+
+    Warehouse reloaded;
+    LoadReport report = CatalogLoader::loadText(text, reloaded);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "products:                    " << productCount << "\n"
+              << "dynamic_cast + iostream:     " << legacy << " ms (" << legacyBytes << " bytes)\n"
+              << "type tag + column writer:    " << columns << " ms (" << columnBytes << " bytes)\n"
+              << "speedup:                     " << legacy / columns << "x\n"
+              << "round trip:                  " << report.loaded << " loaded, " << report.errors.size()
+              << " errors, stock value " << reloaded.totalStockValue() << " vs " << warehouse.totalStockValue()
+              << "\n";
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Warehouse.hpp"
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+#include "RandomGenerator.hpp"
+
+/**
+ * @brief Benchmark for typo-tolerant name search at one million products.
+ *
+ * Names are made of a brand, an adjective, a noun and a model number, so
+ * common words occur in tens of thousands of names and rare ones in a few.
+ * Reports the time to build the trigram index, its size, and the median and
+ * 99th-percentile latency of Warehouse::searchProducts for whole words, the
+ * start of a word, misspelled words and model numbers that mostly do not exist.
+ */
+int main()
+{
+    constexpr int productCount = 1000000;
+    constexpr int queriesPerKind = 2000;
+    constexpr std::size_t k = 10;
+
+    const std::vector<std::string> brands = {"Acme", "Globex", "Initech", "Umbrella", "Hooli", "Vandelay", "Soylent",
+                                             "Stark", "Wayne", "Tyrell", "Cyberdyne", "Wonka", "Gringotts", "Oscorp"};
+    const std::vector<std::string> adjectives = {"Organic", "Imported", "Wireless", "Premium", "Classic", "Compact",
+                                                 "Deluxe", "Vintage", "Smart", "Portable", "Slim", "Rugged"};
+    const std::vector<std::string> nouns = {"Smartphone", "Laptop", "Headphones", "Cheese", "Yogurt", "Coffee",
+                                            "Jacket", "Sneakers", "Scarf", "Monitor", "Keyboard", "Chocolate",
+                                            "Blender", "Backpack", "Sweater", "Tablet", "Camera", "Biscuits"};
+    auto pick = [](const std::vector<std::string> &words) -> const std::string &
+    { return words[RandomGenerator::getRandomInt(0, static_cast<int>(words.size()) - 1)]; };
+
+    Warehouse warehouse;
+    warehouse.reserve(productCount);
+    for (int i = 0; i < productCount; ++i)
+    {
+        std::string name = pick(brands) + " " + pick(adjectives) + " " + pick(nouns) + " " +
+                           std::to_string(RandomGenerator::getRandomInt(100, 99999));
+        Money price = Money::fromCents(100 + (i % 1000) * 100);
+        switch (i % 3)
+        {
+        case 0:
+            warehouse.addProduct(std::make_unique<Electronic>(name, price, 5, 1.0, "2 years"));
+            break;
+        case 1:
+            warehouse.addProduct(std::make_unique<Clothing>(name, price, 5, 0.3, "M"));
+            break;
+        default:
+            warehouse.addProduct(std::make_unique<Food>(name, price, 5, 0.2, "2025-12-31"));
+            break;
+        }
+    }
+
+    // The first search builds the index
+    auto start = std::chrono::steady_clock::now();
+    std::size_t hits = warehouse.searchProducts("warmup", k).size();
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Drops or swaps one letter of a word
+    auto misspell = [](std::string word)
+    {
+        std::size_t at = RandomGenerator::getRandomInt(1, static_cast<int>(word.size()) - 2);
+        if (RandomGenerator::getRandomInt(0, 1) == 0)
+            word.erase(at, 1);
+        else
+            std::swap(word[at], word[at + 1]);
+        return word;
+    };
+
+    struct Kind
+    {
+        const char *label;
+        std::vector<std::string> queries;
+    };
+    std::vector<Kind> kinds = {{"whole words", {}}, {"word fragments", {}}, {"misspelled", {}}, {"model number", {}}};
+    for (int i = 0; i < queriesPerKind; ++i)
+    {
+        kinds[0].queries.push_back(pick(brands) + " " + pick(nouns));
+        const std::string &noun = pick(nouns);
+        kinds[1].queries.push_back(noun.substr(0, 5)); // As typed so far
+        kinds[2].queries.push_back(misspell(pick(adjectives)) + " " + misspell(noun));
+        kinds[3].queries.push_back(pick(nouns) + " " + std::to_string(RandomGenerator::getRandomInt(100, 99999)));
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "products:        " << productCount << "\n"
+              << "index build:     " << buildMs << " ms\n"
+              << "posting lists:   " << warehouse.trigramIndex().postingBytes() / (1024.0 * 1024.0) << " MiB\n";
+    for (const Kind &kind : kinds)
+    {
+        std::vector<double> latencies;
+        latencies.reserve(kind.queries.size());
+        for (const std::string &query : kind.queries)
+        {
+            auto queryStart = std::chrono::steady_clock::now();
+            hits += warehouse.searchProducts(query, k).size();
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - queryStart).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << std::left << std::setw(17) << (std::string(kind.label) + ":") << std::right
+                  << "p50 " << latencies[latencies.size() / 2] << " us, p99 "
+                  << latencies[latencies.size() * 99 / 100] << " us\n";
+    }
+    std::cout << "checksum:        " << hits << " hits\n";
+    return 0;
+}
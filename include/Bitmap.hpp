@@ -0,0 +1,151 @@
+#ifndef BITMAP_HPP
+#define BITMAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Compressed set of 32-bit integers (product IDs), in the style of a roaring bitmap
+ * * Values are split by their high 16 bits into containers of up to 65536
+ * values. A container holding at most arrayLimit values is a sorted array of
+ * the low 16 bits; a fuller one is a plain bitset of 1024 64-bit words. A
+ * sparse set therefore costs about two bytes per value and a dense one about
+ * one bit per possible value, and a container switches representation
+ * whenever it crosses the limit, so equal sets always have equal contents.
+ * * Intersection, union and difference combine the containers pairwise: two
+ * bitsets word by word (AND, OR, AND NOT), an array against a bitset by
+ * testing bits, two arrays by merging. A complement is a difference from the
+ * set of all values of interest.
+ */
+class Bitmap
+{
+public:
+    static constexpr std::size_t arrayLimit = 4096;
+    static constexpr std::size_t wordsPerContainer = 65536 / 64;
+
+private:
+    struct Container
+    {
+        std::uint16_t key = 0; // High 16 bits of every value
+        std::uint32_t cardinality = 0;
+        std::vector<std::uint16_t> values; // Sorted low bits, while cardinality <= arrayLimit
+        std::vector<std::uint64_t> words;  // wordsPerContainer words, while cardinality > arrayLimit
+
+        bool dense() const { return !words.empty(); }
+        bool contains(std::uint16_t low) const;
+
+        /**
+         * @brief Switches to the representation that matches the cardinality
+         */
+        void normalize();
+
+        friend bool operator==(const Container &, const Container &) = default;
+    };
+
+    std::vector<Container> containers_; // Ascending key, none empty
+
+    Container *find(std::uint16_t key);
+    const Container *find(std::uint16_t key) const;
+
+public:
+    void add(std::uint32_t value);
+    void remove(std::uint32_t value);
+    bool contains(std::uint32_t value) const;
+    void clear() { containers_.clear(); }
+
+    /**
+     * @brief Builds a set from values in strictly ascending order
+     * * Fills each container in one go, which bulk loaders use instead of one
+     * add() per value.
+     */
+    static Bitmap fromSorted(std::span<const std::uint32_t> values);
+
+    /**
+     * @brief Gets the number of values in the set
+     */
+    std::size_t size() const;
+    bool empty() const { return containers_.empty(); }
+
+    Bitmap &operator&=(const Bitmap &other);
+    Bitmap &operator|=(const Bitmap &other);
+    Bitmap &operator-=(const Bitmap &other); // AND NOT
+
+    friend Bitmap operator&(Bitmap a, const Bitmap &b)
+    {
+        a &= b;
+        return a;
+    }
+    friend Bitmap operator|(Bitmap a, const Bitmap &b)
+    {
+        a |= b;
+        return a;
+    }
+    friend Bitmap operator-(Bitmap a, const Bitmap &b)
+    {
+        a -= b;
+        return a;
+    }
+    friend bool operator==(const Bitmap &, const Bitmap &) = default;
+
+    /**
+     * @brief Calls visit(value) for every value, in ascending order
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for (const Container &container : containers_)
+        {
+            const std::uint32_t high = static_cast<std::uint32_t>(container.key) << 16;
+            if (!container.dense())
+            {
+                for (std::uint16_t low : container.values)
+                    visit(high | low);
+                continue;
+            }
+            for (std::size_t w = 0; w < wordsPerContainer; ++w)
+            {
+                for (std::uint64_t word = container.words[w]; word != 0; word &= word - 1)
+                    visit(high | static_cast<std::uint32_t>(w * 64 + std::countr_zero(word)));
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the values as product IDs, in ascending order
+     */
+    std::vector<int> toVector() const;
+
+    /**
+     * @brief Clears the mask byte of every ID that is not in the set
+     * * Meant for columns in mostly ascending order: the container found for
+     * one ID is reused for the next as long as the high bits agree.
+     * * @param ids The IDs to test
+     * @param mask One byte per ID, ANDed with its membership
+     */
+    void select(std::span<const int> ids, std::span<std::uint8_t> mask) const;
+
+    /**
+     * @brief Gets the number of bytes held by the containers
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Appends a compact binary form of the set to a string
+     */
+    void serialize(std::string &out) const;
+
+    /**
+     * @brief Reads a set written by serialize()
+     * * @param data The bytes to read, in full
+     * @return The set, or an error message if the data is malformed
+     */
+    static std::expected<Bitmap, std::string> deserialize(std::string_view data);
+};
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef CATALOGLOADER_HPP
+#define CATALOGLOADER_HPP
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Product.hpp"
+#include "ProductStore.hpp"
+#include "StringArena.hpp"
+
+class Warehouse; // Forward declaration
+
+/**
+ * @brief A malformed line found while loading a catalog
+ */
+struct LoadError
+{
+    std::size_t line;    // 1-based line number in the input
+    std::string message; // What was wrong with the line
+};
+
+/**
+ * @brief Outcome of loading a catalog: how many products were added and which lines were rejected
+ */
+struct LoadReport
+{
+    std::size_t loaded = 0;
+    std::vector<LoadError> errors;
+};
+
+/**
+ * @brief One product record as parsed from text, before a Product object is built
+ * * The strings are views into the parsed text, or into the side buffer given
+ * to parse() for the few quoted strings that contained escapes.
+ */
+struct ParsedProduct
+{
+    ProductType type;
+    std::string_view name;
+    Money price;
+    int quantity;
+    double weight;
+    std::string_view attribute; // warranty, size or expiration date depending on type
+};
+
+/**
+ * @brief Fast loader for the text catalog format written by saveProductsToFile
+ * * Each record is one line:
+ * type_string "name" price quantity weight "specific_attribute"
+ * where type_string is Electronic, Clothing or Food and the strings are
+ * written with std::quoted. The loader maps the file into memory and tokenises
+ * it in place with std::from_chars instead of going through iostreams; names
+ * and attributes stay views into the mapping unless they need unescaping.
+ */
+namespace CatalogLoader
+{
+    /**
+     * @brief Parses catalog text into product records
+     * * Malformed lines are skipped and reported; parsing continues with the next line.
+     * * @param text The catalog text; the records' strings point into it, so it must outlive them
+     * @param firstLine The line number of the first line of text (for error messages)
+     * @param rows Receives the parsed records, in input order
+     * @param errors Receives one entry per rejected line
+     * @param unescaped Holds the unescaped copies of quoted strings that contained a backslash
+     */
+    void parse(std::string_view text, std::size_t firstLine, std::vector<ParsedProduct> &rows,
+               std::vector<LoadError> &errors, StringArena &unescaped);
+
+    /**
+     * @brief Parses catalog text and adds every valid product to the warehouse
+     * * Products are inserted in input order after a single up-front reservation.
+     * * @param text The catalog text
+     * @param warehouse The warehouse to add products to
+     * @return A report with the number of products added and the rejected lines
+     */
+    LoadReport loadText(std::string_view text, Warehouse &warehouse);
+
+    /**
+     * @brief Inputs smaller than this many bytes are always parsed on one thread
+     */
+    inline constexpr std::size_t parallelThreshold = 1 << 20;
+
+    /**
+     * @brief Parses catalog text on several threads and adds every valid product to the warehouse
+     * * The text is cut into chunks that are parsed concurrently into
+     * per-thread batches. The cuts are guessed record boundaries; when a
+     * guess turns out to lie inside a record (a quoted name may contain
+     * newlines), that chunk is parsed again from the true boundary. The
+     * batches are merged in input order, so products, product IDs and errors
+     * are the same as with loadText.
+     * * @param text The catalog text
+     * @param warehouse The warehouse to add products to
+     * @param threads Number of worker threads; 0 means one per hardware thread
+     * @return A report as for loadText
+     */
+    LoadReport loadTextParallel(std::string_view text, Warehouse &warehouse, unsigned threads = 0);
+
+    /**
+     * @brief Memory-maps a catalog file and loads it into the warehouse
+     * * @param filename The path of the catalog file
+     * @param warehouse The warehouse to add products to
+     * @param threads Number of parser threads, as for loadTextParallel
+     * @return A report as for loadText, or an error message if the file cannot be read
+     */
+    std::expected<LoadReport, std::string> loadFile(const std::string &filename, Warehouse &warehouse,
+                                                    unsigned threads = 0);
+}
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef CATALOGVERSIONS_HPP
+#define CATALOGVERSIONS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Money.hpp"
+#include "ProductType.hpp"
+#include "StringArena.hpp"
+#include "InternPool.hpp"
+
+class Warehouse;
+
+/**
+ * @brief Number of product slots in one catalog page; the same as Warehouse::changePageSize
+ */
+inline constexpr std::size_t catalogPageSize = 1024;
+
+/**
+ * @brief The hot fields of up to catalogPageSize consecutive slots; never changed once published
+ */
+struct CatalogPricePage
+{
+    std::uint64_t stamp = 0; // The warehouse's change stamp for this page when it was copied
+    std::array<int, catalogPageSize> ids;
+    std::array<Money, catalogPageSize> prices;
+    std::array<int, catalogPageSize> quantities;
+    std::array<ProductType, catalogPageSize> types;
+};
+
+/**
+ * @brief The names, weights and attributes of up to catalogPageSize consecutive slots; never changed once published
+ * * Kept apart from the hot fields so a reprice or a stock change copies no strings.
+ */
+struct CatalogDetailPage
+{
+    std::uint64_t stamp = 0; // The warehouse's change stamp for this page when it was copied
+    StringArena strings;
+    std::array<std::string_view, catalogPageSize> names; // Views into strings
+    std::array<double, catalogPageSize> weights;
+    std::array<InternedString, catalogPageSize> attributes;
+};
+
+/**
+ * @brief One published state of the catalog: a list of shared, immutable pages
+ */
+struct CatalogVersion
+{
+    std::uint64_t number = 0;
+    std::uint64_t changeStamp = 0; // The warehouse's change stamp when this version was published
+    std::size_t size = 0;
+    std::vector<std::shared_ptr<const CatalogPricePage>> pricePages;
+    std::vector<std::shared_ptr<const CatalogDetailPage>> detailPages;
+};
+
+class CatalogVersions;
+
+/**
+ * @brief A reader's immutable view of the catalog as of one published version
+ * * Slots are numbered as in the warehouse's store at publish time. The view
+ * keeps its version alive until it is destroyed (or moved from), however
+ * many versions are published meanwhile; hold it only as long as the report
+ * that needs it, since it also keeps every later version from being freed.
+ */
+class CatalogView
+{
+    const CatalogVersion *version_ = nullptr;
+    std::atomic<std::uint64_t> *pin_ = nullptr; // The reader slot this view occupies
+
+    friend class CatalogVersions;
+    CatalogView(const CatalogVersion *version, std::atomic<std::uint64_t> *pin) : version_(version), pin_(pin) {}
+
+    const CatalogPricePage &pricePage(std::size_t slot) const { return *version_->pricePages[slot / catalogPageSize]; }
+    const CatalogDetailPage &detailPage(std::size_t slot) const { return *version_->detailPages[slot / catalogPageSize]; }
+
+public:
+    CatalogView() = default;
+    CatalogView(CatalogView &&other) noexcept
+        : version_(std::exchange(other.version_, nullptr)), pin_(std::exchange(other.pin_, nullptr)) {}
+    CatalogView &operator=(CatalogView &&other) noexcept;
+    CatalogView(const CatalogView &) = delete;
+    CatalogView &operator=(const CatalogView &) = delete;
+    ~CatalogView() { release(); }
+
+    /**
+     * @brief Gives the version back early; the view is empty afterwards
+     */
+    void release();
+
+    /**
+     * @brief Gets the number of the version this view reads (0 for an empty view)
+     */
+    std::uint64_t version() const { return version_ ? version_->number : 0; }
+
+    std::size_t size() const { return version_ ? version_->size : 0; }
+    int id(std::size_t slot) const { return pricePage(slot).ids[slot % catalogPageSize]; }
+    Money price(std::size_t slot) const { return pricePage(slot).prices[slot % catalogPageSize]; }
+    int quantity(std::size_t slot) const { return pricePage(slot).quantities[slot % catalogPageSize]; }
+    ProductType type(std::size_t slot) const { return pricePage(slot).types[slot % catalogPageSize]; }
+    std::string_view name(std::size_t slot) const { return detailPage(slot).names[slot % catalogPageSize]; }
+    double weight(std::size_t slot) const { return detailPage(slot).weights[slot % catalogPageSize]; }
+    InternedString attribute(std::size_t slot) const { return detailPage(slot).attributes[slot % catalogPageSize]; }
+
+    /**
+     * @brief Calculates the value of all stock in this version (sum of price * quantity)
+     */
+    Money totalStockValue() const;
+
+    /**
+     * @brief Writes one line per product, in the format of the built-in types' printInfo()
+     * * Products tagged ProductType::Other show the fields every product has,
+     * since a view holds no subclass to call.
+     * * @param os The stream to write to
+     */
+    void print(std::ostream &os) const;
+};
+
+/**
+ * @brief Multi-version copy of a warehouse catalog for readers on other threads
+ * * One writer thread, the one that owns the Warehouse, calls publish() after
+ * changing it. Any number of reader threads call acquire() for a CatalogView
+ * and run long reports against it (print(), totalStockValue(),
+ * CatalogWriter::saveFile) while the writer carries on; a reader sees every product as of one publish, never
+ * a half-applied reprice.
+ * * Versions share their pages. The warehouse stamps every page a change
+ * touches (see Warehouse::hotPageStamps()), and publish() copies only the
+ * pages whose stamp differs from the one their current copy was taken at,
+ * so a few setPrice calls copy a few pages, a bulk reprice copies the price
+ * pages but not the names, and a publish with no change returns at once.
+ * The new version is then installed with one atomic pointer store.
+ * * Replaced versions are freed by epoch-based reclamation. A reader pins the
+ * current epoch in one of a fixed set of reader slots before loading the
+ * version pointer, and clears it when its view is released. Each replaced
+ * version is retired with the epoch in which it was replaced, and freed by
+ * the writer once no pinned epoch is that old. Readers never wait for the
+ * writer and the writer never waits for readers; readers only wait for each
+ * other if more than readerSlots views are held at once.
+ * * All views must be released before the CatalogVersions is destroyed.
+ */
+class CatalogVersions
+{
+public:
+    static constexpr std::size_t readerSlots = 128;
+
+private:
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<std::uint64_t> pinnedEpoch{0}; // 0 when free
+    };
+
+    ReaderSlot readers_[readerSlots];
+    std::atomic<std::uint64_t> epoch_{1};
+    std::atomic<const CatalogVersion *> current_{nullptr};
+    std::atomic<std::uint64_t> currentNumber_{0}; // Number of current_, readable without pinning it
+    std::vector<std::pair<std::uint64_t, std::unique_ptr<const CatalogVersion>>> retired_; // Writer only
+    std::unique_ptr<const CatalogVersion> latest_;                                          // Owns current_
+
+    void reclaim();
+
+public:
+    /**
+     * @brief Publishes the current state of a warehouse as the first version
+     */
+    explicit CatalogVersions(const Warehouse &warehouse);
+    ~CatalogVersions();
+
+    CatalogVersions(const CatalogVersions &) = delete;
+    CatalogVersions &operator=(const CatalogVersions &) = delete;
+
+    /**
+     * @brief Publishes the current state of a warehouse as a new version
+     * * Writer thread only. Pages the warehouse has not changed since they
+     * were copied are shared with the current version; if no page changed,
+     * nothing is published. Also frees the
+     * retired versions no reader can still see.
+     * * @param warehouse The warehouse to copy, normally the one passed to the constructor
+     * @return The number of the version now current
+     */
+    std::uint64_t publish(const Warehouse &warehouse);
+
+    /**
+     * @brief Gets a view of the current version; safe from any thread
+     */
+    CatalogView acquire();
+
+    /**
+     * @brief Gets the number of the current version; safe from any thread
+     * * Reads a copy of the number, not the version itself, which the writer
+     * may free as soon as it is replaced.
+     */
+    std::uint64_t version() const { return currentNumber_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Gets the number of replaced versions not freed yet (writer thread only)
+     */
+    std::size_t retiredVersions() const { return retired_.size(); }
+};
+
+#endif
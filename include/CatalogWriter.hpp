@@ -0,0 +1,70 @@
+#ifndef CATALOGWRITER_HPP
+#define CATALOGWRITER_HPP
+
+#include <cstddef>
+#include <expected>
+#include <string>
+
+class Warehouse;    // Forward declaration
+class ProductStore; // Forward declaration
+class Bitmap;       // Forward declaration
+class CatalogView;  // Forward declaration
+
+/**
+ * @brief Fast writer for the text catalog format read by CatalogLoader
+ * * Records are formatted straight from the ProductStore columns (or the
+ * pages of a CatalogView): the record
+ * keyword comes from the type tag column, numbers are written with
+ * std::to_chars (shortest form that reads back to the same value) and strings
+ * are quoted the way std::quoted does it. No Product object is touched and no
+ * dynamic_cast is needed.
+ */
+namespace CatalogWriter
+{
+    /**
+     * @brief Appends one catalog line per product to a string
+     * * Products tagged ProductType::Other have no text representation and are skipped.
+     * * @param store The products to format
+     * @param out Receives the catalog text
+     * @return The number of products written
+     */
+    std::size_t appendText(const ProductStore &store, std::string &out);
+
+    /**
+     * @brief Appends one catalog line per product of a catalog version to a string
+     * * @param view The version to format, e.g. acquired on a reader thread from CatalogVersions
+     * @param out Receives the catalog text
+     * @return The number of products written
+     */
+    std::size_t appendText(const CatalogView &view, std::string &out);
+
+    /**
+     * @brief Writes every product of the warehouse to a catalog file
+     * * @param filename The path of the catalog file (replaced if it exists)
+     * @param warehouse The warehouse whose products are written
+     * @return The number of products written, or an error message
+     */
+    std::expected<std::size_t, std::string> saveFile(const std::string &filename, const Warehouse &warehouse);
+
+    /**
+     * @brief Writes the selected products of the warehouse to a catalog file
+     * * @param filename The path of the catalog file (replaced if it exists)
+     * @param warehouse The warehouse whose products are written
+     * @param selection The IDs of the products to write, e.g. built from the warehouse bitmap indexes
+     * @return The number of products written, or an error message
+     */
+    std::expected<std::size_t, std::string> saveFile(const std::string &filename, const Warehouse &warehouse,
+                                                     const Bitmap &selection);
+
+    /**
+     * @brief Writes every product of a catalog version to a catalog file
+     * * Safe on a reader thread while the warehouse keeps changing: only the
+     * view's immutable pages are read.
+     * * @param filename The path of the catalog file (replaced if it exists)
+     * @param view The version whose products are written
+     * @return The number of products written, or an error message
+     */
+    std::expected<std::size_t, std::string> saveFile(const std::string &filename, const CatalogView &view);
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define CLOTHING_HPP
 
 #include "TangibleProduct.hpp"
+#include "InternPool.hpp"
 #include <string>
 #include <iostream> // Required for std::istream
 
@@ -9,10 +10,11 @@
  * @brief Clothing class representing wearable products in inventory
  * * The Clothing class extends TangibleProduct to specifically represent
  * clothing items with additional size information.
+ * Products created by a Warehouse live in that warehouse's SlabPool.
  * * @inherit TangibleProduct
  */
 class Clothing : public TangibleProduct {
-    std::string size_; // e.g. "L", "XL"
+    InternedString size_; // Interned; e.g. "L", "XL"
 
 public:
     /**
@@ -23,7 +25,7 @@ public:
      * @param weight The weight of the clothing item.
      * @param size The size of the clothing item (e.g., "S", "M", "L", "XL").
      */
-    Clothing(const std::string& name, double price, int quantity,
+    Clothing(const std::string& name, Money price, int quantity,
              double weight, const std::string& size);
 
     void printInfo() const override;
@@ -32,7 +34,13 @@ public:
      * @brief Gets the size of the clothing item.
      * @return const std::string& The size of the clothing item.
      */
-    const std::string &getSize() const { return size_; }
+    const std::string &getSize() const { return size_.str(); }
+
+    /**
+     * @brief Gets the size as an interned handle, for O(1) comparison and grouping.
+     * @return InternedString The interned size.
+     */
+    InternedString getSizeHandle() const { return size_; }
 
     /**
      * @brief Input stream operator for the Clothing class.
@@ -0,0 +1,274 @@
+#ifndef CONCURRENTWAREHOUSE_HPP
+#define CONCURRENTWAREHOUSE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Money.hpp"
+#include "ProductType.hpp"
+#include "InternPool.hpp"
+#include "StripedCounter.hpp"
+
+class Order;
+class Product;
+class Warehouse;
+
+/**
+ * @brief Price and stock of one product, read together
+ * * The pair is consistent: the product had exactly this price and this
+ * quantity at one moment during the read.
+ */
+struct StockReading
+{
+    int productId;
+    Money price;
+    int quantity;
+};
+
+/**
+ * @brief Why a stock reservation was refused
+ */
+enum class ReservationError : std::uint8_t
+{
+    InvalidQuantity,  // The requested quantity was not positive
+    UnknownProduct,   // No product has the requested ID
+    InsufficientStock // Fewer units were in stock than requested
+};
+
+/**
+ * @brief Gets the display name of a reservation error (e.g. "insufficient stock")
+ */
+const char *toString(ReservationError error);
+
+/**
+ * @brief A refused stock reservation; for an order, the first line that could not be reserved
+ */
+struct ReservationFailure
+{
+    ReservationError error;
+    int productId;
+    int requested;
+    int available; // Units in stock when the reservation was refused (0 unless InsufficientStock)
+};
+
+/**
+ * @brief Product catalog that any number of threads can read and update at once
+ * * Warehouse keeps its indexes and columns in step on every change and is
+ * meant for one thread. ConcurrentWarehouse trades those indexes for
+ * thread safety: it holds only what lookups and stock updates need (ID,
+ * type, name, price, quantity, weight, attribute) and answers by ID.
+ * * Products are sharded by ID. Each shard owns the entries of its products,
+ * a mutex that serialises adding and removing them (nothing else locks) and
+ * an open-addressing hash table from product ID to entry, probed linearly.
+ * Its size follows the number of products in the shard, not the value of
+ * their IDs. Readers probe the table with acquire loads only, so a read
+ * never waits for a writer in another shard, or for one in the same shard.
+ * When a table fills up, the writer copies the live entries into a larger
+ * one and publishes it with a single pointer store.
+ * * Price and quantity are atomics in the entry. Quantity changes are
+ * compare-and-swap loops, so concurrent updates are never lost. Price changes
+ * go through a per-entry seqlock, which lets read() return a price and a
+ * quantity that belong together; a reader retries only when a price change
+ * overlapped it. Names, types, weights and attributes do not change after a
+ * product is added.
+ * * Stock is reserved with reserveStock(), a compare-and-swap on the product's
+ * quantity that either takes all the requested units or fails without
+ * changing anything, so many threads can reserve the same popular product
+ * without a lock and without clamping.
+ * * Removed entries are unlinked from the table but their memory is kept
+ * until the warehouse is destroyed, so a reader that found the entry just
+ * before the removal still reads valid (if stale) data. Tables that were
+ * replaced by larger ones are kept the same way, for readers still probing
+ * them.
+ */
+class ConcurrentWarehouse
+{
+public:
+    static constexpr std::size_t defaultShardCount = 64;
+
+private:
+    /**
+     * @brief One product; the hot fields share the first cache line
+     */
+    struct alignas(64) Entry
+    {
+        std::atomic<std::uint32_t> version{0}; // Seqlock: odd while the price is being written
+        std::atomic<std::int64_t> priceCents;
+        std::atomic<int> quantity;
+        int id;
+        ProductType type;
+        double weight;
+        InternedString attribute;
+        std::string name;
+
+        Entry(int id, ProductType type, std::string_view name, Money price, int quantity, double weight,
+              InternedString attribute);
+    };
+
+    static constexpr int emptyId = -1; // Product IDs are never negative
+    static constexpr std::size_t firstTableSize = 16;
+
+    /**
+     * @brief One slot of a shard's hash table
+     * * A slot's ID is set once and never changes while the table is in use;
+     * removing the product only clears the entry pointer, and a null entry
+     * reads as "no such product".
+     */
+    struct Slot
+    {
+        std::atomic<int> id{emptyId};
+        std::atomic<Entry *> entry{nullptr};
+    };
+
+    /**
+     * @brief Open-addressing hash table from product ID to entry, kept at most half full
+     */
+    struct Table
+    {
+        std::size_t mask;
+        unsigned shift; // 64 - log2(capacity), for the multiplicative hash
+        std::unique_ptr<Slot[]> slots;
+
+        explicit Table(std::size_t capacity);
+        std::size_t home(int id) const;
+    };
+
+    struct alignas(64) Shard
+    {
+        std::atomic<const Table *> table{nullptr}; // Read without the mutex; null until the first product
+        std::mutex mutex;                           // Held while adding or removing products of this shard
+        std::deque<Entry> entries;                  // Only grows, so entry addresses stay valid
+        std::vector<std::unique_ptr<Table>> tables; // Every table the shard had, the current one last
+        std::size_t usedSlots = 0;                  // Slots of the current table with an ID set
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t shardMask_;
+    std::atomic<std::size_t> size_{0};
+    mutable StripedCounter accessCount_;
+
+    Shard &shardOf(int id) const { return shards_[static_cast<std::size_t>(id) & shardMask_]; }
+    const Entry *locate(int id) const;
+    Entry *locate(int id);
+    static Slot *claimSlot(Shard &shard, int id);
+    static std::expected<void, ReservationFailure> take(Entry *entry, int productId, int quantity);
+    bool insert(int id, ProductType type, std::string_view name, Money price, int quantity, double weight,
+                InternedString attribute);
+
+public:
+    /**
+     * @brief Creates an empty warehouse
+     * * @param shardCount The number of shards, rounded up to a power of two
+     */
+    explicit ConcurrentWarehouse(std::size_t shardCount = defaultShardCount);
+
+    /**
+     * @brief Creates a warehouse holding a copy of every product of a Warehouse
+     * * @param source The warehouse to copy; it is only read
+     * @param shardCount The number of shards, rounded up to a power of two
+     */
+    explicit ConcurrentWarehouse(const Warehouse &source, std::size_t shardCount = defaultShardCount);
+
+    ConcurrentWarehouse(const ConcurrentWarehouse &) = delete;
+    ConcurrentWarehouse &operator=(const ConcurrentWarehouse &) = delete;
+
+    /**
+     * @brief Adds a copy of a product's fields
+     * * Products may be constructed on any thread (their IDs come from an
+     * atomic counter) and added concurrently.
+     * * @param product The product to copy
+     * @return false if a product with the same ID is already present (nothing is added)
+     */
+    bool addProduct(const Product &product);
+
+    /**
+     * @brief Removes a product
+     * * @return false if no product has this ID
+     */
+    bool removeProduct(int productId);
+
+    /**
+     * @brief Reads the price and quantity of a product as one consistent pair
+     * * Lock-free; counts as one access.
+     * * @return The reading, or std::nullopt if no product has this ID
+     */
+    std::optional<StockReading> read(int productId) const;
+
+    /**
+     * @brief Gets the name of a product
+     * * The view stays valid for the life of the warehouse, even after the product is removed.
+     * * @return The name, or std::nullopt if no product has this ID
+     */
+    std::optional<std::string_view> name(int productId) const;
+
+    /**
+     * @brief Sets the price of a product; negative prices become 0
+     * * @return false if no product has this ID
+     */
+    bool setPrice(int productId, Money price);
+
+    /**
+     * @brief Adjusts the quantity of a product; a result below zero becomes 0
+     * * @return false if no product has this ID
+     */
+    bool updateQuantity(int productId, int delta);
+
+    /**
+     * @brief Takes units out of a product's stock if enough are available
+     * * Lock-free: the quantity is compared and swapped until it is either
+     * reduced by the full amount or found to be too small. A failed
+     * reservation leaves the stock unchanged.
+     * * @param productId The product to reserve
+     * @param quantity The number of units, at least 1
+     * @return Nothing on success, or why the reservation was refused
+     */
+    std::expected<void, ReservationFailure> reserveStock(int productId, int quantity);
+
+    /**
+     * @brief Reserves every line of an order, or none of them
+     * * Lines are reserved one after another in product ID order; if one fails,
+     * the units already taken for the earlier lines are put back. Between the
+     * two, other threads see those units as reserved, so a concurrent
+     * reservation may fail because of units that are returned a moment later.
+     * * @param order The order whose lines to reserve
+     * @return Nothing on success, or the failure of the first line that could not be reserved
+     */
+    std::expected<void, ReservationFailure> reserveStock(const Order &order);
+
+    /**
+     * @brief Puts reserved units back into a product's stock
+     * * @return false if no product has this ID or the quantity is not positive
+     */
+    bool releaseStock(int productId, int quantity);
+
+    /**
+     * @brief Puts back the units of every line of an order reserved with reserveStock()
+     * * Lines whose product has been removed since are skipped.
+     */
+    void releaseStock(const Order &order);
+
+    /**
+     * @brief Gets the number of products
+     */
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Gets the number of shards
+     */
+    std::size_t shardCount() const { return shardMask_ + 1; }
+
+    /**
+     * @brief Gets the number of reads (read() and name() calls) so far
+     */
+    std::uint64_t accessCount() const { return accessCount_.value(); }
+};
+
+#endif
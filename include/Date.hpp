@@ -0,0 +1,49 @@
+#ifndef DATE_HPP
+#define DATE_HPP
+
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Calendar date stored as a day number (days since 1970-01-01)
+ * * Four bytes, compared and subtracted as plain integers. Dates are parsed
+ * from and formatted as ISO 8601 text (YYYY-MM-DD).
+ */
+class Date
+{
+    std::int32_t days_ = 0;
+
+    explicit constexpr Date(std::int32_t days) : days_(days) {}
+
+public:
+    constexpr Date() = default;
+
+    /**
+     * @brief Parses a date written as YYYY-MM-DD
+     * * @param text The text to parse; surrounding characters are not allowed
+     * @return The date, or std::nullopt if the text is not a valid calendar date
+     */
+    static std::optional<Date> parse(std::string_view text);
+
+    /**
+     * @brief Gets the current date in UTC
+     */
+    static Date today();
+
+    static constexpr Date fromDays(std::int32_t days) { return Date(days); }
+    constexpr std::int32_t days() const { return days_; }
+
+    /**
+     * @brief Formats the date as YYYY-MM-DD
+     */
+    std::string toString() const;
+
+    constexpr Date addDays(std::int32_t count) const { return Date(days_ + count); }
+
+    friend constexpr auto operator<=>(Date, Date) = default;
+};
+
+#endif
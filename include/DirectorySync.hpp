@@ -0,0 +1,18 @@
+#ifndef DIRECTORYSYNC_HPP
+#define DIRECTORYSYNC_HPP
+
+#include <expected>
+#include <filesystem>
+#include <string>
+
+/**
+ * @brief Flushes a directory's entries to stable storage
+ * * Creating, renaming or removing a file changes its directory, and on POSIX
+ * systems that change is only durable once the directory itself has been
+ * fsynced; flushing the file is not enough. Elsewhere this does nothing.
+ * * @param directory The directory to flush
+ * @return Nothing on success, or an error message
+ */
+std::expected<void, std::string> syncDirectory(const std::filesystem::path &directory);
+
+#endif
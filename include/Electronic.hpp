@@ -2,6 +2,7 @@
 #define ELECTRONIC_HPP
 
 #include "TangibleProduct.hpp"
+#include "InternPool.hpp"
 #include <string>
 #include <iostream> // Required for std::istream
 
@@ -9,10 +10,11 @@
  * @brief Electronic class representing electronic products in inventory
  * * The Electronic class extends TangibleProduct to specifically represent
  * electronic items with additional warranty information.
+ * Products created by a Warehouse live in that warehouse's SlabPool.
  * * @inherit TangibleProduct
  */
 class Electronic : public TangibleProduct {
-    std::string warranty_; // e.g. "2 years"
+    InternedString warranty_; // Interned; e.g. "2 years"
 
 public:
     /**
@@ -23,7 +25,7 @@ public:
      * @param weight The weight of the electronic item.
      * @param warranty The warranty period of the electronic item (e.g., "2 years").
      */
-    Electronic(const std::string &name, double price, int quantity,
+    Electronic(const std::string &name, Money price, int quantity,
                double weight, const std::string &warranty);
     /**
      * @brief Prints information about the electronic item.
@@ -37,7 +39,13 @@ public:
      * @brief Gets the warranty period of the electronic item.
      * @return const std::string& The warranty period.
      */
-    const std::string &getWarranty() const { return warranty_; }
+    const std::string &getWarranty() const { return warranty_.str(); }
+
+    /**
+     * @brief Gets the warranty period as an interned handle, for O(1) comparison and grouping.
+     * @return InternedString The interned warranty period.
+     */
+    InternedString getWarrantyHandle() const { return warranty_; }
 
     /**
      * @brief Input stream operator for the Electronic class.
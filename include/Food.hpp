@@ -2,6 +2,9 @@
 #define FOOD_HPP
 
 #include "TangibleProduct.hpp"
+#include "InternPool.hpp"
+#include "Date.hpp"
+#include <limits> // For std::numeric_limits
 #include <string>
 #include <iostream> // Required for std::istream
 
@@ -9,10 +12,14 @@
  * @brief Food class representing food products in inventory
  * * The Food class extends TangibleProduct to specifically represent
  * food items with additional expiration date information.
+ * Products created by a Warehouse live in that warehouse's SlabPool.
  * * @inherit TangibleProduct
  */
 class Food : public TangibleProduct {
-    std::string expirationDate_; // e.g. "2025-12-31"
+    InternedString expirationDate_; // Interned; e.g. "2025-12-31"
+    Date expiry_;                   // expirationDate_ parsed at construction; noExpiry if it is not a YYYY-MM-DD date
+
+    static constexpr Date noExpiry = Date::fromDays(std::numeric_limits<std::int32_t>::max());
 
 public:
     /**
@@ -23,7 +30,7 @@ public:
      * @param weight The weight of the food item.
      * @param expirationDate The expiration date of the food item (e.g., "2025-12-31").
      */
-    Food(const std::string &name, double price, int quantity,
+    Food(const std::string &name, Money price, int quantity,
          double weight, const std::string &expirationDate);
     /**
      * @brief Prints information about the food item.
@@ -37,7 +44,22 @@ public:
      * @brief Gets the expiration date of the food item.
      * @return const std::string& The expiration date.
      */
-    const std::string &getExpirationDate() const { return expirationDate_; }
+    const std::string &getExpirationDate() const { return expirationDate_.str(); }
+
+    /**
+     * @brief Gets the expiration date as an interned handle, for O(1) comparison and grouping.
+     * @return InternedString The interned expiration date.
+     */
+    InternedString getExpirationDateHandle() const { return expirationDate_; }
+
+    /**
+     * @brief Gets the expiration date as a day number.
+     * @return std::optional<Date> The date, or std::nullopt if the expiration date is not in YYYY-MM-DD form.
+     */
+    std::optional<Date> getExpiryDate() const
+    {
+        return expiry_ == noExpiry ? std::nullopt : std::optional<Date>(expiry_);
+    }
 
     /**
      * @brief Input stream operator for the Food class.
@@ -0,0 +1,116 @@
+#ifndef INTERNPOOL_HPP
+#define INTERNPOOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class InternedString;
+
+/**
+ * @brief Process-wide table of unique strings, each identified by a 32-bit handle
+ * * Interning the same text twice returns the same handle, so equal strings
+ * compare as equal integers and every distinct value is stored once. Handle 0
+ * is always the empty string.
+ * * Strings live in chunks whose sizes double, reached through a fixed table
+ * of atomic pointers, so resolving a handle never takes a lock and the
+ * returned references stay valid for the life of the process. Interning a
+ * new value takes an exclusive lock; looking up a known value takes a shared
+ * one. The pool is never destroyed.
+ */
+class InternPool
+{
+    static constexpr std::size_t firstChunkSize = 64;
+    static constexpr std::size_t maxChunks = 27; // Enough chunks for 2^32 handles
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, std::uint32_t> index_; // Views into the chunks
+    std::atomic<std::string *> chunks_[maxChunks] = {};
+    std::atomic<std::uint32_t> size_{0};
+    std::size_t bytes_ = 0;
+
+    InternPool();
+
+public:
+    InternPool(const InternPool &) = delete;
+    InternPool &operator=(const InternPool &) = delete;
+
+    /**
+     * @brief Gets the pool shared by the whole process
+     */
+    static InternPool &global();
+
+    /**
+     * @brief Gets the handle of a string, adding the string if it is new
+     * * @param text The string to intern
+     * @return Its handle
+     */
+    std::uint32_t intern(std::string_view text);
+
+    /**
+     * @brief Looks up a string without adding it
+     * * Use this for lookups driven by outside input, which would otherwise
+     * grow the pool with every value that is never stored.
+     * * @param text The string to look up
+     * @return Its interned string, or std::nullopt if it was never interned
+     */
+    std::optional<InternedString> find(std::string_view text) const;
+
+    /**
+     * @brief Gets the string behind a handle returned by intern()
+     */
+    const std::string &resolve(std::uint32_t handle) const;
+
+    /**
+     * @brief Gets the number of distinct strings in the pool
+     */
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Gets the total length of all distinct strings in the pool
+     */
+    std::size_t bytes() const;
+};
+
+/**
+ * @brief A string stored in the InternPool, held by its 32-bit handle
+ * * Copying and comparing is an integer operation; str() resolves the handle
+ * when the text itself is needed.
+ */
+class InternedString
+{
+    std::uint32_t handle_ = 0;
+
+public:
+    InternedString() = default;
+    explicit InternedString(std::string_view text) : handle_(InternPool::global().intern(text)) {}
+
+    static InternedString fromHandle(std::uint32_t handle)
+    {
+        InternedString value;
+        value.handle_ = handle;
+        return value;
+    }
+
+    std::uint32_t handle() const { return handle_; }
+    const std::string &str() const { return InternPool::global().resolve(handle_); }
+    bool empty() const { return handle_ == 0; }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.handle_ == b.handle_; }
+    friend std::ostream &operator<<(std::ostream &os, InternedString value);
+};
+
+template <>
+struct std::hash<InternedString>
+{
+    std::size_t operator()(InternedString value) const noexcept { return std::hash<std::uint32_t>{}(value.handle()); }
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MutationListener.hpp"
+
+class Warehouse;    // Forward declaration
+class OrderManager; // Forward declaration
+
+/**
+ * @brief Tuning knobs for journal group commit
+ */
+struct JournalOptions
+{
+    // Longest time a record waits in memory before it is written and synced
+    std::chrono::milliseconds commitInterval{5};
+    // Buffered bytes that trigger a commit without waiting for the interval
+    std::size_t commitBytes = 1 << 20;
+};
+
+/**
+ * @brief Outcome of replaying a journal file
+ */
+struct ReplayReport
+{
+    std::size_t records = 0;    // Records applied
+    bool truncatedTail = false; // A torn or corrupt record was found and everything after it ignored
+};
+
+/**
+ * @brief Append-only, binary write-ahead log of warehouse and order changes
+ * * The journal listens to a Warehouse and an OrderManager and appends one
+ * compact record per change. The file starts with a magic and a format
+ * version; prices are stored as integer cents. Each record is framed as
+ * [payload length : u32][checksum : u32][kind : u8][payload], where the
+ * checksum covers the kind and payload, so a record torn by a crash is
+ * detected on replay and everything after it is ignored.
+ * * Records are collected in memory and written by a background thread in
+ * groups: one write and one fsync for everything that arrived during a
+ * commit interval (group commit). sync() blocks until all records appended so
+ * far are on disk.
+ */
+class Journal : public MutationListener
+{
+    std::FILE *file_ = nullptr;
+    std::string path_;
+    JournalOptions options_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;    // Signals the flusher: data, sync request or shutdown
+    std::condition_variable durable_; // Signals waiters in sync(): a group has reached the disk
+    std::vector<char> pending_;
+    std::uint64_t appendedBytes_ = 0; // Total bytes handed to the journal
+    std::uint64_t durableBytes_ = 0;  // Total bytes written and synced
+    bool syncRequested_ = false;
+    bool stopping_ = false;
+    std::string writeError_;
+    std::jthread flusher_;
+
+    Journal(std::FILE *file, std::string path, JournalOptions options, std::uint64_t existingBytes);
+    void append(std::uint8_t kind, const std::vector<char> &payload);
+    void flushLoop();
+
+public:
+    /**
+     * @brief Opens (or creates) a journal file for appending
+     * * @param path The journal file
+     * @param options Group commit settings
+     * @return The journal, or an error message if the file cannot be opened
+     */
+    static std::expected<std::unique_ptr<Journal>, std::string> open(const std::string &path,
+                                                                     JournalOptions options = {});
+
+    /**
+     * @brief Applies every intact record of a journal file, in order
+     * * The targets must not have a listener attached while replaying,
+     * otherwise the replayed changes would be journaled again.
+     * * @param path The journal file to replay
+     * @param warehouse The warehouse to apply product records to
+     * @param orderManager The order manager to apply order records to
+     * @return What was replayed, or an error message if the file cannot be read
+     */
+    static std::expected<ReplayReport, std::string> replay(const std::string &path, Warehouse &warehouse,
+                                                           OrderManager &orderManager);
+
+    /**
+     * @brief Flushes all pending records and closes the file
+     */
+    ~Journal() override;
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    /**
+     * @brief Blocks until every record appended so far is durable on disk
+     * * @return Nothing on success, or the error that stopped the journal from writing
+     */
+    std::expected<void, std::string> sync();
+
+    /**
+     * @brief Gets the size of the journal file including records not yet written
+     */
+    std::uint64_t size();
+
+    const std::string &path() const { return path_; }
+
+    // MutationListener
+    void productAdded(const ProductStore &store, std::size_t slot) override;
+    void productRemoved(int id) override;
+    void productRenamed(int id, std::string_view name) override;
+    void priceSet(int id, Money price) override;
+    void quantitySet(int id, int quantity) override;
+    void repriced(std::span<const PriceAdjustment> steps, const ProductFilter &filter) override;
+    void sortedByPrice() override;
+    void orderCreated(const Order &order) override;
+    void orderUpdated(std::size_t index, const Order &order) override;
+    void orderRemoved(std::size_t index) override;
+    void ordersFulfilled(std::span<const OrderStatusChange> changes) override;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Read-only view of a whole file mapped into memory
+ * * On POSIX systems the file is mapped with mmap, so parsing can work on the
+ * page cache directly without copying into stream buffers. Elsewhere the file
+ * is read into an owned buffer once and exposed through the same interface.
+ * The mapping is released when the object is destroyed.
+ */
+class MappedFile
+{
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false; // true if data_ must be released with munmap
+    std::string buffer_;  // fallback storage when mmap is not available
+
+    MappedFile() = default;
+    void release() noexcept;
+
+public:
+    /**
+     * @brief Maps a file for reading
+     * * @param path The path of the file to map
+     * @return The mapped file, or an error message if it cannot be opened or mapped
+     */
+    static std::expected<MappedFile, std::string> open(const std::string &path);
+
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    /**
+     * @brief Gets the file contents
+     * * @return A view over the whole file; valid as long as this object lives
+     */
+    std::string_view view() const { return {data_, size_}; }
+
+    std::size_t size() const { return size_; }
+};
+
+#endif
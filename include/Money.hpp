@@ -0,0 +1,199 @@
+#ifndef MONEY_HPP
+#define MONEY_HPP
+
+#include <charconv>
+#include <compare>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief An amount of money held as a whole number of cents in a 64-bit integer
+ * * Sums and products with quantities are exact, so totals and sorts give the
+ * same result on every build and with any number of threads. Scaling by a
+ * factor (a percentage adjustment) is done in integer arithmetic on a factor
+ * expressed in parts per million and rounds half to even, so repeated
+ * adjustments do not drift in one direction. Conversions from double and from
+ * text happen only at the edges (user input, file formats).
+ */
+class Money
+{
+    std::int64_t cents_ = 0;
+
+    explicit constexpr Money(std::int64_t cents) : cents_(cents) {}
+
+    /**
+     * @brief The overflowing case of scaleCents(), kept apart so the common case stays small enough to inline
+     * * Without a 128-bit integer type this goes through long double and is
+     * truncated rather than rounded half to even.
+     */
+    static constexpr std::int64_t scaleCentsWide(std::int64_t cents, std::int64_t ppm)
+    {
+        constexpr std::int64_t lowest = std::numeric_limits<std::int64_t>::min();
+        constexpr std::int64_t highest = std::numeric_limits<std::int64_t>::max();
+#ifdef __SIZEOF_INT128__
+        const __int128 product = static_cast<__int128>(cents) * ppm;
+        __int128 quotient = product / ppmScale;
+        __int128 twiceRemainder = 2 * (product % ppmScale);
+        if (twiceRemainder < 0)
+        {
+            twiceRemainder = -twiceRemainder;
+        }
+        if (twiceRemainder > ppmScale || (twiceRemainder == ppmScale && (quotient & 1)))
+        {
+            quotient += product < 0 ? -1 : 1;
+        }
+        if (quotient > highest)
+        {
+            return highest;
+        }
+        if (quotient < lowest)
+        {
+            return lowest;
+        }
+        return static_cast<std::int64_t>(quotient);
+#else
+        const long double quotient = static_cast<long double>(cents) * ppm / ppmScale;
+        if (quotient >= 0x1p63L)
+        {
+            return highest;
+        }
+        if (quotient <= -0x1p63L)
+        {
+            return lowest;
+        }
+        return static_cast<std::int64_t>(quotient);
+#endif
+    }
+
+public:
+    /**
+     * @brief Denominator of scaling factors: a factor f is passed as f * ppmScale
+     */
+    static constexpr std::int64_t ppmScale = 1'000'000;
+
+    constexpr Money() = default;
+
+    static constexpr Money fromCents(std::int64_t cents) { return Money(cents); }
+
+    /**
+     * @brief Converts a floating-point amount, rounding to the nearest cent (halves away from zero)
+     * * @return The amount, or std::nullopt if it is not finite or does not fit in 64-bit cents
+     */
+    static std::optional<Money> fromDouble(double amount);
+
+    /**
+     * @brief Parses a decimal amount such as "12", "12.5", "-0.99" or "1e3"
+     * * Plain decimals are converted exactly; digits beyond the cent are rounded
+     * half to even. Exponent notation is accepted and goes through double.
+     * * @param text The text to parse; surrounding characters are not allowed
+     * @return The amount, or std::nullopt if the text is not a number or does not fit in 64-bit cents
+     */
+    static std::optional<Money> parse(std::string_view text);
+
+    /**
+     * @brief Divides n by d (d > 0), rounding the quotient half to even
+     */
+    static constexpr std::int64_t divideRounded(std::int64_t n, std::int64_t d)
+    {
+        std::int64_t quotient = n / d;
+        std::int64_t twiceRemainder = 2 * (n % d);
+        if (twiceRemainder < 0)
+        {
+            twiceRemainder = -twiceRemainder;
+        }
+        if (twiceRemainder > d || (twiceRemainder == d && (quotient & 1)))
+        {
+            quotient += n < 0 ? -1 : 1;
+        }
+        return quotient;
+    }
+
+    /**
+     * @brief Largest |cents| that can be multiplied by factor without overflowing 64 bits
+     */
+    static constexpr std::int64_t maxMultiplicand(std::int64_t factor)
+    {
+        if (factor == 0)
+        {
+            return std::numeric_limits<std::int64_t>::max();
+        }
+        if (factor == std::numeric_limits<std::int64_t>::min())
+        {
+            return 0;
+        }
+        return std::numeric_limits<std::int64_t>::max() / (factor < 0 ? -factor : factor);
+    }
+
+    /**
+     * @brief Computes cents * ppm / ppmScale, rounding half to even and saturating to the int64_t range
+     * * Uses 64-bit arithmetic when the product fits and a wider intermediate
+     * otherwise, so the result is defined for any pair of arguments.
+     */
+    static constexpr std::int64_t scaleCents(std::int64_t cents, std::int64_t ppm)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        std::int64_t product = 0;
+        if (!__builtin_mul_overflow(cents, ppm, &product))
+        {
+            return divideRounded(product, ppmScale);
+        }
+#else
+        const std::int64_t limit = maxMultiplicand(ppm);
+        if (cents <= limit && cents >= -limit)
+        {
+            return divideRounded(cents * ppm, ppmScale);
+        }
+#endif
+        return scaleCentsWide(cents, ppm);
+    }
+
+    constexpr std::int64_t cents() const { return cents_; }
+    double toDouble() const { return static_cast<double>(cents_) / 100.0; }
+
+    /**
+     * @brief Scales the amount by ppm / ppmScale, rounding half to even
+     * * Results outside the int64_t range saturate; see scaleCents().
+     */
+    constexpr Money scaled(std::int64_t ppm) const { return Money(scaleCents(cents_, ppm)); }
+
+    /**
+     * @brief Converts a floating-point factor (e.g. 0.99) to parts per million, the form scaled() takes
+     * * @return The factor in parts per million, or std::nullopt if it is not finite or does not fit in 64 bits
+     */
+    static std::optional<std::int64_t> toPpm(double factor);
+
+    /**
+     * @brief Writes the amount as a decimal with two fraction digits (e.g. "-12.05")
+     * * @return As for std::to_chars
+     */
+    std::to_chars_result toChars(char *first, char *last) const;
+
+    /**
+     * @brief Formats the amount as a decimal with two fraction digits
+     */
+    std::string toString() const;
+
+    constexpr Money operator+(Money other) const { return Money(cents_ + other.cents_); }
+    constexpr Money operator-(Money other) const { return Money(cents_ - other.cents_); }
+    constexpr Money operator-() const { return Money(-cents_); }
+    constexpr Money operator*(std::int64_t count) const { return Money(cents_ * count); }
+    constexpr Money &operator+=(Money other)
+    {
+        cents_ += other.cents_;
+        return *this;
+    }
+    constexpr Money &operator-=(Money other)
+    {
+        cents_ -= other.cents_;
+        return *this;
+    }
+
+    friend constexpr auto operator<=>(Money, Money) = default;
+    friend std::ostream &operator<<(std::ostream &os, Money amount);
+};
+
+#endif
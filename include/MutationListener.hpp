@@ -0,0 +1,54 @@
+#ifndef MUTATIONLISTENER_HPP
+#define MUTATIONLISTENER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "Money.hpp"
+
+class ProductStore;     // Forward declaration
+class Order;            // Forward declaration
+struct PriceAdjustment; // Forward declaration
+struct ProductFilter;   // Forward declaration
+enum class OrderStatus : std::uint8_t; // Defined in OrderManager.hpp
+
+/**
+ * @brief New status of one order after a fulfillment run
+ */
+struct OrderStatusChange
+{
+    std::uint64_t index; // Position of the order in its OrderManager
+    OrderStatus status;
+};
+
+/**
+ * @brief Observer notified after every state change of a Warehouse or OrderManager
+ * * Each callback runs after the change has been applied and describes its
+ * result (e.g. the final price after clamping), so replaying the callbacks in
+ * order on the same starting state reproduces the same final state. All
+ * callbacks default to doing nothing; implementations override the ones they
+ * care about.
+ */
+class MutationListener
+{
+public:
+    virtual ~MutationListener() = default;
+
+    // Warehouse events
+    virtual void productAdded(const ProductStore & /*store*/, std::size_t /*slot*/) {}
+    virtual void productRemoved(int /*id*/) {}
+    virtual void productRenamed(int /*id*/, std::string_view /*name*/) {}
+    virtual void priceSet(int /*id*/, Money /*price*/) {}
+    virtual void quantitySet(int /*id*/, int /*quantity*/) {}
+    virtual void repriced(std::span<const PriceAdjustment> /*steps*/, const ProductFilter & /*filter*/) {}
+    virtual void sortedByPrice() {}
+
+    // OrderManager events
+    virtual void orderCreated(const Order & /*order*/) {}
+    virtual void orderUpdated(std::size_t /*index*/, const Order & /*order*/) {}
+    virtual void orderRemoved(std::size_t /*index*/) {}
+    virtual void ordersFulfilled(std::span<const OrderStatusChange> /*changes*/) {} // Only the statuses processAllOrders changed
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef NAMEINDEX_HPP
+#define NAMEINDEX_HPP
+
+#include <compare>
+#include <cstddef>
+#include <limits>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "SlabPool.hpp"
+
+class ProductStore; // Forward declaration
+
+/**
+ * @brief Secondary indexes over product names: exact match and prefix
+ * * A hash multimap answers "which products are called exactly X" in constant
+ * time on average, and an ordered set of (name, ID) entries answers "which
+ * products start with P" with one tree search plus a walk over the matches.
+ * Names are not required to be unique. Each container allocates its nodes
+ * from a SlabPool of its own.
+ * * The index stores string_views and does not own the characters; the caller
+ * keeps them alive (Warehouse points it at the names in its ProductStore
+ * arena, which never moves or frees them while the product exists).
+ */
+class NameIndex
+{
+    struct Entry
+    {
+        std::string_view name;
+        int id;
+
+        friend auto operator<=>(const Entry &, const Entry &) = default;
+    };
+
+    std::unordered_multimap<std::string_view, int, std::hash<std::string_view>, std::equal_to<>,
+                            SlabAllocator<std::pair<const std::string_view, int>>>
+        exact_;
+    std::set<Entry, std::less<>, SlabAllocator<Entry>> ordered_;
+
+public:
+    void insert(std::string_view name, int id);
+    void erase(std::string_view name, int id);
+    void reserve(std::size_t count) { exact_.reserve(count); }
+
+    /**
+     * @brief Replaces the whole index with the names of a product store
+     * * The entries are sorted once and the ordered set is filled from the
+     * sorted run, so each insertion is an append at the end.
+     */
+    void rebuild(const ProductStore &store);
+
+    /**
+     * @brief Gets the IDs of all products with exactly this name, in no particular order
+     */
+    std::vector<int> find(std::string_view name) const;
+
+    /**
+     * @brief Calls visit(id) for each product with exactly this name, in no particular order
+     */
+    template <typename Visitor>
+    void forEachExact(std::string_view name, Visitor visit) const
+    {
+        auto [first, last] = exact_.equal_range(name);
+        for (; first != last; ++first)
+            visit(first->second);
+    }
+
+    /**
+     * @brief Gets the IDs of products whose name starts with prefix
+     * * @param prefix The prefix to match; an empty prefix matches every product
+     * @param limit The largest number of IDs to return
+     * @return The IDs ordered by name, then by ID
+     */
+    std::vector<int> withPrefix(std::string_view prefix,
+                                std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+
+    std::size_t size() const { return ordered_.size(); }
+};
+
+#endif
@@ -1,16 +1,27 @@
 #ifndef ORDER_HPP
 #define ORDER_HPP
 
-#include <map>
 #include <memory>
+#include <span>
 #include <string>
 #include <iostream>
 #include <vector>
 #include <numeric> // For std::accumulate
+#include "Money.hpp"
+#include "SmallVector.hpp"
 
 class Product;   // Forward declaration
 class Warehouse; // Forward declaration for totalPrice
 
+/**
+ * @brief One line of an order: a product ID and the quantity ordered
+ */
+struct OrderItem
+{
+    int productId;
+    int quantity;
+};
+
 /**
  * @brief Order class representing a customer's order
  * * The Order class manages a collection of products and their quantities
@@ -19,12 +30,25 @@ class Warehouse; // Forward declaration for totalPrice
  * in the order.
  */
 class Order {
+public:
+    /**
+     * @brief Number of lines an order holds without a heap allocation
+     */
+    static constexpr std::size_t inlineItems = 16;
+
+private:
+    /**
+     * @brief Order lines sorted by product ID, one per product
+     * * Typical orders have a handful of lines, so they are kept inline in the
+     * Order object: creating, copying and pricing such an order allocates
+     * nothing, and lookups are a binary search over contiguous memory.
+     */
+    SmallVector<OrderItem, inlineItems> items_;
+
     /**
-     * @brief Map storing product IDs and their quantities
-     * * The key is the product ID, and the value is the quantity of that product
-     * in the order.
+     * @brief Finds the line for a product, or where it would be inserted
      */
-    std::map<int, int> items_;
+    OrderItem *lowerBound(int productId);
 
 public:
     Order() = default;
@@ -37,20 +61,28 @@ public:
      * @param quantity The quantity of the product to add
      */
     void addItem(const Product &product, int quantity);
+    /**
+     * @brief Adds a product to the order by its ID
+     * * Same semantics as addItem(const Product&, int), for callers that only
+     * know the product ID (e.g. when restoring persisted orders).
+     * * @param productId The ID of the product to add
+     * @param quantity The quantity of the product to add
+     */
+    void addItem(int productId, int quantity);
     /**
      * @brief Gets the items in the order
-     * * @return A const reference to the map of product IDs and their quantities
+     * * @return The order lines, in ascending product ID order
      */
-    const std::map<int, int>& getItems() const { return items_; }
+    std::span<const OrderItem> getItems() const { return {items_.data(), items_.size()}; }
 
     /**
      * @brief Calculates the total price of the order
      * * This method calculates the total price of all items in the order based on
      * the prices of the products in the provided warehouse.
      * * @param warehouse The Warehouse object to find product prices.
-     * @return The total price of the order
+     * @return The exact total price of the order, in cents
      */
-    double totalPrice(const Warehouse &warehouse) const; // Changed parameter
+    Money totalPrice(const Warehouse &warehouse) const; // Changed parameter
     /**
      * @brief Gets the number of unique product types in the order
      * * @return The number of unique product types in the order
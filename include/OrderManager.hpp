@@ -1,8 +1,66 @@
 #ifndef ORDERMANAGER_HPP
 #define ORDERMANAGER_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
 #include <vector>
 #include "Order.hpp"
+#include "Money.hpp"
+#include "MutationListener.hpp"
+
+/**
+ * @brief Fulfillment state of an order
+ */
+enum class OrderStatus : std::uint8_t
+{
+    Open,               // Not processed yet
+    Fulfilled,          // Every unit shipped
+    PartiallyFulfilled, // Some units shipped; the order's lines now hold only what is outstanding
+    Backordered         // Nothing could be shipped yet
+};
+
+/**
+ * @brief Gets the display name of an order status (e.g. "partially fulfilled")
+ */
+const char *toString(OrderStatus status);
+
+/**
+ * @brief Outcome of one OrderManager::processAllOrders run
+ */
+struct FulfillmentSummary
+{
+    std::size_t ordersProcessed = 0; // Orders that were not fulfilled before the run
+    std::size_t fulfilled = 0;
+    std::size_t partiallyFulfilled = 0;
+    std::size_t backordered = 0;
+    long long unitsShipped = 0;
+    long long unitsOutstanding = 0; // Units still owed after the run, including those of missing products
+    std::size_t productsShipped = 0; // Distinct products whose stock went down
+    Money shippedValue;              // Value of the shipped units at current prices
+};
+
+/**
+ * @brief An order line that could not be priced because its product is not in the warehouse
+ */
+struct MissingProduct
+{
+    std::size_t orderIndex; // Index of the order in OrderManager::getOrders()
+    int productId;
+    int quantity;
+};
+
+/**
+ * @brief Result of pricing a batch of orders
+ * * Lines whose product is missing add nothing to their order's total and are
+ * listed in missing instead, so the caller decides how to report them.
+ */
+struct OrderPricing
+{
+    std::vector<Money> totals;           // One per requested order, in request order
+    std::vector<MissingProduct> missing; // In request order, then line order
+};
 
 /**
  * @brief Manages a collection of orders and provides functionality to create and process them.
@@ -13,17 +71,156 @@
  */
 class OrderManager {
     std::vector<Order> orders_;
+    std::vector<OrderStatus> statuses_;    // Aligned with orders_
+    MutationListener *listener_ = nullptr; // Optional observer (e.g. the persistence journal)
+
+    /**
+     * @brief Cached order totals, aligned with orders_
+     * * Valid for the warehouse price epoch in pricedAt_. When the epoch moves,
+     * the single-product price changes since then are applied to the totals
+     * of the orders that contain those products; after a bulk reprice (or
+     * against another warehouse) every total is recomputed. Orders that were
+     * created or changed since the last refresh are priced on their own.
+     */
+    mutable std::vector<Money> totals_;
+    mutable std::vector<std::uint8_t> totalKnown_; // 1 where totals_ holds the current total
+    mutable std::uint64_t pricedAt_ = 0;            // Never a valid epoch
+
+    /**
+     * @brief One order line in the reverse index, chained to the previous line of the same product
+     */
+    struct ProductLine
+    {
+        std::uint32_t order; // Index into orders_
+        int quantity;
+        std::uint32_t next; // Previous entry for the same product, or endOfChain
+    };
+    static constexpr std::uint32_t endOfChain = UINT32_MAX;
+
+    /**
+     * @brief Reverse index from product ID to the order lines that contain it
+     * * productLines_ has one entry per order line, and productHeads_ points at
+     * the newest entry of each product, so building the index costs one hash
+     * insert per line rather than one small vector per product. createOrder
+     * extends it; any other change to the orders marks it stale, and it is
+     * rebuilt the next time a price change has to be applied.
+     */
+    mutable std::unordered_map<int, std::uint32_t> productHeads_;
+    mutable std::vector<ProductLine> productLines_;
+    mutable bool productLinesStale_ = true;
+
+    /**
+     * @brief Adds the lines of the order at an index to the reverse index
+     */
+    void indexOrderLines(std::size_t index) const;
+
+    /**
+     * @brief Brings totals_ up to date with the warehouse's current prices
+     */
+    void refreshTotals(const Warehouse &warehouse) const;
+
+    /**
+     * @brief Forgets the cached total of one order and marks the reverse index stale
+     */
+    void orderChanged(size_t index);
 
 public:
     OrderManager() = default;
 
     void createOrder(const Order& order);
-    void processAllOrders();
+
+    /**
+     * @brief Ships every order that is not fulfilled yet from the warehouse stock
+     * * Orders are served first come, first served (by index). The demand of all
+     * orders is allocated against the stock first, and then each product's
+     * stock goes down once, through Warehouse::updateQuantity, by the units
+     * shipped. An order whose lines all shipped becomes Fulfilled and one that
+     * shipped nothing Backordered; a partially shipped order keeps only the
+     * outstanding units in its lines, so the next run ships the rest. Lines
+     * whose product is no longer in the warehouse stay outstanding.
+     * * @param warehouse The warehouse to take the stock from
+     * @return Counts of orders and units shipped and outstanding
+     */
+    FulfillmentSummary processAllOrders(Warehouse &warehouse);
+
+    /**
+     * @brief Gets the fulfillment state of an order
+     * * @param index The index of the order
+     * @return The status; OrderStatus::Open until the order is first processed
+     */
+    OrderStatus getStatus(size_t index) const { return statuses_.at(index); }
+
+    /**
+     * @brief Replaces the status of every order, e.g. when restoring a snapshot or replaying a journal
+     * * The listener is not told about it.
+     * * @param statuses One status per order
+     * @return false, with nothing changed, if the number of statuses does not match the number of orders
+     */
+    bool setStatuses(std::span<const OrderStatus> statuses);
+
+    /**
+     * @brief Replaces the status of one order, e.g. when replaying a journal
+     * * The listener is not told about it.
+     * * @param index The index of the order
+     * @param status The new status
+     * @return false, with nothing changed, if there is no order at that index
+     */
+    bool setStatus(std::size_t index, OrderStatus status);
 
     const std::vector<Order>& getOrders() const { return orders_; }
 
-    Order &getOrder(size_t index);
+    /**
+     * @brief Prices every order in one pass over the warehouse columns
+     * * Same totals as calling Order::totalPrice on each order, without its
+     * per-line Product lookup and error logging.
+     * * @param warehouse The warehouse whose current prices are used
+     * @return One total per order, and the lines whose product is missing
+     */
+    OrderPricing priceOrders(const Warehouse &warehouse) const;
+
+    /**
+     * @brief Prices a selected set of orders in one pass over the warehouse columns
+     * * The lines of all selected orders are gathered into flat columns, their
+     * product IDs are resolved to store slots once, the unit prices are
+     * gathered from the price column, and each total is a multiply-accumulate
+     * over contiguous arrays. An index past the last order gets a zero total.
+     * * @param warehouse The warehouse whose current prices are used
+     * @param indexes The indexes of the orders to price, in any order
+     * @return One total per index, and the lines whose product is missing
+     */
+    OrderPricing priceOrders(const Warehouse &warehouse, std::span<const std::size_t> indexes) const;
+
+    /**
+     * @brief Gets the total of every order, kept up to date across calls
+     * * The first call prices all orders. Later calls only reprice what changed:
+     * after setPrice, or adding or removing a product, the totals of the orders
+     * containing that product are adjusted by the price difference times the
+     * quantity ordered. A bulk reprice makes every total be recomputed. Lines
+     * whose product is missing add nothing, as in priceOrders.
+     * * @param warehouse The warehouse whose current prices are used
+     * @return One total per order, valid until the next change to the orders
+     */
+    std::span<const Money> orderTotals(const Warehouse &warehouse) const;
+
+    /**
+     * @brief Gets the total of one order from the same cache as orderTotals
+     * * @param warehouse The warehouse whose current prices are used
+     * @param index The index of the order
+     * @return The total, or zero if the index is past the last order
+     */
+    Money orderTotal(const Warehouse &warehouse, size_t index) const;
+
+    /**
+     * @brief Gives read access to an order
+     * * To edit an order, change a copy and pass it to updateOrder, which
+     * reports the edit to the listener. Editing an order does not change its
+     * status.
+     */
+    const Order &getOrder(size_t index) const;
+    void updateOrder(size_t index, const Order& order);
     void removeOrder(size_t index);
+
+    void setListener(MutationListener *listener) { listener_ = listener; }
 };
 
 #endif
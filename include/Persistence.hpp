@@ -0,0 +1,112 @@
+#ifndef PERSISTENCE_HPP
+#define PERSISTENCE_HPP
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Journal.hpp"
+
+class Warehouse;    // Forward declaration
+class OrderManager; // Forward declaration
+
+/**
+ * @brief Settings for incremental persistence
+ */
+struct PersistenceOptions
+{
+    JournalOptions journal;
+    // Journal size at which compactIfNeeded() folds it into a new snapshot
+    std::uint64_t compactAfterBytes = 64ull << 20;
+};
+
+/**
+ * @brief Keeps a warehouse and its orders durable in a data directory
+ * * The directory holds numbered generations: snapshot.<N>.bin contains the
+ * complete state at the moment journal.<N>.log was started, and each journal
+ * records the changes made after that. Every change is appended to the
+ * current journal, so the cost of persisting it depends only on the change,
+ * not on the size of the catalog.
+ * * Recovery restores the newest readable snapshot and replays the journals of
+ * that generation and later ones on top of it. Compaction starts a new
+ * journal generation, encodes the in-memory state and writes it as the
+ * matching snapshot on a background thread; older generations are deleted
+ * only once the new snapshot is safely on disk.
+ */
+class Persistence
+{
+    std::filesystem::path directory_;
+    Warehouse &warehouse_;
+    OrderManager &orderManager_;
+    PersistenceOptions options_;
+    std::uint64_t generation_ = 0;
+    std::unique_ptr<Journal> journal_;
+
+    std::mutex compactionMutex_;
+    std::string compactionError_;
+    std::jthread compactor_;
+
+    Persistence(std::filesystem::path directory, Warehouse &warehouse, OrderManager &orderManager,
+                PersistenceOptions options);
+    std::expected<void, std::string> recover();
+    std::expected<void, std::string> startJournal(std::uint64_t generation);
+    void attach();
+    void detach();
+
+public:
+    /**
+     * @brief Recovers the state stored in a directory and starts journaling changes
+     * * The warehouse and order manager are replaced by the recovered state (or
+     * left as they are if the directory holds nothing yet). From then on every
+     * change made through them is journaled until the Persistence is destroyed.
+     * * @param directory The data directory; created if missing
+     * @param warehouse The warehouse to recover into and observe
+     * @param orderManager The order manager to recover into and observe
+     * @param options Journal and compaction settings
+     * @return The persistence handle, or an error message
+     */
+    static std::expected<std::unique_ptr<Persistence>, std::string> open(const std::filesystem::path &directory,
+                                                                         Warehouse &warehouse,
+                                                                         OrderManager &orderManager,
+                                                                         PersistenceOptions options = {});
+
+    /**
+     * @brief Syncs the journal, waits for a running compaction and stops observing
+     */
+    ~Persistence();
+    Persistence(const Persistence &) = delete;
+    Persistence &operator=(const Persistence &) = delete;
+
+    /**
+     * @brief Blocks until every change made so far is durable on disk
+     */
+    std::expected<void, std::string> sync();
+
+    /**
+     * @brief Folds the current state into a new snapshot generation
+     * * Must be called from the thread that mutates the warehouse. The state is
+     * encoded in memory on the calling thread; writing the file and removing
+     * the older generations happens in the background. Also re-attaches the
+     * journal, e.g. after the targets were replaced by Snapshot::load.
+     * * @return Nothing if the compaction was started, or an error message
+     */
+    std::expected<void, std::string> compact();
+
+    /**
+     * @brief Calls compact() if the current journal has grown past compactAfterBytes
+     */
+    std::expected<void, std::string> compactIfNeeded();
+
+    /**
+     * @brief Gets and clears the error of the last background compaction, if it failed
+     */
+    std::string takeCompactionError();
+
+    std::uint64_t generation() const { return generation_; }
+    std::uint64_t journalSize() const { return journal_->size(); }
+};
+
+#endif
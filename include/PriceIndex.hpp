@@ -0,0 +1,82 @@
+#ifndef PRICEINDEX_HPP
+#define PRICEINDEX_HPP
+
+#include <compare>
+#include <cstddef>
+#include <ranges>
+#include <set>
+#include <span>
+#include <vector>
+#include "Money.hpp"
+#include "SlabPool.hpp"
+
+/**
+ * @brief Secondary index that keeps product IDs ordered by price
+ * * Entries are (price, ID) pairs in a balanced search tree, so inserting,
+ * removing or re-pricing one product costs O(log n) and never moves anything
+ * in the primary storage. Equal prices are ordered by ID, which makes the
+ * iteration order deterministic. Ordered iteration, inclusive price ranges and
+ * the K cheapest or most expensive products are all read straight off the
+ * tree in O(log n + k). Tree nodes are allocated from a SlabPool owned by the
+ * index.
+ */
+class PriceIndex
+{
+public:
+    struct Entry
+    {
+        Money price;
+        int id;
+
+        friend auto operator<=>(const Entry &, const Entry &) = default;
+    };
+
+    using Entries = std::set<Entry, std::less<>, SlabAllocator<Entry>>;
+    using const_iterator = Entries::const_iterator;
+    using const_reverse_iterator = Entries::const_reverse_iterator;
+
+private:
+    Entries entries_;
+
+public:
+    void insert(Money price, int id) { entries_.insert({price, id}); }
+    void erase(Money price, int id) { entries_.erase({price, id}); }
+    void clear() { entries_.clear(); }
+
+    /**
+     * @brief Replaces the whole index with the given columns
+     * * The pairs are sorted once and handed to the tree in order, which it
+     * builds in linear time.
+     * * @param prices The price of every product
+     * @param ids The ID of every product, aligned with prices
+     */
+    void rebuild(std::span<const Money> prices, std::span<const int> ids);
+
+    std::size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    // Ascending price order
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+    // Descending price order
+    const_reverse_iterator rbegin() const { return entries_.rbegin(); }
+    const_reverse_iterator rend() const { return entries_.rend(); }
+
+    /**
+     * @brief Gets the entries whose price lies between low and high, both inclusive
+     * * @return The entries in ascending price order; empty if low > high
+     */
+    std::ranges::subrange<const_iterator> range(Money low, Money high) const;
+
+    /**
+     * @brief Gets the IDs of the k cheapest products, cheapest first
+     */
+    std::vector<int> cheapest(std::size_t k) const;
+
+    /**
+     * @brief Gets the IDs of the k most expensive products, most expensive first
+     */
+    std::vector<int> mostExpensive(std::size_t k) const;
+};
+
+#endif
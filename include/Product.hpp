@@ -1,11 +1,14 @@
 #ifndef PRODUCT_HPP
 #define PRODUCT_HPP
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <compare>     // For std::partial_ordering
-#include <cmath>       // For isnan checks
 #include <iomanip>     // For std::quoted (used in operator>>)
+#include "ProductType.hpp"
+#include "Money.hpp"
 
 /**
  * @brief Abstract base class representing a product.
@@ -20,23 +23,30 @@
  *
  * @details
  * - Protected Members:
- * - std::string name_: The name of the product.
- * - double price_: The price of the product.
+ * - std::string_view name_: The name of the product. A product on its own
+ * keeps the characters in ownedName_; a product held by a Warehouse views
+ * the copy in the warehouse's string arena instead, and ownedName_ is empty.
+ * - Money price_: The price of the product, in whole cents.
  * - int quantity_: The quantity available for the product.
- * - static int globalIdCounter_: A static counter shared among all instances for unique ID generation.
+ * - static std::atomic<int> globalIdCounter_: A static counter shared among all instances for unique ID
+ * generation; atomic, so products can be created on several threads at once.
  * - int productId_: A unique identifier assigned to each product.
+ * - ProductType type_: Tag naming the built-in class the product is or derives from, set once by its constructor.
  *
  * - Public Member Functions:
- * - Product(const std::string& name, double price, int quantity): Constructor that initializes
- * the product with a given name, price, and quantity, and assigns a unique product ID.
+ * - Product(const std::string& name, Money price, int quantity, ProductType type): Constructor that
+ * initializes the product with a given name, price, quantity and type tag, and assigns a unique product ID.
  * - virtual ~Product() = default: Virtual destructor for proper cleanup in derived classes.
  * - virtual void printInfo() const = 0: Pure virtual function to print product-specific information,
  * making Product an abstract class.
- * - Getters for name, price, quantity, and product ID.
- * - void setPrice(double newPrice): Updates the price of the product.
+ * - Getters for name (a view, valid while the product exists and is not renamed), price, quantity,
+ * product ID and type tag.
+ * - Copy and move operations: the copy always owns its name.
+ * - void setName(const std::string& newName): Renames the product.
+ * - void setPrice(Money newPrice): Updates the price of the product.
  * - void updateQuantity(int delta): Adjusts the product quantity by a specified delta.
  * - std::partial_ordering operator<=>(const Product& other) const: Three-way comparison operator for comparing
- * products based on their attributes, accounting for potential NaN values in doubles.
+ * products based on their attributes.
  * - friend std::ostream& operator<<(std::ostream& os, const Product& prod): Friend function to support
  * output streaming of product information (for display).
  * - friend std::istream& operator>>(std::istream& is, Product& prod): Friend function to support
@@ -49,42 +59,67 @@
  * - Explicit constructor Details(const std::string& info) used for initialization.
  */
 class Product {
+    std::string ownedName_; // The name's characters, unless a Warehouse's arena holds them
+
 protected:
-    std::string name_;
-    double price_;
+    std::string_view name_;
+    Money price_;
     int quantity_;
     // A static attribute (shared by all products)
-    static int globalIdCounter_;
+    static std::atomic<int> globalIdCounter_;
     // Every product gets a unique ID
     int productId_;
+    // Built-in class the product is or derives from; ProductType::Other for any other subclass
+    ProductType type_;
 
 public:
     // Abstract class (at least 1 pure virtual method)
-    Product(const std::string& name, double price, int quantity);
+    Product(const std::string& name, Money price, int quantity, ProductType type = ProductType::Other);
+    Product(const Product &other);
+    Product(Product &&other) noexcept;
+    Product &operator=(const Product &other);
+    Product &operator=(Product &&other) noexcept;
     virtual ~Product() = default;
 
     // Pure virtual -> makes Product abstract
     virtual void printInfo() const = 0;
 
     // Getters
-    const std::string& getName()        const { return name_; }
-    // const std::string  getType()        const { return "Product"; } // Less useful, dynamic_cast is better
-    double             getPrice()       const { return price_; }
+    std::string_view   getName()        const { return name_; }
+    Money              getPrice()       const { return price_; }
     int                getQuantity()    const { return quantity_; }
     int                getId()          const { return productId_; }
+    ProductType        getType()        const { return type_; }
 
-    // Update price and quantity
-    void setPrice(double newPrice);
+    // Update name, price and quantity
+    void setName(const std::string& newName);
+    void setPrice(Money newPrice);
     void updateQuantity(int delta);
 
+    // ID allocation control, used when restoring persisted products so they keep their IDs
+    static int  peekNextId()          { return globalIdCounter_.load(std::memory_order_relaxed) + 1; }
+    static void setNextId(int nextId) { globalIdCounter_.store(nextId - 1, std::memory_order_relaxed); }
+
     // Operator<=>
-    // Because doubles can be NaN, we use partial_ordering
+    // Kept as partial_ordering for source compatibility (prices used to be doubles that could be NaN)
     std::partial_ordering operator<=>(const Product& other) const;
 
     // Output operator (for display)
     friend std::ostream& operator<<(std::ostream& os, const Product& prod);
     // Input operator (for file/user input, uses std::quoted for name)
     friend std::istream &operator>>(std::istream &is, Product &prod);
+    // Columnar storage writes bulk-updated prices and quantities back into the objects
+    friend class ProductStore;
+    // A warehouse points the names of its products at its own arena (see useArenaName)
+    friend class Warehouse;
+
+private:
+    /**
+     * @brief Replaces the name with a view of characters someone else keeps alive, freeing ownedName_
+     */
+    void useArenaName(std::string_view name);
+
+public:
 
     // Nested class
     class Details {
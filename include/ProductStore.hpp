@@ -0,0 +1,165 @@
+#ifndef PRODUCTSTORE_HPP
+#define PRODUCTSTORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Product.hpp"
+#include "ProductType.hpp"
+#include "StringArena.hpp"
+#include "InternPool.hpp"
+
+/**
+ * @brief Structure-of-arrays (columnar) storage for product data
+ * * The ProductStore keeps the fields that bulk operations touch (ID, price,
+ * quantity, weight and type) in separate contiguous "hot" columns, so that a
+ * price scan or a sort streams through plain arrays instead of chasing one heap
+ * pointer per product. Names and the type-specific attribute (warranty, size or
+ * expiration date) live in "cold" side tables that are only read for display
+ * and export. Names are kept in a StringArena owned by the store, so adding
+ * a product does not allocate per name and dropping the store frees all of
+ * them at once (erasing a slot does not reclaim its characters). Attributes
+ * repeat a small set of values and are stored as InternedString handles,
+ * so grouping by size or warranty compares integers.
+ * * All columns are indexed by the same slot number. The store does not own any
+ * Product objects; Warehouse keeps it aligned slot-for-slot with its products_.
+ */
+class ProductStore
+{
+    // Hot columns
+    std::vector<int> ids_;
+    std::vector<Money> prices_;
+    std::vector<int> quantities_;
+    std::vector<double> weights_;
+    std::vector<ProductType> types_;
+
+    // Cold side tables
+    StringArena strings_;
+    std::vector<std::string_view> names_;     // Views into strings_
+    std::vector<InternedString> attributes_; // warranty, size or expiration date depending on types_
+
+public:
+    ProductStore() = default;
+
+    /**
+     * @brief Determines the concrete type of a product
+     * * @param product The product to classify
+     * @return The matching ProductType, or ProductType::Other for unknown subclasses
+     */
+    static ProductType classify(const Product &product);
+
+    /**
+     * @brief Creates a Product object of the subclass matching a type tag
+     * * @param type The concrete type to create
+     * @param name The product name
+     * @param price The product price
+     * @param quantity The quantity in stock
+     * @param weight The product weight
+     * @param attribute The warranty, size or expiration date, depending on type
+     * @return The new product, or nullptr for ProductType::Other
+     */
+    static std::unique_ptr<Product> makeProduct(ProductType type, const std::string &name, Money price,
+                                                int quantity, double weight, const std::string &attribute);
+
+    /**
+     * @brief Appends a copy of the product's fields as a new slot
+     * * @param product The product whose data is copied into the columns
+     */
+    void append(const Product &product);
+
+    /**
+     * @brief Replaces every column with the rows of a columnar source, e.g. a SnapshotView
+     * * The rows are copied straight into the columns in one pass, without
+     * building Product objects. The source provides productCount(), the
+     * ids(), quantities(), weights() and types() spans, and price(slot),
+     * name(slot) and attribute(slot). Rows tagged ProductType::Other are
+     * skipped, since no Product can be re-created for them.
+     * * @param source The rows to copy
+     */
+    template <typename Source>
+    void assign(const Source &source);
+
+    /**
+     * @brief Replaces the name of a slot
+     * * The new name is copied into the arena; the old characters stay there
+     * until the store is dropped.
+     * * @param slot The slot to rename
+     * @param name The new name
+     * @return A view of the stored name
+     */
+    std::string_view rename(std::size_t slot, std::string_view name);
+
+    /**
+     * @brief Removes a slot, shifting the following slots down by one
+     * * @param slot The slot to remove
+     */
+    void erase(std::size_t slot);
+
+    /**
+     * @brief Reorders every column so that new slot i holds old slot order[i]
+     * * @param order A permutation of [0, size())
+     */
+    void permute(const std::vector<std::size_t> &order);
+
+    /**
+     * @brief Pre-allocates room for the given number of products in every column
+     * * @param capacity The number of products to reserve space for
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * @brief Writes the hot price and quantity of a slot back into a Product object
+     * * @param slot The slot to read from
+     * @param product The product object to update
+     */
+    void writeBack(std::size_t slot, Product &product) const;
+
+    std::size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+
+    // Hot column access
+    std::span<const int> ids() const { return ids_; }
+    std::span<Money> prices() { return prices_; }
+    std::span<const Money> prices() const { return prices_; }
+    std::span<int> quantities() { return quantities_; }
+    std::span<const int> quantities() const { return quantities_; }
+    std::span<const double> weights() const { return weights_; }
+    std::span<const ProductType> types() const { return types_; }
+
+    // Cold side table access
+    std::string_view name(std::size_t slot) const { return names_[slot]; }
+    std::string_view attribute(std::size_t slot) const { return attributes_[slot].str(); }
+    std::span<const InternedString> attributeHandles() const { return attributes_; }
+    const StringArena &strings() const { return strings_; }
+};
+
+template <typename Source>
+void ProductStore::assign(const Source &source)
+{
+    *this = ProductStore();
+    const std::size_t count = source.productCount();
+    reserve(count);
+    auto ids = source.ids();
+    auto quantities = source.quantities();
+    auto weights = source.weights();
+    auto types = source.types();
+    for (std::size_t slot = 0; slot < count; ++slot)
+    {
+        const auto type = static_cast<ProductType>(types[slot]);
+        if (type == ProductType::Other)
+            continue;
+        ids_.push_back(ids[slot]);
+        prices_.push_back(source.price(slot));
+        quantities_.push_back(quantities[slot]);
+        weights_.push_back(weights[slot]);
+        types_.push_back(type);
+        names_.push_back(strings_.store(source.name(slot)));
+        attributes_.push_back(InternedString(source.attribute(slot)));
+    }
+}
+
+#endif
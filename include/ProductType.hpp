@@ -0,0 +1,28 @@
+#ifndef PRODUCTTYPE_HPP
+#define PRODUCTTYPE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Concrete kind of a product, stored as a one-byte tag
+ * * Every Product carries its tag, so code that needs the concrete type (saving,
+ * per-type aggregates) can switch on it instead of using RTTI. The tag names
+ * the built-in class a product is or derives from: a subclass of Electronic
+ * is tagged Electronic, and direct subclasses of Product or TangibleProduct
+ * are tagged Other.
+ */
+enum class ProductType : std::uint8_t
+{
+    Electronic,
+    Clothing,
+    Food,
+    Other
+};
+
+/**
+ * @brief Number of ProductType values, for arrays indexed by type
+ */
+inline constexpr std::size_t productTypeCount = 4;
+
+#endif
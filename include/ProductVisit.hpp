@@ -0,0 +1,41 @@
+#ifndef PRODUCTVISIT_HPP
+#define PRODUCTVISIT_HPP
+
+#include <type_traits>
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+
+/**
+ * @brief Calls a visitor with a product cast to its concrete type
+ * * Dispatch is a switch on the product's type tag followed by a static_cast,
+ * so it costs no RTTI lookup. The visitor must accept const Electronic&,
+ * const Clothing& and const Food&; products tagged ProductType::Other (direct
+ * subclasses of Product or TangibleProduct) are passed as const Product&. A
+ * generic lambda covers all cases at once.
+ * * A subclass of Electronic, Clothing or Food carries its base's tag and is
+ * visited as that base, as a dynamic_cast to the base would find it. A
+ * visitor that calls behaviour a subclass may override, such as printInfo(),
+ * must make a virtual call, not a qualified one like
+ * concrete.Electronic::printInfo().
+ * * @param product The product to visit
+ * @param visitor The callable to invoke
+ * @return Whatever the visitor returns
+ */
+template <typename Visitor>
+decltype(auto) visitProduct(const Product &product, Visitor &&visitor)
+{
+    switch (product.getType())
+    {
+    case ProductType::Electronic:
+        return std::forward<Visitor>(visitor)(static_cast<const Electronic &>(product));
+    case ProductType::Clothing:
+        return std::forward<Visitor>(visitor)(static_cast<const Clothing &>(product));
+    case ProductType::Food:
+        return std::forward<Visitor>(visitor)(static_cast<const Food &>(product));
+    default:
+        return std::forward<Visitor>(visitor)(product);
+    }
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef REPRICING_HPP
+#define REPRICING_HPP
+
+#include <algorithm> // For std::clamp
+#include <cmath>     // For std::isnan
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "ProductStore.hpp"
+#include "Bitmap.hpp"
+
+/**
+ * @brief A single bulk price operation
+ * * Adjustments are applied in order by Warehouse::reprice. Every step is
+ * followed by a branch-free clamp to 0, so no adjustment can produce a
+ * negative price (the same rule Product::setPrice enforces, without logging).
+ * * Amounts are Money cents and factors are parts per million (see
+ * Money::scaled), so applying the same steps always gives the same prices.
+ */
+struct PriceAdjustment
+{
+    enum class Kind : std::uint8_t
+    {
+        Multiply, // price = price * a / Money::ppmScale, rounded half to even
+        Add,      // price = price + a cents
+        Clamp,    // price = min(max(price, a cents), b cents)
+        Set       // price = a cents
+    };
+
+    Kind kind;
+    std::int64_t a;
+    std::int64_t b = 0;
+
+    /**
+     * @brief Largest factor multiply() passes through; larger ones are clamped to it
+     */
+    static constexpr double maxFactor = 1'000'000.0;
+
+    /**
+     * @brief Multiplies prices by a factor (e.g. 0.99 for 1% off)
+     * * The factor is clamped to [0, maxFactor] (a negative factor would only
+     * give prices that the step's clamp turns into 0 anyway), and a NaN factor
+     * leaves prices unchanged. Callers taking a factor from user input should
+     * reject values outside a range that makes sense to them first.
+     */
+    static PriceAdjustment multiply(double factor)
+    {
+        const double bounded = std::isnan(factor) ? 1.0 : std::clamp(factor, 0.0, maxFactor);
+        return {Kind::Multiply, *Money::toPpm(bounded)};
+    }
+    static PriceAdjustment add(Money amount) { return {Kind::Add, amount.cents()}; }
+    static PriceAdjustment clamp(Money low, Money high) { return {Kind::Clamp, low.cents(), high.cents()}; }
+    static PriceAdjustment set(Money price) { return {Kind::Set, price.cents()}; }
+};
+
+/**
+ * @brief Selects the subset of products a bulk operation applies to
+ * * Every criterion that is set must match (logical AND). A default-constructed
+ * filter selects every product. Combinations with OR and NOT are built as a
+ * Bitmap from the Warehouse bitmap indexes and passed as the selection.
+ */
+struct ProductFilter
+{
+    std::optional<ProductType> type;
+    std::optional<Money> minPrice; // inclusive
+    std::optional<Money> maxPrice; // inclusive
+    std::vector<int> ids;           // empty means "any ID"
+    std::optional<Bitmap> selection; // IDs to restrict to; an empty bitmap selects nothing
+
+    bool selectsAll() const { return !type && !minPrice && !maxPrice && ids.empty() && !selection; }
+};
+
+/**
+ * @brief Vectorisable kernels that apply price adjustments to a price column
+ * * The loops are written without data-dependent branches (std::min/std::max
+ * and selects instead of if/else) so the compiler can turn them into SIMD code.
+ */
+namespace Repricing
+{
+    /**
+     * @brief Applies an adjustment to every price in the column
+     * * @param prices The contiguous price column
+     * @param adjustment The operation to apply
+     */
+    void apply(std::span<Money> prices, const PriceAdjustment &adjustment);
+
+    /**
+     * @brief Applies an adjustment to the prices whose mask byte is non-zero
+     * * @param prices The contiguous price column
+     * @param mask One byte per price; 0 leaves the price untouched
+     * @param adjustment The operation to apply
+     */
+    void applyMasked(std::span<Money> prices, std::span<const std::uint8_t> mask,
+                     const PriceAdjustment &adjustment);
+}
+
+#endif
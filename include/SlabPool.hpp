@@ -0,0 +1,136 @@
+#ifndef SLABPOOL_HPP
+#define SLABPOOL_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Counters describing a SlabPool
+ */
+struct SlabPoolStats
+{
+    std::size_t slabs = 0;       // Slabs obtained from the global heap
+    std::size_t bytes = 0;       // Bytes in those slabs
+    std::size_t liveObjects = 0; // Objects currently handed out
+};
+
+/**
+ * @brief Pool of small objects carved out of large slabs, owned by one container or warehouse
+ * * Objects are rounded up to a multiple of granularity bytes, and each size
+ * class keeps an intrusive free list of the objects returned to it, which the
+ * next allocation of that class reuses. Other allocations bump a cursor
+ * through the newest slab. Allocating or freeing an object is a few pointer
+ * moves instead of a malloc/free call, and objects of one owner end up densely
+ * packed instead of spread across the heap.
+ * * A pool is not shared between threads: it belongs to one owner (a
+ * Warehouse, or one index container through SlabAllocator) and is only used
+ * under that owner's own synchronisation, so it takes no lock. Slabs are
+ * freed all at once when the pool is released or destroyed, without visiting
+ * the objects in them; objects larger than maxObjectSize go to the global heap.
+ */
+class SlabPool
+{
+public:
+    static constexpr std::size_t granularity = 16;   // Also the strongest alignment the pool provides
+    static constexpr std::size_t maxObjectSize = 256; // Larger objects go to the global heap
+    static constexpr std::size_t slabSize = 64 * 1024;
+
+private:
+    struct FreeSlot
+    {
+        FreeSlot *next;
+    };
+
+    std::vector<std::unique_ptr<std::byte[]>> slabs_;
+    std::array<FreeSlot *, maxObjectSize / granularity> free_{};
+    std::byte *cursor_ = nullptr; // Next unused byte in the newest slab
+    std::size_t remaining_ = 0;   // Unused bytes after cursor_
+    std::size_t live_ = 0;
+
+    static std::size_t classOf(std::size_t size) { return (size + granularity - 1) / granularity - 1; }
+
+public:
+    SlabPool() = default;
+    SlabPool(SlabPool &&other) noexcept;
+    SlabPool &operator=(SlabPool &&other) noexcept;
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    /**
+     * @brief Hands out uninitialised storage, aligned to granularity
+     * * @param size The object size in bytes
+     */
+    void *allocate(std::size_t size);
+
+    /**
+     * @brief Returns storage obtained from allocate() with the same size
+     */
+    void deallocate(void *block, std::size_t size) noexcept;
+
+    /**
+     * @brief Frees every slab; all storage handed out becomes invalid and no destructor runs
+     */
+    void release() noexcept;
+
+    SlabPoolStats stats() const { return {slabs_.size(), slabs_.size() * slabSize, live_}; }
+};
+
+/**
+ * @brief Standard allocator that takes single objects from a SlabPool of its own
+ * * Lets node-based containers (std::set, std::unordered_map) keep their nodes
+ * in slabs: the container rebinds the allocator to its node type, and all the
+ * rebound copies share the pool of the allocator they came from. A
+ * default-constructed allocator creates a new pool, so every container gets
+ * its own, which lives as long as the container (it is held by shared_ptr)
+ * and is released with it. Moving or swapping containers moves the pool
+ * along. Requests for more than one object (e.g. a hash table's bucket
+ * array) go to the global heap.
+ */
+template <typename T>
+struct SlabAllocator
+{
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    std::shared_ptr<SlabPool> pool;
+
+    SlabAllocator() : pool(std::make_shared<SlabPool>()) {}
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U> &other) noexcept : pool(other.pool) {}
+
+    static_assert(alignof(T) <= SlabPool::granularity, "SlabPool storage is only aligned to its granularity");
+
+    /**
+     * @brief Gives a copied container a pool of its own
+     */
+    SlabAllocator select_on_container_copy_construction() const { return SlabAllocator(); }
+
+    T *allocate(std::size_t count)
+    {
+        if (count == 1)
+        {
+            return static_cast<T *>(pool->allocate(sizeof(T)));
+        }
+        return static_cast<T *>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T *block, std::size_t count) noexcept
+    {
+        if (count == 1)
+        {
+            pool->deallocate(block, sizeof(T));
+            return;
+        }
+        ::operator delete(block, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U> &other) const noexcept { return pool == other.pool; }
+};
+
+#endif
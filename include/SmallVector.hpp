@@ -0,0 +1,164 @@
+#ifndef SMALLVECTOR_HPP
+#define SMALLVECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief Contiguous vector that keeps up to N elements inside the object itself
+ * * While the size stays at or below N the elements live in an inline buffer,
+ * so creating, copying and destroying a small vector never touches the heap.
+ * Growing past N moves the elements to one heap block whose capacity doubles
+ * as needed, like std::vector. Copies of a vector that fits inline are inline
+ * again, whatever the capacity of the source.
+ * * Elements must be trivially copyable; they are moved around with memcpy and
+ * never destroyed individually.
+ */
+template <typename T, std::size_t N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector only holds trivially copyable types");
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+    T *data_;
+    std::uint32_t size_ = 0;
+    std::uint32_t capacity_ = N;
+    alignas(T) std::byte inline_[N * sizeof(T)];
+
+    T *inlineData() { return reinterpret_cast<T *>(inline_); }
+    bool isInline() const { return data_ == reinterpret_cast<const T *>(inline_); }
+
+    void release()
+    {
+        if (!isInline())
+            ::operator delete(data_);
+    }
+
+    void assign(const SmallVector &other)
+    {
+        if (other.size_ > capacity_)
+        {
+            release();
+            data_ = static_cast<T *>(::operator new(other.size_ * sizeof(T)));
+            capacity_ = other.size_;
+        }
+        std::memcpy(static_cast<void *>(data_), other.data_, other.size_ * sizeof(T));
+        size_ = other.size_;
+    }
+
+    void steal(SmallVector &other)
+    {
+        if (other.isInline())
+        {
+            std::memcpy(static_cast<void *>(data_), other.data_, other.size_ * sizeof(T));
+        }
+        else
+        {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    static constexpr std::size_t inlineCapacity = N;
+
+    SmallVector() : data_(inlineData()) {}
+    SmallVector(const SmallVector &other) : data_(inlineData()) { assign(other); }
+    SmallVector(SmallVector &&other) noexcept : data_(inlineData()) { steal(other); }
+    ~SmallVector() { release(); }
+
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+            assign(other);
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            data_ = inlineData();
+            capacity_ = N;
+            steal(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Makes room for at least capacity elements without further reallocation
+     */
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= capacity_)
+            return;
+        T *grown = static_cast<T *>(::operator new(capacity * sizeof(T)));
+        std::memcpy(static_cast<void *>(grown), data_, size_ * sizeof(T));
+        release();
+        data_ = grown;
+        capacity_ = static_cast<std::uint32_t>(capacity);
+    }
+
+    /**
+     * @brief Inserts a value before pos, shifting the following elements up by one
+     * * @return An iterator to the inserted element
+     */
+    iterator insert(const_iterator pos, const T &value)
+    {
+        const std::size_t at = static_cast<std::size_t>(pos - data_);
+        const T copy = value; // value may live in this vector
+        if (size_ == capacity_)
+            reserve(std::size_t{capacity_} * 2);
+        std::memmove(static_cast<void *>(data_ + at + 1), data_ + at, (size_ - at) * sizeof(T));
+        data_[at] = copy;
+        ++size_;
+        return data_ + at;
+    }
+
+    void push_back(const T &value) { insert(end(), value); }
+
+    /**
+     * @brief Removes the element at pos, shifting the following elements down by one
+     * * @return An iterator to the element that followed the removed one
+     */
+    iterator erase(const_iterator pos)
+    {
+        const std::size_t at = static_cast<std::size_t>(pos - data_);
+        std::memmove(static_cast<void *>(data_ + at), data_ + at + 1, (size_ - at - 1) * sizeof(T));
+        --size_;
+        return data_ + at;
+    }
+
+    /**
+     * @brief Removes every element; the capacity (and any heap block) is kept
+     */
+    void clear() { size_ = 0; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    T *data() { return data_; }
+    const T *data() const { return data_; }
+    T &operator[](std::size_t index) { return data_[index]; }
+    const T &operator[](std::size_t index) const { return data_[index]; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+};
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.hpp"
+#include "Money.hpp"
+
+class Warehouse;    // Forward declaration
+class OrderManager; // Forward declaration
+
+/**
+ * @brief On-disk layout of a binary warehouse snapshot
+ * * A snapshot file is a Header, followed by a table of SectionEntry records,
+ * followed by the sections themselves. Every section is a flat array of
+ * fixed-size elements starting at an 8-byte aligned offset, so a reader can
+ * map the file and use the arrays in place. Values are stored in the byte
+ * order of the machine that wrote them; byteOrder lets a reader detect a
+ * mismatch. Readers ignore section kinds they do not know, so later versions
+ * can add sections without breaking older readers.
+ * * Version 2 stores prices as int64 cents (ProductPriceCents) instead of the
+ * float64 ProductPrices section of version 1; both are still readable. The
+ * OrderStatuses section was added later within version 2; without it every
+ * order is restored as open.
+ */
+namespace SnapshotFormat
+{
+    inline constexpr char magic[8] = {'S', 'I', 'S', 'N', 'A', 'P', '\0', '\0'};
+    inline constexpr std::uint32_t currentVersion = 2;
+    inline constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+    enum class SectionKind : std::uint32_t
+    {
+        ProductIds = 1,    // int32 per product
+        ProductPrices,     // float64 per product (version 1 only)
+        ProductQuantities, // int32 per product
+        ProductWeights,    // float64 per product
+        ProductTypes,      // uint8 ProductType per product
+        ProductNames,      // StringRef per product
+        ProductAttributes, // StringRef per product (warranty, size or expiration date)
+        StringPool,        // char; the bytes StringRefs point into
+        OrderOffsets,      // uint64 per order plus one; order i owns lines [offsets[i], offsets[i + 1])
+        OrderLines,        // OrderLine per order line
+        ProductPriceCents, // int64 cents per product (version 2 and later)
+        OrderStatuses      // uint8 OrderStatus per order (optional)
+    };
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t sectionCount;
+        std::uint32_t reserved;
+        std::uint64_t fileSize;
+    };
+
+    struct SectionEntry
+    {
+        SectionKind kind;
+        std::uint32_t elementSize;
+        std::uint64_t offset;
+        std::uint64_t count;
+    };
+
+    struct StringRef
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    struct OrderLine
+    {
+        std::int32_t productId;
+        std::int32_t quantity;
+    };
+}
+
+/**
+ * @brief Zero-copy, validated view of a snapshot file
+ * * The file is memory-mapped and, after the header and section table have been
+ * checked, every section is exposed as a span pointing straight into the
+ * mapping. No record is parsed or copied until a caller asks for it.
+ */
+class SnapshotView
+{
+    MappedFile file_;
+    std::uint32_t version_ = 0;
+
+    std::span<const std::int32_t> ids_;
+    std::span<const std::int64_t> priceCents_;
+    std::span<const double> legacyPrices_; // Version 1 files
+    std::span<const std::int32_t> quantities_;
+    std::span<const double> weights_;
+    std::span<const std::uint8_t> types_;
+    std::span<const SnapshotFormat::StringRef> names_;
+    std::span<const SnapshotFormat::StringRef> attributes_;
+    std::span<const char> stringPool_;
+    std::span<const std::uint64_t> orderOffsets_;
+    std::span<const SnapshotFormat::OrderLine> orderLines_;
+    std::span<const std::uint8_t> orderStatuses_;
+
+    explicit SnapshotView(MappedFile file) : file_(std::move(file)) {}
+    std::expected<void, std::string> bindSections();
+
+public:
+    /**
+     * @brief Maps and validates a snapshot file
+     * * @param path The snapshot file to open
+     * @return The view, or an error message if the file is missing, truncated or
+     * malformed (which includes two products with the same ID)
+     */
+    static std::expected<SnapshotView, std::string> open(const std::string &path);
+
+    std::uint32_t version() const { return version_; }
+
+    std::size_t productCount() const { return ids_.size(); }
+    std::span<const std::int32_t> ids() const { return ids_; }
+    Money price(std::size_t slot) const
+    {
+        if (priceCents_.empty())
+            return Money::fromDouble(legacyPrices_[slot]).value_or(Money()); // An unrepresentable legacy price reads as 0
+        return Money::fromCents(priceCents_[slot]);
+    }
+    std::span<const std::int32_t> quantities() const { return quantities_; }
+    std::span<const double> weights() const { return weights_; }
+    std::span<const std::uint8_t> types() const { return types_; }
+    std::string_view name(std::size_t slot) const { return resolve(names_[slot]); }
+    std::string_view attribute(std::size_t slot) const { return resolve(attributes_[slot]); }
+
+    std::size_t orderCount() const { return orderOffsets_.empty() ? 0 : orderOffsets_.size() - 1; }
+    std::span<const SnapshotFormat::OrderLine> orderLines(std::size_t order) const
+    {
+        return orderLines_.subspan(orderOffsets_[order], orderOffsets_[order + 1] - orderOffsets_[order]);
+    }
+    /**
+     * @brief Gets one OrderStatus value per order, or an empty span if the snapshot has none
+     */
+    std::span<const std::uint8_t> orderStatuses() const { return orderStatuses_; }
+
+    std::string_view resolve(SnapshotFormat::StringRef ref) const
+    {
+        return {stringPool_.data() + ref.offset, ref.length};
+    }
+};
+
+/**
+ * @brief Saving and restoring whole-system snapshots (products and orders)
+ */
+namespace Snapshot
+{
+    /**
+     * @brief Serialises the warehouse and all orders into the bytes of a snapshot file
+     * * Capturing state this way is a single pass of column copies; the bytes
+     * can then be written to disk later, e.g. on a background thread.
+     * * @param warehouse The warehouse whose products are saved
+     * @param orderManager The orders to save
+     * @return The complete snapshot file contents
+     */
+    std::vector<char> encode(const Warehouse &warehouse, const OrderManager &orderManager);
+
+    /**
+     * @brief Durably writes snapshot bytes to a file
+     * * The bytes are written to a temporary file, flushed to disk and renamed
+     * over path, so a crash never leaves a half-written snapshot behind. The
+     * containing directory is flushed after the rename, so the file is
+     * durable under its final name once this returns.
+     * * @param path The snapshot file to write
+     * @param bytes The snapshot contents, as produced by encode()
+     * @return Nothing on success, or an error message
+     */
+    std::expected<void, std::string> writeFile(const std::string &path, std::span<const char> bytes);
+
+    /**
+     * @brief Writes the warehouse and all orders to a binary snapshot file
+     * * Equivalent to writeFile(path, encode(warehouse, orderManager)).
+     * * @param path The snapshot file to write
+     * @param warehouse The warehouse whose products are saved
+     * @param orderManager The orders to save
+     * @return Nothing on success, or an error message
+     */
+    std::expected<void, std::string> save(const std::string &path, const Warehouse &warehouse,
+                                          const OrderManager &orderManager);
+
+    /**
+     * @brief Replaces the contents of a warehouse and order manager with a snapshot
+     * * Products keep the IDs they had when the snapshot was taken, and
+     * Product::globalIdCounter_ is advanced past them. Listeners attached to
+     * the targets are detached.
+     * * @param view The snapshot to restore
+     * @param warehouse The warehouse to fill (its previous products are discarded)
+     * @param orderManager The order manager to fill (its previous orders are discarded)
+     */
+    void restore(const SnapshotView &view, Warehouse &warehouse, OrderManager &orderManager);
+
+    /**
+     * @brief Opens a snapshot file and restores it
+     * * @param path The snapshot file to read
+     * @param warehouse The warehouse to fill
+     * @param orderManager The order manager to fill
+     * @return Nothing on success, or an error message (the targets are untouched on error)
+     */
+    std::expected<void, std::string> load(const std::string &path, Warehouse &warehouse,
+                                          OrderManager &orderManager);
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef STRINGARENA_HPP
+#define STRINGARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Monotonic storage for many small strings
+ * * Strings are copied back to back into large chunks and handed out as
+ * string_views that stay valid until the arena is reset or destroyed (moving
+ * the arena keeps them valid too). Individual strings are never freed;
+ * releasing everything is a single reset() that frees a handful of chunks.
+ */
+class StringArena
+{
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char *cursor_ = nullptr;     // Next free byte in the newest chunk
+    std::size_t remaining_ = 0;  // Free bytes after cursor_
+    std::size_t bytesUsed_ = 0;
+    std::size_t bytesReserved_ = 0;
+
+public:
+    /**
+     * @brief Size of a regular chunk; longer strings get a chunk of their own
+     */
+    static constexpr std::size_t chunkSize = 64 * 1024;
+
+    StringArena() = default;
+    StringArena(StringArena &&other) noexcept;
+    StringArena &operator=(StringArena &&other) noexcept;
+    StringArena(const StringArena &) = delete;
+    StringArena &operator=(const StringArena &) = delete;
+
+    /**
+     * @brief Copies a string into the arena
+     * * @param text The string to copy
+     * @return A view of the copy
+     */
+    std::string_view store(std::string_view text);
+
+    /**
+     * @brief Frees every chunk; all views handed out become invalid
+     */
+    void reset();
+
+    std::size_t bytesUsed() const { return bytesUsed_; }
+    std::size_t bytesReserved() const { return bytesReserved_; }
+};
+
+#endif
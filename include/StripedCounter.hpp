@@ -0,0 +1,72 @@
+#ifndef STRIPEDCOUNTER_HPP
+#define STRIPEDCOUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/**
+ * @brief Event counter that many threads can bump at once without contending
+ * * The count is spread over cache-line sized stripes and every thread adds to
+ * its own stripe (threads are assigned stripes round-robin the first time
+ * they count anything), so increments from different threads do not bounce a
+ * shared cache line between cores. Reading sums the stripes; a read racing
+ * with increments sees some of them and not others.
+ * * Copying or moving a counter carries its current value over, so classes
+ * holding one keep their defaulted copy and move operations.
+ */
+class StripedCounter
+{
+    static constexpr std::size_t stripeCount = 64;
+
+    struct alignas(64) Stripe
+    {
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    Stripe stripes_[stripeCount];
+
+    static std::size_t threadStripe()
+    {
+        static std::atomic<std::size_t> nextStripe{0};
+        thread_local const std::size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % stripeCount;
+        return stripe;
+    }
+
+public:
+    StripedCounter() = default;
+    StripedCounter(const StripedCounter &other) { stripes_[0].count.store(other.value(), std::memory_order_relaxed); }
+
+    StripedCounter &operator=(const StripedCounter &other)
+    {
+        if (this != &other)
+        {
+            const std::uint64_t total = other.value();
+            for (Stripe &stripe : stripes_)
+                stripe.count.store(0, std::memory_order_relaxed);
+            stripes_[0].count.store(total, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    void add(std::uint64_t count = 1) { stripes_[threadStripe()].count.fetch_add(count, std::memory_order_relaxed); }
+    StripedCounter &operator++()
+    {
+        add();
+        return *this;
+    }
+
+    /**
+     * @brief Gets the total of every stripe
+     */
+    std::uint64_t value() const
+    {
+        std::uint64_t total = 0;
+        for (const Stripe &stripe : stripes_)
+            total += stripe.count.load(std::memory_order_relaxed);
+        return total;
+    }
+};
+
+#endif
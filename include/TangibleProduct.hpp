@@ -28,8 +28,10 @@ public:
      * @param price The price of the tangible product.
      * @param quantity The quantity of the tangible product in inventory.
      * @param weight The weight of the tangible product.
+     * @param type The concrete subclass being constructed.
      */
-    TangibleProduct(const std::string& name, double price, int quantity, double weight);
+    TangibleProduct(const std::string& name, Money price, int quantity, double weight,
+                    ProductType type = ProductType::Other);
 
     /**
      * @brief Destructor for the TangibleProduct class.
@@ -0,0 +1,238 @@
+#ifndef TASKSCHEDULER_HPP
+#define TASKSCHEDULER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Grain sizes of the parallel bulk operations, in elements per task
+ * * A larger grain means fewer, longer tasks: less scheduling overhead but
+ * coarser load balancing. Results never depend on the grain sizes or the
+ * number of threads.
+ */
+struct ParallelGrains
+{
+    std::size_t reprice = 65536;        // Prices per repricing task
+    std::size_t sort = 32768;           // Elements per sorted run and per merge task
+    std::size_t slotResolution = 16384; // Product IDs per Warehouse::resolveSlots task
+    std::size_t orderPricing = 4096;    // Orders per pricing task
+    std::size_t fulfillment = 4096;     // Orders per fulfillment task
+};
+
+/**
+ * @brief Work-stealing thread pool with deterministic parallel loops, reductions and sorts
+ * * Every thread (the workers and the callers waiting for their tasks) owns a
+ * double-ended task queue. A thread pushes and pops tasks at the back of its
+ * own queue, newest first; an idle thread steals the oldest task from the
+ * front of another queue, which in a recursively split loop is the largest
+ * remaining piece. Threads that are not workers share queue 0. Waiting
+ * callers run queued tasks instead of blocking, so loops can nest. Idle
+ * workers sleep on a condition variable.
+ * * The primitives cut their range into fixed chunks of grain elements
+ * whatever the thread count, combine partial results in chunk order and sort
+ * stably, so they return the same result on one thread as on sixteen. With a
+ * thread count of 1 there are no workers and every chunk runs on the caller.
+ * * The first exception thrown by a task is rethrown by the call that waits
+ * for it, once all of its tasks have finished.
+ */
+class TaskScheduler
+{
+    /**
+     * @brief Tasks spawned by one parallel call, counted until they have all run
+     */
+    struct TaskGroup
+    {
+        std::atomic<std::size_t> pending{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct alignas(64) TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_; // Queue 0 is shared by threads that are not workers
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> sleepers_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false; // Guarded by sleepMutex_
+
+    std::size_t ownQueue() const;
+    void spawn(TaskGroup &group, std::function<void()> task);
+    bool runOne(std::size_t queue);
+    void wait(TaskGroup &group);
+    void workerLoop(std::size_t queue);
+    void start(std::size_t threads);
+    void stop();
+    void splitChunks(TaskGroup &group, std::size_t first, std::size_t last,
+                     const std::function<void(std::size_t)> &runChunk);
+
+    /**
+     * @brief Runs runChunk(0), ..., runChunk(chunks - 1), in parallel, and waits for all of them
+     */
+    void runChunks(std::size_t chunks, const std::function<void(std::size_t)> &runChunk);
+
+public:
+    /**
+     * @brief Starts a scheduler
+     * * @param threads The number of threads that run tasks, counting the caller: threads - 1 workers are started
+     */
+    explicit TaskScheduler(std::size_t threads);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+    /**
+     * @brief Gets the scheduler the bulk operations use
+     * * It starts with std::thread::hardware_concurrency() threads.
+     */
+    static TaskScheduler &global();
+
+    /**
+     * @brief Gets the grain sizes the bulk operations use; they may be changed at any time
+     */
+    static ParallelGrains &grains();
+
+    /**
+     * @brief Replaces the workers so that threads threads run tasks
+     * * Must not be called while parallel calls on this scheduler are running.
+     */
+    void setThreadCount(std::size_t threads);
+
+    /**
+     * @brief Gets the number of threads that run tasks, counting the caller
+     */
+    std::size_t threadCount() const { return queues_.size(); }
+
+    /**
+     * @brief Calls body(from, to) for consecutive ranges of at most grain indexes covering [begin, end)
+     * * The ranges run in parallel, so body must only write data belonging to its own range.
+     */
+    template <typename Body>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Body &&body)
+    {
+        if (end <= begin)
+            return;
+        grain = std::max<std::size_t>(grain, 1);
+        runChunks((end - begin + grain - 1) / grain, [&](std::size_t chunk)
+                  {
+            const std::size_t from = begin + chunk * grain;
+            body(from, std::min(end, from + grain)); });
+    }
+
+    /**
+     * @brief Maps consecutive ranges of at most grain indexes in parallel and combines the results in order
+     * * Computes combine(...combine(combine(identity, map(r0)), map(r1))..., map(rn)) over the ranges
+     * r0, r1, ... of [begin, end), so the result is the same for any number of threads, even when
+     * combine is not associative (floating-point sums, for instance).
+     * * @param map Called as map(from, to); returns a T
+     * @param combine Called as combine(T accumulated, T next); returns a T
+     */
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity, Map &&map,
+                     Combine &&combine)
+    {
+        if (end <= begin)
+            return identity;
+        grain = std::max<std::size_t>(grain, 1);
+        std::vector<T> partials((end - begin + grain - 1) / grain, identity);
+        runChunks(partials.size(), [&](std::size_t chunk)
+                  {
+            const std::size_t from = begin + chunk * grain;
+            partials[chunk] = map(from, std::min(end, from + grain)); });
+        T result = std::move(identity);
+        for (T &partial : partials)
+            result = combine(std::move(result), std::move(partial));
+        return result;
+    }
+
+    /**
+     * @brief Sorts a range stably, in parallel
+     * * Runs of grain elements are sorted with std::stable_sort, then merged
+     * pairwise, each merge pass split into pieces of grain output elements
+     * along the merge path. Equal elements keep their order, so the result
+     * is the one std::stable_sort gives. Needs a default-constructible value
+     * type and a scratch buffer as large as the range.
+     */
+    template <typename RandomIt, typename Compare>
+    void parallelSort(RandomIt first, RandomIt last, Compare comp, std::size_t grain)
+    {
+        using Value = typename std::iterator_traits<RandomIt>::value_type;
+        const std::size_t count = static_cast<std::size_t>(last - first);
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t runs = (count + grain - 1) / grain;
+        if (runs <= 1)
+        {
+            std::stable_sort(first, last, comp);
+            return;
+        }
+        parallelFor(0, count, grain, [&](std::size_t from, std::size_t to)
+                    { std::stable_sort(first + from, first + to, comp); });
+
+        // Merges the sorted runs of length width in source into runs of 2 * width in target
+        auto mergePass = [&](auto source, auto target, std::size_t width)
+        {
+            parallelFor(0, count, grain, [&](std::size_t from, std::size_t to)
+                        {
+                const std::size_t lo = from / (2 * width) * (2 * width);
+                const std::size_t mid = std::min(lo + width, count);
+                const std::size_t hi = std::min(lo + 2 * width, count);
+                // Number of elements of [lo, mid) among the first k outputs of the stable merge
+                auto leftTaken = [&](std::size_t k)
+                {
+                    std::size_t low = k > hi - mid ? k - (hi - mid) : 0;
+                    std::size_t high = std::min(k, mid - lo);
+                    while (low < high)
+                    {
+                        const std::size_t i = low + (high - low) / 2;
+                        const std::size_t j = k - i;
+                        if (j > 0 && !comp(source[mid + j - 1], source[lo + i]))
+                            low = i + 1;
+                        else
+                            high = i;
+                    }
+                    return low;
+                };
+                const std::size_t leftBegin = leftTaken(from - lo);
+                const std::size_t leftEnd = leftTaken(to - lo);
+                std::merge(std::make_move_iterator(source + lo + leftBegin),
+                           std::make_move_iterator(source + lo + leftEnd),
+                           std::make_move_iterator(source + mid + (from - lo - leftBegin)),
+                           std::make_move_iterator(source + mid + (to - lo - leftEnd)), target + from, comp); });
+        };
+
+        std::vector<Value> buffer(count);
+        bool inBuffer = false;
+        for (std::size_t width = grain; width < count; width *= 2)
+        {
+            if (inBuffer)
+                mergePass(buffer.begin(), first, width);
+            else
+                mergePass(first, buffer.begin(), width);
+            inBuffer = !inBuffer;
+        }
+        if (inBuffer)
+        {
+            parallelFor(0, count, grain, [&](std::size_t from, std::size_t to)
+                        { std::move(buffer.begin() + from, buffer.begin() + to, first + from); });
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef TRIGRAMINDEX_HPP
+#define TRIGRAMINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class ProductStore; // Forward declaration
+
+/**
+ * @brief One result of a fuzzy name search
+ */
+struct SearchHit
+{
+    int id;
+    double score; // Share of the query's trigrams found in the name, from 0 to 1
+};
+
+/**
+ * @brief Inverted index from character trigrams to product IDs, for typo-tolerant search
+ * * Names are lower-cased and split into words; each word is padded as
+ * "  word " and cut into overlapping three-character trigrams, so "Cheese"
+ * gives "  c", " ch", "che", "hee", "ees", "ese" and "se ". A query matches a
+ * name when enough of the query's trigrams also occur in the name: all of
+ * them for a substring, most of them when the query has a typo.
+ * * Each trigram has a posting list of product IDs in ascending order, stored
+ * as variable-length deltas in blocks of blockSize IDs. Every block records
+ * its first ID, so an intersection skips whole blocks with a binary search and
+ * only decodes the block that may hold the ID it is looking for. IDs that
+ * arrive out of order (a renamed product joining a new trigram) wait in a
+ * small sorted side list that is merged into the blocks when it grows.
+ * * Removing or renaming a product does not touch the blocks: its old
+ * postings become stale and are filtered out when candidates are re-scored
+ * against their current names. needsRebuild() reports when the stale postings
+ * outweigh the live ones.
+ */
+class TrigramIndex
+{
+public:
+    /**
+     * @brief Returns the current name of a product, or std::nullopt if it no longer exists
+     */
+    using NameLookup = std::function<std::optional<std::string_view>(int)>;
+
+    static constexpr std::size_t blockSize = 128;
+
+    /**
+     * @brief Computes the distinct trigrams of a text, sorted
+     * * @param text The text to split
+     * @param out Receives the trigrams (cleared first)
+     */
+    static void trigrams(std::string_view text, std::vector<std::uint32_t> &out);
+
+    /**
+     * @brief Indexes a product name
+     */
+    void add(int id, std::string_view name);
+
+    /**
+     * @brief Forgets a product; its postings become stale
+     */
+    void remove(int id, std::string_view name);
+
+    /**
+     * @brief Moves a product from its old name's trigrams to the new name's
+     */
+    void rename(int id, std::string_view oldName, std::string_view newName);
+
+    /**
+     * @brief Replaces the whole index with the names of a product store
+     * * Products are added in ID order, so every posting list is built by
+     * appending only.
+     */
+    void rebuild(const ProductStore &store);
+
+    /**
+     * @brief Checks whether stale postings outnumber the live ones
+     */
+    bool needsRebuild() const { return stalePostings_ > 4096 && stalePostings_ > livePostings_; }
+
+    /**
+     * @brief Finds the names that best match a query
+     * * Names are ranked by how many of the query's trigrams they contain; equal
+     * scores are ordered by ID, so older products come first. Names sharing
+     * fewer than half of the query's trigrams are never returned. The search
+     * stops early once k names containing every trigram have been found.
+     * * @param query The text to look for (case-insensitive)
+     * @param k The largest number of results
+     * @param nameOf Returns the current name of a product ID
+     * @return Up to k hits, best first
+     */
+    std::vector<SearchHit> search(std::string_view query, std::size_t k, const NameLookup &nameOf) const;
+
+    /**
+     * @brief Gets the number of bytes held by the posting lists
+     */
+    std::size_t postingBytes() const;
+
+private:
+    class PostingList
+    {
+        std::vector<std::uint8_t> bytes_; // Deltas after each block's first ID
+        struct Block
+        {
+            std::int32_t first;
+            std::uint32_t offset; // Where the block's deltas start in bytes_
+        };
+        std::vector<Block> blocks_;
+        std::vector<std::int32_t> pending_; // Sorted IDs below last_, not yet merged
+        std::int32_t last_ = 0;
+        std::uint32_t count_ = 0; // IDs in the blocks
+
+        void append(std::int32_t id);
+        void merge();
+
+    public:
+        class Cursor;
+
+        void add(std::int32_t id);
+        std::size_t size() const { return count_ + pending_.size(); }
+        std::size_t bytes() const;
+
+        /**
+         * @brief Appends every ID in the list to out (block IDs in order, then pending ones)
+         */
+        void collect(std::vector<std::int32_t> &out) const;
+    };
+
+    std::unordered_map<std::uint32_t, PostingList> lists_;
+    std::size_t livePostings_ = 0;
+    std::size_t stalePostings_ = 0;
+};
+
+#endif
@@ -1,14 +1,63 @@
 #ifndef WAREHOUSE_HPP
 #define WAREHOUSE_HPP
 
+#include <array>
+#include <cstdint>
 #include <span> // For std::span
 #include <vector>
 #include <string>
 #include <memory>
 #include <expected>
 #include <optional>
+#include <unordered_map>
+#include <map>
+#include <limits>
 #include <algorithm> // For std::sort, std::find_if, std::for_each
 #include "Product.hpp"
+#include "ProductStore.hpp"
+#include "Repricing.hpp"
+#include "MutationListener.hpp"
+#include "InternPool.hpp"
+#include "Date.hpp"
+#include "PriceIndex.hpp"
+#include "NameIndex.hpp"
+#include "TrigramIndex.hpp"
+#include "Bitmap.hpp"
+#include "SlabPool.hpp"
+#include "StripedCounter.hpp"
+
+/**
+ * @brief Products sharing one attribute value (a size, warranty or expiration date)
+ */
+struct AttributeGroup
+{
+    InternedString value;
+    std::size_t products = 0;
+    long long units = 0;
+};
+
+/**
+ * @brief A change to the price a product contributes to order totals
+ * * Adding a product counts as a change from zero and removing one as a change
+ * to zero, since an order line whose product is missing adds nothing.
+ */
+struct PriceChange
+{
+    std::uint64_t epoch; // The price epoch the change started
+    int productId;
+    Money before;
+    Money after;
+};
+
+/**
+ * @brief Outcome of writing off expired stock
+ */
+struct WriteOffReport
+{
+    std::size_t products = 0; // Products whose stock was written off
+    long long units = 0;      // Units removed from stock
+    Money value;              // Stock value of those units
+};
 
 /**
  * @brief Warehouse class representing a storage facility for products
@@ -19,26 +68,198 @@
 class Warehouse
 {
     /**
-     * @brief Vector of unique pointers to store Product objects
-     * * The products_ vector holds unique pointers to Product objects, ensuring
-     * that each product is owned by the warehouse and properly managed.
+     * @brief Storage of the products the warehouse builds itself (createProduct, assign)
+     * * A pooled product holds no heap memory of its own: its name is a view
+     * into store_'s arena and its attribute an interned handle. The pool
+     * therefore drops pooled products without running their destructors, so
+     * clearing or destroying a warehouse frees them slab by slab instead of
+     * one object at a time.
+     */
+    SlabPool productPool_;
+
+    /**
+     * @brief The Product objects, aligned slot-for-slot with store_
+     * * Each one lives either in productPool_ or, if it was handed to
+     * addProduct, wherever its caller allocated it, and is then owned
+     * through owned_.
+     */
+    std::vector<Product *> products_;
+
+    /**
+     * @brief Owners of the products handed to addProduct, aligned with products_; null for pooled products
+     */
+    std::vector<std::unique_ptr<Product>> owned_;
+
+    /**
+     * @brief Hash index from product ID to its slot in products_
+     * * Lets findProductById answer in constant time instead of scanning the
+     * whole catalog. Every operation that moves products around (adding,
+     * sorting, removing) must keep it in step with products_. Its nodes come
+     * from a SlabPool of its own.
      */
-    std::vector<std::unique_ptr<Product>> products_;
+    std::unordered_map<int, std::size_t, std::hash<int>, std::equal_to<int>,
+                       SlabAllocator<std::pair<const int, std::size_t>>>
+        idIndex_;
+
+    /**
+     * @brief Columnar copy of the product data, aligned slot-for-slot with products_
+     * * The hot columns (price, quantity, ...) are authoritative: bulk operations
+     * such as operator(), sortByPriceAscending and the stock totals run directly
+     * over them. The Product objects in products_ are a compatibility view whose
+     * prices and quantities are refreshed lazily (see refreshView()).
+     */
+    ProductStore store_;
+
+    /**
+     * @brief Set when the columns changed and products_ has not been refreshed yet
+     */
+    mutable bool viewStale_ = false;
+
+    /**
+     * @brief Optional observer told about every change (e.g. the persistence journal)
+     */
+    MutationListener *listener_ = nullptr;
 
     /**
      * @brief Mutable attribute to track the number of product accesses by name
      * * The accessCount_ variable is mutable, allowing it to be modified even
      * in const methods. It keeps track of how many times products are accessed by name.
+     * It is a StripedCounter, so lookups running on several threads count correctly.
+     */
+    mutable StripedCounter accessCount_;
+
+    /**
+     * @brief Calendar buckets of food in stock, keyed by expiration date
+     * * Holds the ID of every Food product that has a parsed expiration date
+     * and a quantity above zero. Buckets are visited in date order, so expiry
+     * queries stop at their date limit and never look at the rest of the catalog.
      */
-    mutable int accessCount_ = 0;
+    std::map<Date, std::vector<int>> expiryIndex_;
+
+    /**
+     * @brief Product IDs ordered by price, maintained alongside the price column
+     * * Single-product changes (add, remove, setPrice) update it in place. A bulk
+     * reprice only marks it stale, and it is rebuilt from the columns the next
+     * time it is read.
+     */
+    mutable PriceIndex priceIndex_;
+    mutable bool priceIndexStale_ = false;
+
+    /**
+     * @brief Exact and prefix index over product names
+     * * Its keys are the name views held by store_, which stay valid while the
+     * product exists. Updated by addProduct, removeProduct and renameProduct.
+     */
+    NameIndex nameIndex_;
+
+    /**
+     * @brief Trigram index over product names, for fuzzy search
+     * * Built from the columns by the first search (so bulk loads do not pay
+     * for it), then kept current by addProduct, removeProduct and
+     * renameProduct. Rebuilt again when removals and renames have left too
+     * many stale postings.
+     */
+    mutable TrigramIndex trigramIndex_;
+    mutable bool trigramIndexStale_ = true;
+
+    /**
+     * @brief Bitmap indexes of product IDs by type, attribute value and stock status
+     * * Kept current by addProduct, removeProduct and updateQuantity (the only
+     * place a quantity changes). Attribute bitmaps are keyed by the interned
+     * warranty, size or expiration date of each type, so a lookup compares no
+     * strings.
+     */
+    Bitmap allIds_;
+    Bitmap inStockIds_;
+    std::array<Bitmap, productTypeCount> typeIds_;
+    std::array<std::unordered_map<InternedString, Bitmap>, productTypeCount> attributeIds_;
+
+    /**
+     * @brief Price epoch, replaced by a fresh one whenever a product's price changes
+     * * Epochs come from one process-wide counter, so no two warehouses (nor a
+     * warehouse before and after a snapshot replaces it) ever share one, and a
+     * cache of prices or totals stamped with an epoch can tell whether it is
+     * still current. Changes to single products (setPrice, add, remove) are
+     * also kept in priceLog_ so such a cache can adjust itself instead of
+     * recomputing; a bulk reprice clears the log.
+     */
+    std::uint64_t priceEpoch_ = nextPriceEpoch();
+    std::uint64_t priceLogStart_ = priceEpoch_; // The epoch the first entry of priceLog_ came after
+    std::vector<PriceChange> priceLog_;
+
+    /**
+     * @brief Change stamps of the slot pages, for copy-on-write copies such as CatalogVersions
+     * * Slots are grouped into pages of changePageSize. A change stamps each
+     * page it touched with a fresh number from a process-wide counter:
+     * hotPageStamps_ for the ID, price, quantity and type columns and
+     * coldPageStamps_ for names, weights and attributes. A copy of a page that
+     * kept the stamp it was taken at is current exactly while the page still
+     * has that stamp, whichever warehouse it came from.
+     */
+    std::vector<std::uint64_t> hotPageStamps_;
+    std::vector<std::uint64_t> coldPageStamps_;
+    std::uint64_t changeStamp_ = 0; // The latest stamp drawn by this warehouse
+
+    /**
+     * @brief Draws a new epoch from the process-wide counter
+     */
+    static std::uint64_t nextPriceEpoch();
+
+    /**
+     * @brief Draws a new change stamp and puts it on the pages holding slots [first, last)
+     * * Also sizes the stamp arrays to the current number of slots, so call it
+     * after the columns have changed.
+     */
+    void markChanged(std::size_t first, std::size_t last, bool hot, bool cold);
+
+    /**
+     * @brief Starts a new price epoch for a change to one product and records it in priceLog_
+     */
+    void logPriceChange(int id, Money before, Money after);
+
+    /**
+     * @brief Finishes adding the product just appended to store_: keeps the object, binds its name to the arena and updates every index
+     * * @param product The product
+     * @param owner Its owner if it came from addProduct, or null if it lives in productPool_
+     */
+    void insertAppended(Product *product, std::unique_ptr<Product> owner);
+
+    /**
+     * @brief Destroys a pooled product and returns its storage to productPool_
+     */
+    void destroyPooled(Product *product);
+
+    /**
+     * @brief Adds or removes the product in a slot to or from the bitmap indexes
+     */
+    void indexBitmaps(std::size_t slot);
+    void unindexBitmaps(std::size_t slot);
+
+    /**
+     * @brief Adds or removes the product in a slot to or from expiryIndex_
+     * * Products that are not Food or have no parsed expiration date are ignored.
+     */
+    void indexExpiry(std::size_t slot);
+    void unindexExpiry(std::size_t slot);
+
+    /**
+     * @brief Rebuilds idIndex_ entries for all slots starting at first
+     * * @param first The first slot whose index entry may be stale
+     */
+    void reindexFrom(std::size_t first);
+
+    /**
+     * @brief Copies column prices and quantities back into the Product view if it is stale
+     */
+    void refreshView() const;
 
 public:
     Warehouse() = default;
-    ~Warehouse() = default; // Default destructor is fine with unique_ptr managing memory
+    ~Warehouse() = default; // productPool_ frees the pooled products, owned_ deletes the others
 
     // Rule of Five: If a destructor, copy constructor, copy assignment,
     // move constructor, or move assignment is declared, the others should be considered.
-    // Here, unique_ptr handles resource management, so default move operations are fine.
+    // Here, SlabPool and unique_ptr handle resource management, so default move operations are fine.
     // Copy operations for a Warehouse would be complex (deep copy of products) and are
     // typically deleted or explicitly defined if needed. For now, we rely on defaults
     // and primarily pass Warehouse by reference. If copies were needed:
@@ -50,54 +271,365 @@ public:
     /**
      * @brief Adds a product to the warehouse
      * * This method takes ownership of a Product represented by a unique pointer
-     * and stores it in the warehouse.
+     * and stores it in the warehouse. The object stays where it was allocated,
+     * but its name is moved into the warehouse's name arena. A product whose
+     * ID is already in the warehouse (e.g. a copy of one of its products) is
+     * rejected with a warning.
      * * @param product A unique pointer to the Product to be added
+     * @return false if the pointer is null or the ID is already present (the product is destroyed)
+     */
+    bool addProduct(std::unique_ptr<Product> product);
+    /**
+     * @brief Builds a product of a built-in type inside the warehouse and adds it
+     * * Same as addProduct(ProductStore::makeProduct(...)), but the object is
+     * constructed in the warehouse's pool and the name copied once, straight
+     * into the name arena, so neither takes a heap allocation of its own. A
+     * negative price or quantity is clamped to 0, as in the constructors.
+     * Loaders and journal replay add products this way.
+     * * @param type The subclass to build
+     * @param name The product name
+     * @param price The price
+     * @param quantity The quantity in stock
+     * @param weight The weight
+     * @param attribute The warranty, size or expiration date, depending on the type
+     * @return The new product, or nullptr (and nothing is added) for
+     * ProductType::Other or if the ID it drew is already present (see
+     * Product::setNextId)
+     */
+    const Product *createProduct(ProductType type, std::string_view name, Money price, int quantity,
+                                 double weight, const std::string &attribute);
+    /**
+     * @brief Sets the observer notified after every change to the warehouse
+     * * @param listener The observer, or nullptr to stop notifications
+     */
+    void setListener(MutationListener *listener) { listener_ = listener; }
+
+    /**
+     * @brief Pre-allocates room for the given total number of products
+     * * Bulk loaders call this once before inserting, so neither the product
+     * vector, the columns nor the ID index grow incrementally.
+     * * @param capacity The total number of products to make room for
+     */
+    void reserve(std::size_t capacity);
+    /**
+     * @brief Replaces the whole warehouse with the products of a filled store
+     * * Used by bulk loaders such as Snapshot::restore. The store becomes the
+     * columns as it is; the Product view (built in the warehouse's pool) and the ID, name, bitmap and expiry
+     * indexes are each built in one pass over it, and the price and trigram
+     * indexes on first use. Products keep the IDs in the store, and the ID
+     * counter continues after the highest of them. As when a new Warehouse is
+     * assigned, the listener is detached and is not told.
+     * * @param store The products; every slot must have a built-in type and a
+     * unique ID
+     */
+    void assign(ProductStore store);
+    /**
+     * @brief Removes a product from the warehouse by its ID
+     * * The relative order of the remaining products is preserved.
+     * * @param id The ID of the product to remove
+     * @return true if a product was removed, false if no product has that ID
+     */
+    bool removeProduct(int id);
+    /**
+     * @brief Sets the price of a product identified by its ID
+     * * Updates both the price column and the Product object. A negative price
+     * is clamped to 0, as in Product::setPrice.
+     * * @param id The ID of the product
+     * @param newPrice The new price
+     * @return true if the product exists, false otherwise
+     */
+    bool setPrice(int id, Money newPrice);
+    /**
+     * @brief Changes the stock quantity of a product identified by its ID
+     * * Updates both the quantity column and the Product object. The result is
+     * clamped to 0, as in Product::updateQuantity.
+     * * @param id The ID of the product
+     * @param delta The change in quantity (can be negative)
+     * @return true if the product exists, false otherwise
      */
-    void addProduct(std::unique_ptr<Product> product);
+    bool updateQuantity(int id, int delta);
+    /**
+     * @brief Renames a product identified by its ID
+     * * Updates the name column and the name index; the Product object views
+     * the new name in the arena.
+     * * @param id The ID of the product
+     * @param newName The new name
+     * @return true if the product exists, false otherwise
+     */
+    bool renameProduct(int id, const std::string &newName);
     /**
      * @brief Finds a product in the warehouse by its name
-     * * This method searches the warehouse inventory for a product with the
-     * specified name. Each call to this method increments the access count.
+     * * This method looks the name up in the name index instead of comparing
+     * it with every product. If several products share the name, the one
+     * stored first is returned. Each call to this method increments the access count.
      * * @param name The name of the product to find
      * @return An optional containing a pointer to the found product (const Product*), or
      * std::nullopt if no product with the given name exists
      */
-    std::optional<const Product *> findProductByName(const std::string &name) const;
+    std::optional<const Product *> findProductByName(std::string_view name) const;
+    /**
+     * @brief Finds the products whose name starts with a prefix
+     * * Runs over the ordered name index, so the cost depends on the number of
+     * matches rather than on the size of the catalog. Each call increments the access count.
+     * * @param prefix The start of the name; an empty prefix matches every product
+     * @param limit The largest number of IDs to return
+     * @return The product IDs, ordered by name
+     */
+    std::vector<int> findProductsByPrefix(std::string_view prefix,
+                                          std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+    /**
+     * @brief Searches product names for a text, tolerating typos
+     * * Matches substrings ("cheese" finds "Imported Cheese") and near misses
+     * ("smartfone") through the trigram index. Names containing the whole
+     * query rank first.
+     * * @param query The text to look for (case-insensitive)
+     * @param k The largest number of results
+     * @return Up to k product IDs with their scores, best match first
+     */
+    std::vector<SearchHit> searchProducts(std::string_view query, std::size_t k = 10) const;
+    /**
+     * @brief Gets the trigram index behind searchProducts()
+     * * @return The index, built first if it has not been built yet or too many
+     * removals and renames made it stale
+     */
+    const TrigramIndex &trigramIndex() const;
     /**
      * @brief Finds a product in the warehouse by its ID
-     * * This method searches the warehouse inventory for a product with the
-     * specified ID.
+     * * This method looks the ID up in the hash index, so its cost does not
+     * grow with the size of the catalog.
      * * @param id The ID of the product to find
      * @return An expected containing a pointer to the found product (const Product*), or
      * an error string if no product with the given ID exists
      */
     std::expected<const Product *, std::string> findProductById(int id) const;
+    /**
+     * @brief Marks an ID that resolveSlots() found no product for
+     */
+    static constexpr std::size_t noSlot = std::numeric_limits<std::size_t>::max();
+    /**
+     * @brief Resolves product IDs to their slots in the columnar store
+     * * A slot indexes every column of getStore() and stays valid until the next
+     * add, remove or sort. Batch operations resolve their IDs once and then read
+     * the columns by slot, without building Product views or error strings.
+     * * @param ids The product IDs to resolve
+     * @param slots Receives the slot of each ID (same size as ids), or noSlot
+     * where no product has that ID
+     */
+    void resolveSlots(std::span<const int> ids, std::span<std::size_t> slots) const;
     /**
      * @brief Prints information about all products in the given span
      * * This method iterates through each product in the provided span and
      * calls the printInfo() method on each product to display its information.
-     * * @param products_span A span of unique pointers to Product objects whose
+     * The call stays virtual, so subclasses of the built-in types print with
+     * their own override.
+     * * @param products_span A span of pointers to Product objects whose
      * information will be printed
      */
-    void printProductsInfo(std::span<const std::unique_ptr<Product>> products_span) const;
+    void printProductsInfo(std::span<const Product *const> products_span) const;
     /**
      * @brief Sorts the products in the warehouse by price in ascending order
-     * * This method uses std::sort with a lambda comparator to sort all products
-     * based on their prices, from lowest to highest.
+     * * The sort runs over the price column and then applies the resulting
+     * permutation to the columns and the Product view. Equal prices keep their
+     * relative order. This changes the storage order; to read products in
+     * price order without moving them, use priceIndex() instead.
      */
     void sortByPriceAscending();
 
     /**
      * @brief Gets the products in the warehouse
-     * * @return A const reference to the vector of unique pointers to Product objects
+     * * The Product objects are a read-only compatibility view over the columnar
+     * store; they are brought up to date before being returned. Modify products
+     * through Warehouse (setPrice, updateQuantity, ...) so the columns stay authoritative.
+     * * @return The products, in slot order; valid until the next change to the warehouse
+     */
+    std::span<const Product *const> getProducts() const;
+
+    /**
+     * @brief Gets the columnar product store
+     * * @return A const reference to the hot columns and cold side tables
+     */
+    const ProductStore& getStore() const { return store_; }
+
+    /**
+     * @brief Gets the number of lookups by name, prefix or search text so far
+     */
+    std::uint64_t getAccessCount() const { return accessCount_.value(); }
+
+    /**
+     * @brief Calculates the value of all stock (sum of price * quantity)
+     * * @return The exact total stock value, computed over the hot columns
+     */
+    Money totalStockValue() const;
+
+    /**
+     * @brief Counts all units in stock across every product
+     * * @return The sum of all quantities, computed over the hot columns
+     */
+    long long totalUnits() const;
+
+    /**
+     * @brief Calculates the stock value of each product type
+     * * @return The sum of price * quantity per ProductType, indexed by the tag value
+     */
+    std::array<Money, productTypeCount> stockValueByType() const;
+
+    /**
+     * @brief Groups the products of one type by their attribute value
+     * * E.g. clothing by size or electronics by warranty. Values are matched
+     * by their interned handle, so no string is compared.
+     * * @param type The product type to group
+     * @return One group per distinct value, in order of first appearance
+     */
+    std::vector<AttributeGroup> groupByAttribute(ProductType type) const;
+
+    /**
+     * @brief Lists food in stock that expires before a date
+     * * Runs over the expiry index only, so the cost depends on the number of
+     * products returned, not on the size of the catalog.
+     * * @param limit The first date not included
+     * @return The product IDs, earliest expiration date first
+     */
+    std::vector<int> expiringBefore(Date limit) const;
+
+    /**
+     * @brief Sets the quantity of all food that expired before a date to zero
+     * * Each product goes through updateQuantity, so listeners (e.g. the
+     * journal) see one quantity change per product written off. The cost
+     * depends on the number of expired products only.
+     * * @param today Products with an expiration date before this day are written off
+     * @return How many products and units were written off, and their value
+     */
+    WriteOffReport writeOffExpired(Date today);
+
+    /**
+     * @brief Gets the IDs of all products
+     * * Subtracting another bitmap from it gives that bitmap's complement.
+     */
+    const Bitmap &allProductIds() const { return allIds_; }
+
+    /**
+     * @brief Gets the IDs of the products with a quantity above zero
+     */
+    const Bitmap &inStockIds() const { return inStockIds_; }
+
+    /**
+     * @brief Gets the IDs of the products of one type
+     */
+    const Bitmap &idsOfType(ProductType type) const { return typeIds_[static_cast<std::size_t>(type)]; }
+
+    /**
+     * @brief Gets the IDs of the products of one type with an attribute value
+     * * E.g. clothing of size "M" or electronics with a "2 years" warranty.
+     * * @param type The product type
+     * @param value The warranty, size or expiration date, depending on type
+     * @return The matching IDs; empty if no product has that value
+     */
+    const Bitmap &idsWithAttribute(ProductType type, InternedString value) const;
+
+    /**
+     * @brief Largest number of single-product price changes kept for priceChangesSince()
+     */
+    static constexpr std::size_t priceLogCapacity = 4096;
+
+    /**
+     * @brief Gets the current price epoch
+     * * Two calls return the same value only if no price changed in between,
+     * and no other warehouse ever returns it.
+     */
+    std::uint64_t priceEpoch() const { return priceEpoch_; }
+
+    /**
+     * @brief Gets the single-product price changes made since an epoch
+     * * @param epoch A value priceEpoch() returned earlier
+     * @return The changes in the order they were made (empty if the epoch is
+     * still current), or std::nullopt if they are not all known because the
+     * epoch is from another warehouse, or a bulk reprice or more than
+     * priceLogCapacity changes came after it
+     */
+    std::optional<std::span<const PriceChange>> priceChangesSince(std::uint64_t epoch) const;
+
+    /**
+     * @brief Number of slots per page in the change stamps
+     */
+    static constexpr std::size_t changePageSize = 1024;
+
+    /**
+     * @brief Gets the latest change stamp; it is the same only while nothing has changed
+     */
+    std::uint64_t changeStamp() const { return changeStamp_; }
+
+    /**
+     * @brief Gets the change stamp of every page of the ID, price, quantity and type columns
+     * * Page p holds slots [p * changePageSize, (p + 1) * changePageSize). A
+     * page's stamp is replaced whenever one of its slots changes, and no two
+     * changes in the process get the same stamp.
+     */
+    std::span<const std::uint64_t> hotPageStamps() const { return hotPageStamps_; }
+
+    /**
+     * @brief Gets the change stamp of every page of the names, weights and attributes
+     */
+    std::span<const std::uint64_t> coldPageStamps() const { return coldPageStamps_; }
+
+    /**
+     * @brief Gets the price-ordered index of all products
+     * * Iterating it visits the products from cheapest to most expensive (or the
+     * reverse) without reordering the warehouse. Equal prices are ordered by ID.
+     * * @return The index, rebuilt first if a bulk reprice made it stale
+     */
+    const PriceIndex &priceIndex() const;
+
+    /**
+     * @brief Lists the products whose price lies in a range
+     * * @param low The lowest price included
+     * @param high The highest price included
+     * @return The product IDs, cheapest first
+     */
+    std::vector<int> productsInPriceRange(Money low, Money high) const;
+
+    /**
+     * @brief Lists the k cheapest products
+     * * @return The product IDs, cheapest first
+     */
+    std::vector<int> cheapestProducts(std::size_t k) const;
+
+    /**
+     * @brief Lists the k most expensive products
+     * * @return The product IDs, most expensive first
+     */
+    std::vector<int> mostExpensiveProducts(std::size_t k) const;
+
+    /**
+     * @brief Builds a selection mask for the products matched by a filter
+     * * @param filter The criteria to evaluate
+     * @return One byte per slot, 1 where the product matches and 0 elsewhere
+     */
+    std::vector<std::uint8_t> select(const ProductFilter &filter) const;
+
+    /**
+     * @brief Applies a sequence of bulk price adjustments
+     * * The filter is evaluated once, before the first step, and the steps run as
+     * branch-free integer kernels over the price column. Results below 0 are clamped to 0
+     * without logging.
+     * * @param steps The adjustments to apply, in order
+     * @param filter The products to apply them to (all products by default)
+     * @return The number of products repriced
+     */
+    std::size_t reprice(std::span<const PriceAdjustment> steps, const ProductFilter &filter = {});
+
+    /**
+     * @brief Applies a single bulk price adjustment
+     * * @param step The adjustment to apply
+     * @param filter The products to apply it to (all products by default)
+     * @return The number of products repriced
      */
-    const std::vector<std::unique_ptr<Product>>& getProducts() const { return products_; }
+    std::size_t reprice(const PriceAdjustment &step, const ProductFilter &filter = {});
 
     /**
      * @brief Operator() to simulate periodic warehouse update (e.g., price reduction)
-     * * This method iterates through all products stored in the warehouse and
-     * updates their prices. Currently, it implements a simple pricing strategy
-     * where each product's price is reduced by 1% in each execution cycle.
+     * * This method updates the prices of all products stored in the warehouse
+     * through reprice(). Currently, it implements a simple pricing strategy where
+     * each product's price is reduced by 1% in each execution cycle.
      */
     void operator() ();
 };
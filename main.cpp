@@ -6,6 +6,9 @@
 #include <vector>
 #include <iomanip>   // For std::quoted
 #include <algorithm> // For std::for_each
+#include <numeric>   // For std::iota
+#include <cstdlib>   // For std::atoi, std::strtoull
+#include <cmath>     // For std::isfinite
 
 #include "Warehouse.hpp"
 #include "OrderManager.hpp"
@@ -13,6 +16,11 @@
 #include "Clothing.hpp"
 #include "Food.hpp"
 #include "RandomGenerator.hpp"
+#include "CatalogLoader.hpp"
+#include "CatalogWriter.hpp"
+#include "Snapshot.hpp"
+#include "Persistence.hpp"
+#include "TaskScheduler.hpp"
 
 /**
  * @brief Function to clear the input stream.
@@ -52,7 +60,7 @@ std::unique_ptr<Product> createProductFromUser()
     {
     case 1:
     {
-        auto e = std::make_unique<Electronic>("tmp", 0.0, 0, 0.0, "no-warranty");
+        auto e = std::make_unique<Electronic>("tmp", Money(), 0, 0.0, "no-warranty");
         std::cout << "Enter data for Electronic: [\"name\" price quantity weight \"warranty\"]\n(Note: strings with spaces must be quoted, e.g., \"Laptop X1\" or \"2 years\")\n> ";
         std::cin >> *e;
         if (!std::cin.good())
@@ -66,7 +74,7 @@ std::unique_ptr<Product> createProductFromUser()
     }
     case 2:
     {
-        auto c = std::make_unique<Clothing>("tmp", 0.0, 0, 0.0, "M");
+        auto c = std::make_unique<Clothing>("tmp", Money(), 0, 0.0, "M");
         std::cout << "Enter data for Clothing: [\"name\" price quantity weight \"size\"]\n(Note: strings with spaces must be quoted, e.g., \"Blue Jeans\" or \"XL\")\n> ";
         std::cin >> *c;
         if (!std::cin.good())
@@ -80,7 +88,7 @@ std::unique_ptr<Product> createProductFromUser()
     }
     case 3:
     {
-        auto f = std::make_unique<Food>("tmp", 0.0, 0, 0.0, "2099-12-31");
+        auto f = std::make_unique<Food>("tmp", Money(), 0, 0.0, "2099-12-31");
         std::cout << "Enter data for Food: [\"name\" price quantity weight \"expirationDate\"]\n(Note: strings with spaces must be quoted, e.g., \"Organic Apples\" or \"2025-12-31\")\n> ";
         std::cin >> *f;
         if (!std::cin.good())
@@ -105,86 +113,35 @@ std::unique_ptr<Product> createProductFromUser()
  * Each product line starts with the product type (Electronic, Clothing, or Food) followed by
  * the specific product attributes (name, price, quantity, weight, specific_attribute).
  * String attributes like name, warranty, size, expirationDate are expected to be quoted if they contain spaces.
+ * The file is memory-mapped and parsed by CatalogLoader; malformed lines are reported with their line numbers.
  *
  * @param filename The path to the file to load products from
  * @param warehouse The Warehouse object to add products to
  */
 void loadProductsFromFile(const std::string &filename, Warehouse &warehouse)
 {
-    std::ifstream file(filename);
-    if (!file.is_open())
+    auto report = CatalogLoader::loadFile(filename, warehouse);
+    if (!report)
     {
-        std::cerr << "Unable to open file: " << filename << "\n";
+        std::cerr << report.error() << "\n";
         return;
     }
 
-    std::string type;
-    while (file >> type) // Read product type, loop continues if successful
+    for (const LoadError &error : report->errors)
     {
-        if (type == "Electronic")
-        {
-            auto e = std::make_unique<Electronic>("", 0.0, 0, 0.0, "");
-            file >> *e; // Uses Electronic::operator>>
-            if (file.good())
-            {
-                warehouse.addProduct(std::move(e));
-            }
-            else if (!file.eof()) // Error occurred before EOF
-            {
-                std::cerr << "Error reading Electronic product data from file.\n";
-                file.clear();                                                   // Clear error flags
-                file.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Skip to next line
-            }
-        }
-        else if (type == "Clothing")
-        {
-            auto c = std::make_unique<Clothing>("", 0.0, 0, 0.0, "M");
-            file >> *c; // Uses Clothing::operator>>
-            if (file.good())
-            {
-                warehouse.addProduct(std::move(c));
-            }
-            else if (!file.eof())
-            {
-                std::cerr << "Error reading Clothing product data from file.\n";
-                file.clear();
-                file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            }
-        }
-        else if (type == "Food")
-        {
-            auto f = std::make_unique<Food>("", 0.0, 0, 0.0, "2099-01-01");
-            file >> *f; // Uses Food::operator>>
-            if (file.good())
-            {
-                warehouse.addProduct(std::move(f));
-            }
-            else if (!file.eof())
-            {
-                std::cerr << "Error reading Food product data from file.\n";
-                file.clear();
-                file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            }
-        }
-        else
-        {
-            std::cerr << "Unknown product type in file: " << type << "\n";
-            // Skip the rest of the line for unknown type
-            file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        }
+        std::cerr << filename << ":" << error.line << ": " << error.message << ". Line skipped.\n";
     }
-
-    file.close();
-    std::cout << "Products loaded from file: " << filename << "\n";
+    std::cout << "Products loaded from file: " << filename << " (" << report->loaded << " loaded, "
+              << report->errors.size() << " rejected)\n";
 }
 
 /**
  * @brief Saves all products from the warehouse to a file.
  *
  * This function writes the list of products stored in the given warehouse
- * to a text file. It uses dynamic_cast to determine the actual type of each product
- * (Electronic, Clothing, or Food) and writes their details to the file in a specific format.
- * String attributes are saved using std::quoted to handle spaces.
+ * to a text file through CatalogWriter, which formats the records straight from
+ * the product columns and picks each record's keyword from its type tag.
+ * String attributes are saved in the std::quoted form to handle spaces.
  *
  * The output format matches the format expected by the corresponding input operator (operator>>),
  * specifically: type_string "name" price quantity weight "specific_attribute".
@@ -197,49 +154,16 @@ void loadProductsFromFile(const std::string &filename, Warehouse &warehouse)
  */
 void saveProductsToFile(const std::string &filename, const Warehouse &warehouse)
 {
-    std::ofstream file(filename);
-    if (!file.is_open())
+    auto saved = CatalogWriter::saveFile(filename, warehouse);
+    if (!saved)
     {
-        std::cerr << "Cannot open file for writing: " << filename << "\n";
+        std::cerr << saved.error() << "\n";
         return;
     }
-
-    for (const auto &p_ptr : warehouse.getProducts())
+    if (std::size_t skipped = warehouse.getStore().size() - *saved; skipped > 0)
     {
-        if (const auto *ep = dynamic_cast<const Electronic *>(p_ptr.get()))
-        {
-            file << "Electronic "
-                 << std::quoted(ep->getName()) << " "
-                 << ep->getPrice() << " "
-                 << ep->getQuantity() << " "
-                 << ep->getWeight() << " "
-                 << std::quoted(ep->getWarranty()) << "\n";
-        }
-        else if (const auto *cp = dynamic_cast<const Clothing *>(p_ptr.get()))
-        {
-            file << "Clothing "
-                 << std::quoted(cp->getName()) << " "
-                 << cp->getPrice() << " "
-                 << cp->getQuantity() << " "
-                 << cp->getWeight() << " "
-                 << std::quoted(cp->getSize()) << "\n";
-        }
-        else if (const auto *fp = dynamic_cast<const Food *>(p_ptr.get()))
-        {
-            file << "Food "
-                 << std::quoted(fp->getName()) << " "
-                 << fp->getPrice() << " "
-                 << fp->getQuantity() << " "
-                 << fp->getWeight() << " "
-                 << std::quoted(fp->getExpirationDate()) << "\n";
-        }
-        else
-        {
-            std::cerr << "Unknown product type encountered during save: product ID " << p_ptr->getId() << ". Skipping." << std::endl;
-        }
+        std::cerr << "Skipped " << skipped << " products of unknown type during save." << std::endl;
     }
-
-    file.close();
     std::cout << "Products saved to file: " << filename << "\n";
 }
 
@@ -252,10 +176,11 @@ void saveProductsToFile(const std::string &filename, const Warehouse &warehouse)
  *
  * @param warehouse The Warehouse object to manage products
  * @param orderManager The OrderManager object to manage orders
+ * @param persistence The journal keeping both durable, or nullptr when running without a data directory
  *
  * @note This function uses the standard input/output streams for user interaction.
  */
-void runMenu(Warehouse &warehouse, OrderManager &orderManager)
+void runMenu(Warehouse &warehouse, OrderManager &orderManager, Persistence *persistence)
 {
     bool running = true;
     while (running)
@@ -268,9 +193,21 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
                   << "5. Create new order (random)\n"
                   << "6. Edit order\n"
                   << "7. Delete order\n"
-                  << "8. Process all orders\n"
+                  << "8. Fulfill all open orders from stock\n"
                   << "9. Reduce prices in warehouse (operator())\n"
                   << "10. Display all orders\n"
+                  << "11. Save snapshot (products and orders)\n"
+                  << "12. Load snapshot (replaces products and orders)\n"
+                  << "13. Group products by size, warranty or expiration date\n"
+                  << "14. Show food expiring soon\n"
+                  << "15. Write off expired food\n"
+                  << "16. Show products in a price range\n"
+                  << "17. Show cheapest and most expensive products\n"
+                  << "18. Find products by name (exact or prefix)\n"
+                  << "19. Rename product\n"
+                  << "20. Search products by name (typo-tolerant)\n"
+                  << "21. Filter by type, size/warranty and stock, then reprice or export\n"
+                  << "22. Show order totals summary\n"
                   << "0. Exit\n"
                   << "[?] Your choice: ";
         int choice;
@@ -292,7 +229,13 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
         case 1:
         {
             std::cout << "Warehouse products:\n";
-            warehouse.printProductsInfo(warehouse.getProducts()); // getProducts() returns a vector, implicitly convertible to span
+            warehouse.printProductsInfo(warehouse.getProducts()); // getProducts() returns a span
+            std::cout << "Total stock value: " << warehouse.totalStockValue()
+                      << " (" << warehouse.totalUnits() << " units)\n";
+            auto byType = warehouse.stockValueByType();
+            std::cout << "  Electronic: " << byType[static_cast<std::size_t>(ProductType::Electronic)]
+                      << " | Clothing: " << byType[static_cast<std::size_t>(ProductType::Clothing)]
+                      << " | Food: " << byType[static_cast<std::size_t>(ProductType::Food)] << "\n";
             break;
         }
         case 2:
@@ -324,7 +267,7 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
         case 5:
         {
             Order newOrder;
-            const auto &prods = warehouse.getProducts(); // Use const auto&
+            auto prods = warehouse.getProducts(); // A span over the warehouse's products
             if (prods.empty())
             {
                 std::cout << "Warehouse is empty. No products available for order!\n";
@@ -370,7 +313,7 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
             }
             clearInput(); // Clear newline
 
-            Order &ord = orderManager.getOrder(idx);
+            Order ord = orderManager.getOrder(idx); // Edit a copy, committed through updateOrder below
             std::cout << "Editing order:\n"
                       << ord
                       << "\n--- Available actions ---\n"
@@ -404,6 +347,7 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
                 if (result) // std::expected has value
                 {
                     ord.addItem(**result, q); // **result gives const Product&
+                    orderManager.updateOrder(idx, ord);
                     std::cout << "Added to order.\n";
                 }
                 else
@@ -424,6 +368,7 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
                 }
                 clearInput();
                 ord.removeItem(pid);
+                orderManager.updateOrder(idx, ord);
                 std::cout << "Removed from order.\n";
             }
             else if (subChoice == 3)
@@ -439,6 +384,7 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
                 }
                 clearInput();
                 ord.editItemQuantity(pid, newQty);
+                orderManager.updateOrder(idx, ord);
                 std::cout << "Quantity changed.\n";
             }
             else
@@ -474,7 +420,13 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
         }
         case 8:
         {
-            orderManager.processAllOrders();
+            FulfillmentSummary summary = orderManager.processAllOrders(warehouse);
+            std::cout << "[+] Processed " << summary.ordersProcessed << " orders: "
+                      << summary.fulfilled << " fulfilled, " << summary.partiallyFulfilled
+                      << " partially fulfilled, " << summary.backordered << " backordered.\n"
+                      << "Shipped " << summary.unitsShipped << " units of " << summary.productsShipped
+                      << " products, worth " << summary.shippedValue << "; "
+                      << summary.unitsOutstanding << " units still outstanding.\n";
             break;
         }
         case 9:
@@ -492,48 +444,415 @@ void runMenu(Warehouse &warehouse, OrderManager &orderManager)
             }
             else
             {
-                size_t index = 0;
-                std::for_each(orders.begin(), orders.end(), [&](const Order &o)
-                              {
-                    std::cout << "\n--- Order #" << index++ << " ---\n" << o; // operator<< for order already adds newline
-                    // totalPrice now takes const Warehouse&
-                    double tp = o.totalPrice(warehouse);
-                    std::cout << "Total price: " << tp << "\n"; });
+                // Price all orders in one batch; missing products come back as data
+                OrderPricing pricing = orderManager.priceOrders(warehouse);
+                auto missing = pricing.missing.begin();
+                for (size_t index = 0; index < orders.size(); ++index)
+                {
+                    std::cout << "\n--- Order #" << index << " ---\n" << orders[index]; // operator<< for order already adds newline
+                    for (; missing != pricing.missing.end() && missing->orderIndex == index; ++missing)
+                    {
+                        std::cout << "Warning: product ID " << missing->productId
+                                  << " is no longer in the warehouse and is not priced.\n";
+                    }
+                    std::cout << "Status: " << toString(orderManager.getStatus(index)) << "\n"
+                              << "Total price: " << pricing.totals[index] << "\n";
+                }
+            }
+            break;
+        }
+        case 11:
+        {
+            std::cout << "Enter snapshot file name [e.g. data/warehouse.snap]: ";
+            std::string fname;
+            std::getline(std::cin, fname);
+            if (auto saved = Snapshot::save(fname, warehouse, orderManager); saved)
+            {
+                std::cout << "Snapshot saved to file: " << fname << "\n";
+            }
+            else
+            {
+                std::cerr << saved.error() << "\n";
+            }
+            break;
+        }
+        case 12:
+        {
+            std::cout << "Enter snapshot file name [e.g. data/warehouse.snap]: ";
+            std::string fname;
+            std::getline(std::cin, fname);
+            if (auto loaded = Snapshot::load(fname, warehouse, orderManager); loaded)
+            {
+                std::cout << "Snapshot loaded: " << warehouse.getStore().size() << " products, "
+                          << orderManager.getOrders().size() << " orders.\n";
+                if (persistence)
+                {
+                    // The loaded state replaces everything journaled so far; make it the new base generation
+                    if (auto compacted = persistence->compact(); !compacted)
+                    {
+                        std::cerr << compacted.error() << "\n";
+                    }
+                }
+            }
+            else
+            {
+                std::cerr << loaded.error() << "\n";
+            }
+            break;
+        }
+        case 13:
+        {
+            const std::pair<ProductType, const char *> groupings[] = {{ProductType::Electronic, "Electronic by warranty"},
+                                                                      {ProductType::Clothing, "Clothing by size"},
+                                                                      {ProductType::Food, "Food by expiration date"}};
+            for (const auto &[type, title] : groupings)
+            {
+                std::cout << title << ":\n";
+                for (const AttributeGroup &group : warehouse.groupByAttribute(type))
+                {
+                    std::cout << "  " << std::quoted(group.value.str()) << ": " << group.products << " products, "
+                              << group.units << " units\n";
+                }
+            }
+            break;
+        }
+        case 14:
+        {
+            std::cout << "Show food expiring within how many days? ";
+            int days;
+            std::cin >> days;
+            if (!std::cin.good())
+            {
+                clearInput();
+                std::cerr << "Invalid number of days.\n";
+                break;
+            }
+            clearInput();
+            auto ids = warehouse.expiringBefore(Date::today().addDays(days + 1));
+            if (ids.empty())
+            {
+                std::cout << "No food in stock expires within " << days << " days.\n";
+            }
+            for (int id : ids)
+            {
+                if (auto product = warehouse.findProductById(id))
+                {
+                    (*product)->printInfo();
+                }
+            }
+            break;
+        }
+        case 15:
+        {
+            WriteOffReport report = warehouse.writeOffExpired(Date::today());
+            std::cout << "Written off " << report.units << " units of " << report.products
+                      << " expired products (value " << report.value << ").\n";
+            break;
+        }
+        case 16:
+        {
+            std::cout << "Enter the lowest and highest price (e.g., 50 200): ";
+            std::string lowText, highText;
+            std::cin >> lowText >> highText;
+            clearInput();
+            auto low = Money::parse(lowText);
+            auto high = Money::parse(highText);
+            if (!low || !high)
+            {
+                std::cerr << "Invalid price.\n";
+                break;
+            }
+            auto ids = warehouse.productsInPriceRange(*low, *high);
+            std::cout << ids.size() << " products between " << *low << " and " << *high << ":\n";
+            for (int id : ids)
+            {
+                if (auto product = warehouse.findProductById(id))
+                {
+                    (*product)->printInfo();
+                }
             }
             break;
         }
+        case 17:
+        {
+            std::cout << "How many products? ";
+            int count;
+            std::cin >> count;
+            if (!std::cin.good() || count < 0)
+            {
+                clearInput();
+                std::cerr << "Invalid number of products.\n";
+                break;
+            }
+            clearInput();
+            const std::pair<const char *, std::vector<int>> listings[] = {
+                {"Cheapest", warehouse.cheapestProducts(static_cast<std::size_t>(count))},
+                {"Most expensive", warehouse.mostExpensiveProducts(static_cast<std::size_t>(count))}};
+            for (const auto &[title, ids] : listings)
+            {
+                std::cout << title << ":\n";
+                for (int id : ids)
+                {
+                    if (auto product = warehouse.findProductById(id))
+                    {
+                        (*product)->printInfo();
+                    }
+                }
+            }
+            break;
+        }
+        case 18:
+        {
+            std::cout << "Enter the name or the start of a name: ";
+            std::string query;
+            std::getline(std::cin, query);
+            if (auto exact = warehouse.findProductByName(query))
+            {
+                std::cout << "Exact match:\n";
+                (*exact)->printInfo();
+            }
+            constexpr std::size_t shown = 20;
+            auto ids = warehouse.findProductsByPrefix(query, shown + 1);
+            std::cout << "Names starting with " << std::quoted(query) << ":\n";
+            if (ids.size() > shown)
+            {
+                ids.resize(shown);
+                std::cout << "(showing the first " << shown << ")\n";
+            }
+            for (int id : ids)
+            {
+                if (auto product = warehouse.findProductById(id))
+                {
+                    (*product)->printInfo();
+                }
+            }
+            break;
+        }
+        case 19:
+        {
+            std::cout << "Enter product ID to rename: ";
+            int id;
+            std::cin >> id;
+            if (!std::cin.good())
+            {
+                clearInput();
+                std::cerr << "Invalid product ID.\n";
+                break;
+            }
+            clearInput();
+            std::cout << "Enter the new name: ";
+            std::string newName;
+            std::getline(std::cin, newName);
+            if (warehouse.renameProduct(id, newName))
+                std::cout << "Product " << id << " renamed.\n";
+            else
+                std::cerr << "Product with ID " << id << " not found.\n";
+            break;
+        }
+        case 20:
+        {
+            std::cout << "Enter search text: ";
+            std::string query;
+            std::getline(std::cin, query);
+            auto hits = warehouse.searchProducts(query, 10);
+            if (hits.empty())
+            {
+                std::cout << "No products match " << std::quoted(query) << ".\n";
+                break;
+            }
+            for (const SearchHit &hit : hits)
+            {
+                if (auto product = warehouse.findProductById(hit.id))
+                {
+                    std::cout << "Match " << static_cast<int>(hit.score * 100 + 0.5) << "%:\n";
+                    (*product)->printInfo();
+                }
+            }
+            break;
+        }
+        case 21:
+        {
+            std::cout << "Product type [1 Electronic, 2 Clothing, 3 Food, empty for any]: ";
+            std::string typeText;
+            std::getline(std::cin, typeText);
+            std::cout << "Size or warranty [empty for any]: ";
+            std::string attribute;
+            std::getline(std::cin, attribute);
+            std::cout << "Stock [in, out, empty for any]: ";
+            std::string stock;
+            std::getline(std::cin, stock);
+
+            const ProductType types[] = {ProductType::Electronic, ProductType::Clothing, ProductType::Food};
+            // A value no product has was never interned; look it up without adding it to the pool
+            const std::optional<InternedString> attributeHandle = InternPool::global().find(attribute);
+            Bitmap selection;
+            for (std::size_t t = 0; t < std::size(types) && (attribute.empty() || attributeHandle); ++t)
+            {
+                if (!typeText.empty() && typeText != std::to_string(t + 1))
+                    continue;
+                selection |= attribute.empty() ? warehouse.idsOfType(types[t])
+                                               : warehouse.idsWithAttribute(types[t], *attributeHandle);
+            }
+            if (stock == "in")
+                selection &= warehouse.inStockIds();
+            else if (stock == "out")
+                selection -= warehouse.inStockIds();
+            std::cout << selection.size() << " products match.\n";
+            if (selection.empty())
+                break;
+
+            std::cout << "1. List  2. Change prices by a percentage  3. Export to a catalog file  0. Nothing\n> ";
+            int action = 0;
+            std::cin >> action;
+            if (!std::cin.good())
+            {
+                clearInput();
+                break;
+            }
+            clearInput();
+            if (action == 1)
+            {
+                selection.forEach([&warehouse](std::uint32_t id)
+                                  {
+                    if (auto product = warehouse.findProductById(static_cast<int>(id)))
+                        (*product)->printInfo(); });
+            }
+            else if (action == 2)
+            {
+                std::cout << "Percentage change (e.g. -10 for 10% off): ";
+                double percent;
+                std::cin >> percent;
+                if (!std::cin.good())
+                {
+                    clearInput();
+                    std::cerr << "Invalid percentage.\n";
+                    break;
+                }
+                clearInput();
+                // Below -100% prices would go negative; far above a few thousand percent is a typo
+                constexpr double maxPercent = 5000.0;
+                if (!std::isfinite(percent) || percent <= -100.0 || percent > maxPercent)
+                {
+                    std::cerr << "Percentage must be above -100 and at most " << maxPercent << ".\n";
+                    break;
+                }
+                ProductFilter filter;
+                filter.selection = std::move(selection);
+                std::size_t repriced = warehouse.reprice(PriceAdjustment::multiply(1.0 + percent / 100.0), filter);
+                std::cout << repriced << " products repriced.\n";
+            }
+            else if (action == 3)
+            {
+                std::cout << "Enter file name: ";
+                std::string fname;
+                std::getline(std::cin, fname);
+                if (auto saved = CatalogWriter::saveFile(fname, warehouse, selection))
+                    std::cout << *saved << " products saved to file: " << fname << "\n";
+                else
+                    std::cerr << saved.error() << "\n";
+            }
+            break;
+        }
+        case 22:
+        {
+            // Totals come from the cache in OrderManager, so this stays fast for many orders
+            std::span<const Money> totals = orderManager.orderTotals(warehouse);
+            if (totals.empty())
+            {
+                std::cout << "No orders.\n";
+                break;
+            }
+            Money sum;
+            for (Money total : totals)
+                sum += total;
+            std::vector<size_t> largest(totals.size());
+            std::iota(largest.begin(), largest.end(), size_t{0});
+            const size_t shown = std::min<size_t>(5, largest.size());
+            std::partial_sort(largest.begin(), largest.begin() + shown, largest.end(),
+                              [&totals](size_t a, size_t b)
+                              { return totals[a] > totals[b]; });
+            std::cout << "Orders: " << totals.size() << "\n"
+                      << "Sum of totals: " << sum << "\n"
+                      << "Largest orders:\n";
+            for (size_t i = 0; i < shown; ++i)
+                std::cout << " - Order #" << largest[i] << ": " << totals[largest[i]] << "\n";
+            break;
+        }
         default:
             std::cerr << "Unknown option.\n";
             break;
         }
+
+        if (persistence)
+        {
+            if (auto compacted = persistence->compactIfNeeded(); !compacted)
+            {
+                std::cerr << compacted.error() << "\n";
+            }
+            if (auto error = persistence->takeCompactionError(); !error.empty())
+            {
+                std::cerr << "Background compaction failed: " << error << "\n";
+            }
+        }
     }
 }
 
-int main()
+int main(int argc, char *argv[])
 {
     Warehouse warehouse;
     OrderManager orderManager;
 
-    // Example products
+    // Optional: --data-dir DIR keeps products and orders durable across runs
+    std::unique_ptr<Persistence> persistence;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--data-dir")
+        {
+            auto opened = Persistence::open(argv[i + 1], warehouse, orderManager);
+            if (!opened)
+            {
+                std::cerr << opened.error() << "\n";
+                return 1;
+            }
+            persistence = std::move(*opened);
+            std::cout << "[+] Recovered " << warehouse.getStore().size() << " products and "
+                      << orderManager.getOrders().size() << " orders from " << argv[i + 1] << "\n";
+        }
+        // Optional: --threads N sets how many threads the bulk operations use (1 runs them serially)
+        else if (std::string(argv[i]) == "--threads")
+        {
+            TaskScheduler::global().setThreadCount(static_cast<std::size_t>(std::max(1, std::atoi(argv[i + 1]))));
+        }
+        // Optional: --seed N makes the random orders repeatable
+        else if (std::string(argv[i]) == "--seed")
+        {
+            RandomGenerator::seed(std::strtoull(argv[i + 1], nullptr, 10));
+        }
+    }
+
+    // Example products (only on a fresh start, not when a data directory was recovered)
     // Note: Names with spaces like "Laptop Pro" and warranties like "2 years"
     // will be handled correctly by std::quoted during file I/O.
     // If adding manually via createProductFromUser, user needs to input them as "Laptop Pro", "2 years".
-    warehouse.addProduct(std::make_unique<Electronic>("Laptop Pro", 4500.0, 10, 1.2, "2 years"));
-    warehouse.addProduct(std::make_unique<Clothing>("Jeans", 150.0, 25, 0.4, "M"));
-    warehouse.addProduct(std::make_unique<Food>("Yogurt", 3.5, 100, 0.2, "2024-10-01"));
-    warehouse.addProduct(std::make_unique<Electronic>("Smartphone Alpha", 2100.0, 15, 0.15, "1 year warranty"));
-    warehouse.addProduct(std::make_unique<Clothing>("Silk Scarf", 89.90, 30, 0.05, "One Size"));
-    warehouse.addProduct(std::make_unique<Food>("Imported Cheese", 25.0, 50, 0.25, "2024-12-15"));
+    if (warehouse.getStore().size() == 0 && orderManager.getOrders().empty())
+    {
+        warehouse.addProduct(std::make_unique<Electronic>("Laptop Pro", Money::fromCents(450000), 10, 1.2, "2 years"));
+        warehouse.addProduct(std::make_unique<Clothing>("Jeans", Money::fromCents(15000), 25, 0.4, "M"));
+        warehouse.addProduct(std::make_unique<Food>("Yogurt", Money::fromCents(350), 100, 0.2, "2024-10-01"));
+        warehouse.addProduct(std::make_unique<Electronic>("Smartphone Alpha", Money::fromCents(210000), 15, 0.15, "1 year warranty"));
+        warehouse.addProduct(std::make_unique<Clothing>("Silk Scarf", Money::fromCents(8990), 30, 0.05, "One Size"));
+        warehouse.addProduct(std::make_unique<Food>("Imported Cheese", Money::fromCents(2500), 50, 0.25, "2024-12-15"));
+    }
 
     /**
-     * If we want to sort products by price, we can use:
-     * warehouse.sortByPriceAscending();
-     * std::cout << "\n--- Products sorted by price ---" << std::endl;
-     * warehouse.printProductsInfo(warehouse.getProducts());
+     * If we want to list products by price without reordering the warehouse, we can use:
+     * for (const PriceIndex::Entry &entry : warehouse.priceIndex())
+     *     (*warehouse.findProductById(entry.id))->printInfo();
+     * warehouse.sortByPriceAscending() still reorders the storage itself if that is wanted.
      */
 
     // Start the main menu
-    runMenu(warehouse, orderManager);
+    runMenu(warehouse, orderManager, persistence.get());
 
     std::cout << "[+] Exiting the program..." << std::endl;
     return 0;
@@ -0,0 +1,489 @@
+#include "Bitmap.hpp"
+#include <algorithm>  // For std::lower_bound, std::set_intersection, std::set_union, std::set_difference
+#include <cstring>    // For std::memcpy
+#include <functional> // For std::greater_equal
+#include <iterator>   // For std::back_inserter
+
+namespace
+{
+    bool testBit(const std::vector<std::uint64_t> &words, std::uint16_t low)
+    {
+        return (words[low >> 6] >> (low & 63)) & 1;
+    }
+
+    std::uint32_t countBits(const std::vector<std::uint64_t> &words)
+    {
+        std::uint32_t count = 0;
+        for (std::uint64_t word : words)
+            count += static_cast<std::uint32_t>(std::popcount(word));
+        return count;
+    }
+
+    template <typename T>
+    void putRaw(std::string &out, T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    template <typename T>
+    bool getRaw(std::string_view &in, T &value)
+    {
+        if (in.size() < sizeof(T))
+            return false;
+        std::memcpy(&value, in.data(), sizeof(T));
+        in.remove_prefix(sizeof(T));
+        return true;
+    }
+}
+
+bool Bitmap::Container::contains(std::uint16_t low) const
+{
+    if (dense())
+        return testBit(words, low);
+    return std::binary_search(values.begin(), values.end(), low);
+}
+
+/**
+ * @brief Converts a bitset at or below arrayLimit values to an array, and an array above it to a bitset.
+ */
+void Bitmap::Container::normalize()
+{
+    if (dense() && cardinality <= arrayLimit)
+    {
+        std::vector<std::uint16_t> sparse;
+        sparse.reserve(cardinality);
+        for (std::size_t w = 0; w < wordsPerContainer; ++w)
+        {
+            for (std::uint64_t word = words[w]; word != 0; word &= word - 1)
+                sparse.push_back(static_cast<std::uint16_t>(w * 64 + std::countr_zero(word)));
+        }
+        values = std::move(sparse);
+        words = {};
+    }
+    else if (!dense() && cardinality > arrayLimit)
+    {
+        words.assign(wordsPerContainer, 0);
+        for (std::uint16_t low : values)
+            words[low >> 6] |= std::uint64_t{1} << (low & 63);
+        values = {};
+    }
+}
+
+Bitmap::Container *Bitmap::find(std::uint16_t key)
+{
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container &c, std::uint16_t k) { return c.key < k; });
+    return it != containers_.end() && it->key == key ? &*it : nullptr;
+}
+
+const Bitmap::Container *Bitmap::find(std::uint16_t key) const
+{
+    return const_cast<Bitmap *>(this)->find(key);
+}
+
+/**
+ * @brief Adds a value; adding a value already present does nothing.
+ *
+ * @param value The value to add.
+ */
+void Bitmap::add(std::uint32_t value)
+{
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    const auto low = static_cast<std::uint16_t>(value);
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container &c, std::uint16_t k) { return c.key < k; });
+    if (it == containers_.end() || it->key != key)
+    {
+        Container container;
+        container.key = key;
+        container.cardinality = 1;
+        container.values.push_back(low);
+        containers_.insert(it, std::move(container));
+        return;
+    }
+    if (it->dense())
+    {
+        std::uint64_t &word = it->words[low >> 6];
+        const std::uint64_t bit = std::uint64_t{1} << (low & 63);
+        it->cardinality += (word & bit) == 0;
+        word |= bit;
+        return;
+    }
+    auto pos = std::lower_bound(it->values.begin(), it->values.end(), low);
+    if (pos != it->values.end() && *pos == low)
+        return;
+    it->values.insert(pos, low);
+    ++it->cardinality;
+    it->normalize();
+}
+
+/**
+ * @brief Builds a set from values in strictly ascending order.
+ *
+ * The values of each container are appended as they come and the container
+ * switches to a bitset once, when it is complete.
+ *
+ * @param values The values, without duplicates, in ascending order.
+ * @return Bitmap The set.
+ */
+Bitmap Bitmap::fromSorted(std::span<const std::uint32_t> values)
+{
+    Bitmap bitmap;
+    for (std::size_t i = 0; i < values.size();)
+    {
+        Container container;
+        container.key = static_cast<std::uint16_t>(values[i] >> 16);
+        for (; i < values.size() && values[i] >> 16 == container.key; ++i)
+            container.values.push_back(static_cast<std::uint16_t>(values[i]));
+        container.cardinality = static_cast<std::uint32_t>(container.values.size());
+        container.normalize();
+        bitmap.containers_.push_back(std::move(container));
+    }
+    return bitmap;
+}
+
+/**
+ * @brief Removes a value; removing a value that is not present does nothing.
+ *
+ * @param value The value to remove.
+ */
+void Bitmap::remove(std::uint32_t value)
+{
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    const auto low = static_cast<std::uint16_t>(value);
+    Container *container = find(key);
+    if (!container)
+        return;
+    if (container->dense())
+    {
+        std::uint64_t &word = container->words[low >> 6];
+        const std::uint64_t bit = std::uint64_t{1} << (low & 63);
+        container->cardinality -= (word & bit) != 0;
+        word &= ~bit;
+    }
+    else
+    {
+        auto pos = std::lower_bound(container->values.begin(), container->values.end(), low);
+        if (pos == container->values.end() || *pos != low)
+            return;
+        container->values.erase(pos);
+        --container->cardinality;
+    }
+    if (container->cardinality == 0)
+        containers_.erase(containers_.begin() + (container - containers_.data()));
+    else
+        container->normalize();
+}
+
+bool Bitmap::contains(std::uint32_t value) const
+{
+    const Container *container = find(static_cast<std::uint16_t>(value >> 16));
+    return container && container->contains(static_cast<std::uint16_t>(value));
+}
+
+std::size_t Bitmap::size() const
+{
+    std::size_t count = 0;
+    for (const Container &container : containers_)
+        count += container.cardinality;
+    return count;
+}
+
+/**
+ * @brief Keeps only the values that are also in other.
+ *
+ * Containers whose key is missing from other are dropped without being read.
+ */
+Bitmap &Bitmap::operator&=(const Bitmap &other)
+{
+    std::vector<Container> result;
+    auto theirs = other.containers_.begin();
+    for (Container &mine : containers_)
+    {
+        while (theirs != other.containers_.end() && theirs->key < mine.key)
+            ++theirs;
+        if (theirs == other.containers_.end())
+            break;
+        if (theirs->key != mine.key)
+            continue;
+
+        if (mine.dense() && theirs->dense())
+        {
+            for (std::size_t w = 0; w < wordsPerContainer; ++w)
+                mine.words[w] &= theirs->words[w];
+            mine.cardinality = countBits(mine.words);
+        }
+        else if (mine.dense())
+        {
+            std::vector<std::uint16_t> kept;
+            for (std::uint16_t low : theirs->values)
+            {
+                if (testBit(mine.words, low))
+                    kept.push_back(low);
+            }
+            mine.words = {};
+            mine.values = std::move(kept);
+            mine.cardinality = static_cast<std::uint32_t>(mine.values.size());
+        }
+        else if (theirs->dense())
+        {
+            std::erase_if(mine.values, [&](std::uint16_t low) { return !testBit(theirs->words, low); });
+            mine.cardinality = static_cast<std::uint32_t>(mine.values.size());
+        }
+        else
+        {
+            std::vector<std::uint16_t> kept;
+            std::set_intersection(mine.values.begin(), mine.values.end(), theirs->values.begin(),
+                                  theirs->values.end(), std::back_inserter(kept));
+            mine.values = std::move(kept);
+            mine.cardinality = static_cast<std::uint32_t>(mine.values.size());
+        }
+        if (mine.cardinality > 0)
+        {
+            mine.normalize();
+            result.push_back(std::move(mine));
+        }
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+/**
+ * @brief Adds every value of other.
+ */
+Bitmap &Bitmap::operator|=(const Bitmap &other)
+{
+    std::vector<Container> result;
+    result.reserve(containers_.size() + other.containers_.size());
+    auto mine = containers_.begin();
+    auto theirs = other.containers_.begin();
+    while (mine != containers_.end() || theirs != other.containers_.end())
+    {
+        if (theirs == other.containers_.end() || (mine != containers_.end() && mine->key < theirs->key))
+        {
+            result.push_back(std::move(*mine++));
+            continue;
+        }
+        if (mine == containers_.end() || theirs->key < mine->key)
+        {
+            result.push_back(*theirs++);
+            continue;
+        }
+
+        Container &merged = *mine;
+        if (!merged.dense() && theirs->dense())
+        {
+            std::vector<std::uint64_t> words = theirs->words;
+            for (std::uint16_t low : merged.values)
+                words[low >> 6] |= std::uint64_t{1} << (low & 63);
+            merged.values = {};
+            merged.words = std::move(words);
+            merged.cardinality = countBits(merged.words);
+        }
+        else if (merged.dense() && theirs->dense())
+        {
+            for (std::size_t w = 0; w < wordsPerContainer; ++w)
+                merged.words[w] |= theirs->words[w];
+            merged.cardinality = countBits(merged.words);
+        }
+        else if (merged.dense())
+        {
+            for (std::uint16_t low : theirs->values)
+                merged.words[low >> 6] |= std::uint64_t{1} << (low & 63);
+            merged.cardinality = countBits(merged.words);
+        }
+        else
+        {
+            std::vector<std::uint16_t> united;
+            united.reserve(merged.values.size() + theirs->values.size());
+            std::set_union(merged.values.begin(), merged.values.end(), theirs->values.begin(), theirs->values.end(),
+                           std::back_inserter(united));
+            merged.values = std::move(united);
+            merged.cardinality = static_cast<std::uint32_t>(merged.values.size());
+        }
+        merged.normalize();
+        result.push_back(std::move(merged));
+        ++mine;
+        ++theirs;
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+/**
+ * @brief Removes every value of other.
+ */
+Bitmap &Bitmap::operator-=(const Bitmap &other)
+{
+    std::vector<Container> result;
+    result.reserve(containers_.size());
+    auto theirs = other.containers_.begin();
+    for (Container &mine : containers_)
+    {
+        while (theirs != other.containers_.end() && theirs->key < mine.key)
+            ++theirs;
+        if (theirs == other.containers_.end() || theirs->key != mine.key)
+        {
+            result.push_back(std::move(mine));
+            continue;
+        }
+
+        if (mine.dense() && theirs->dense())
+        {
+            for (std::size_t w = 0; w < wordsPerContainer; ++w)
+                mine.words[w] &= ~theirs->words[w];
+            mine.cardinality = countBits(mine.words);
+        }
+        else if (mine.dense())
+        {
+            for (std::uint16_t low : theirs->values)
+                mine.words[low >> 6] &= ~(std::uint64_t{1} << (low & 63));
+            mine.cardinality = countBits(mine.words);
+        }
+        else if (theirs->dense())
+        {
+            std::erase_if(mine.values, [&](std::uint16_t low) { return testBit(theirs->words, low); });
+            mine.cardinality = static_cast<std::uint32_t>(mine.values.size());
+        }
+        else
+        {
+            std::vector<std::uint16_t> kept;
+            std::set_difference(mine.values.begin(), mine.values.end(), theirs->values.begin(), theirs->values.end(),
+                                std::back_inserter(kept));
+            mine.values = std::move(kept);
+            mine.cardinality = static_cast<std::uint32_t>(mine.values.size());
+        }
+        if (mine.cardinality > 0)
+        {
+            mine.normalize();
+            result.push_back(std::move(mine));
+        }
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+std::vector<int> Bitmap::toVector() const
+{
+    std::vector<int> ids;
+    ids.reserve(size());
+    forEach([&ids](std::uint32_t value) { ids.push_back(static_cast<int>(value)); });
+    return ids;
+}
+
+/**
+ * @brief Clears the mask byte of every ID that is not in the set.
+ *
+ * @param ids The IDs to test.
+ * @param mask One byte per ID, ANDed with its membership.
+ */
+void Bitmap::select(std::span<const int> ids, std::span<std::uint8_t> mask) const
+{
+    const Container *container = nullptr;
+    std::uint32_t currentKey = 0x10000; // No container has this key
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        const auto value = static_cast<std::uint32_t>(ids[i]);
+        const std::uint32_t key = value >> 16;
+        if (key != currentKey)
+        {
+            container = find(static_cast<std::uint16_t>(key));
+            currentKey = key;
+        }
+        mask[i] &= static_cast<std::uint8_t>(container && container->contains(static_cast<std::uint16_t>(value)));
+    }
+}
+
+std::size_t Bitmap::bytes() const
+{
+    std::size_t total = containers_.capacity() * sizeof(Container);
+    for (const Container &container : containers_)
+        total += container.values.capacity() * sizeof(std::uint16_t) + container.words.capacity() * sizeof(std::uint64_t);
+    return total;
+}
+
+/**
+ * @brief Appends a compact binary form of the set to a string.
+ *
+ * Layout: u32 container count, then per container a u16 key and u32
+ * cardinality followed by the sorted u16 values (arrays) or the u64 words
+ * (bitsets), in host byte order like the rest of the journal.
+ *
+ * @param out Receives the bytes.
+ */
+void Bitmap::serialize(std::string &out) const
+{
+    putRaw(out, static_cast<std::uint32_t>(containers_.size()));
+    for (const Container &container : containers_)
+    {
+        putRaw(out, container.key);
+        putRaw(out, container.cardinality);
+        if (container.dense())
+        {
+            for (std::uint64_t word : container.words)
+                putRaw(out, word);
+        }
+        else
+        {
+            for (std::uint16_t low : container.values)
+                putRaw(out, low);
+        }
+    }
+}
+
+/**
+ * @brief Reads a set written by serialize().
+ *
+ * Keys must ascend, array values must ascend and bitset cardinalities must
+ * match their bits, so a damaged record is rejected instead of producing a
+ * set that breaks the container invariants.
+ *
+ * @param data The bytes to read, in full.
+ * @return std::expected<Bitmap, std::string> The set, or an error message.
+ */
+std::expected<Bitmap, std::string> Bitmap::deserialize(std::string_view data)
+{
+    Bitmap bitmap;
+    std::uint32_t count = 0;
+    if (!getRaw(data, count))
+        return std::unexpected("Bitmap data is truncated");
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        Container container;
+        if (!getRaw(data, container.key) || !getRaw(data, container.cardinality))
+            return std::unexpected("Bitmap data is truncated");
+        if (!bitmap.containers_.empty() && container.key <= bitmap.containers_.back().key)
+            return std::unexpected("Bitmap containers are out of order");
+        if (container.cardinality == 0 || container.cardinality > 65536)
+            return std::unexpected("Bitmap container has an invalid size");
+        if (container.cardinality > arrayLimit)
+        {
+            container.words.resize(wordsPerContainer);
+            for (std::uint64_t &word : container.words)
+            {
+                if (!getRaw(data, word))
+                    return std::unexpected("Bitmap data is truncated");
+            }
+            if (countBits(container.words) != container.cardinality)
+                return std::unexpected("Bitmap container size does not match its bits");
+        }
+        else
+        {
+            container.values.resize(container.cardinality);
+            for (std::uint16_t &low : container.values)
+            {
+                if (!getRaw(data, low))
+                    return std::unexpected("Bitmap data is truncated");
+            }
+            if (std::adjacent_find(container.values.begin(), container.values.end(), std::greater_equal<>()) !=
+                container.values.end())
+                return std::unexpected("Bitmap container values are out of order");
+        }
+        bitmap.containers_.push_back(std::move(container));
+    }
+    if (!data.empty())
+        return std::unexpected("Bitmap data has trailing bytes");
+    return bitmap;
+}
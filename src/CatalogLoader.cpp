@@ -0,0 +1,456 @@
+#include "CatalogLoader.hpp"
+#include "Warehouse.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>    // For std::count, std::max
+#include <charconv>     // For std::from_chars
+#include <system_error> // For std::errc
+#include <thread>       // For std::jthread, std::thread::hardware_concurrency
+
+namespace
+{
+    /**
+     * @brief Cursor over catalog text that tokenises one record at a time
+     *
+     * Tokens are read in place: numbers go straight through std::from_chars and
+     * strings are returned as views of the text. Only a quoted string containing
+     * a backslash is copied, unescaped, into the caller's side buffer.
+     */
+    class RecordParser
+    {
+        const char *begin_;
+        const char *pos_;
+        const char *end_;
+        std::size_t line_;
+        std::string scratch_; // Reused while unescaping
+
+        static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+        static bool isSpace(char c) { return isBlank(c) || c == '\n'; }
+
+        bool atTokenEnd() const { return pos_ == end_ || isSpace(*pos_); }
+
+    public:
+        RecordParser(std::string_view text, std::size_t start, std::size_t firstLine)
+            : begin_(text.data()), pos_(text.data() + start), end_(text.data() + text.size()), line_(firstLine) {}
+
+        bool done() const { return pos_ == end_; }
+        std::size_t offset() const { return static_cast<std::size_t>(pos_ - begin_); }
+        std::size_t line() const { return line_; }
+
+        void skipBlanks()
+        {
+            while (pos_ != end_ && isBlank(*pos_))
+                ++pos_;
+        }
+
+        /**
+         * @brief Consumes the newline ending the current line, if there is one
+         * @return true if a newline was consumed
+         */
+        bool consumeNewline()
+        {
+            if (pos_ != end_ && *pos_ == '\n')
+            {
+                ++pos_;
+                ++line_;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Skips the rest of the current line (used after a malformed record)
+         */
+        void skipLine()
+        {
+            while (pos_ != end_ && *pos_ != '\n')
+                ++pos_;
+        }
+
+        /**
+         * @brief Reads a bare word (up to the next whitespace)
+         */
+        std::string_view word()
+        {
+            skipBlanks();
+            const char *start = pos_;
+            while (!atTokenEnd())
+                ++pos_;
+            return {start, static_cast<std::size_t>(pos_ - start)};
+        }
+
+        /**
+         * @brief Reads a string written by std::quoted (or a bare word, as std::quoted accepts on input)
+         * @param out Receives a view of the text, or of its unescaped copy in unescaped
+         * @param unescaped Receives the string if it contains escapes
+         * @return false if the string is missing or its closing quote is not found
+         */
+        bool string(std::string_view &out, StringArena &unescaped)
+        {
+            skipBlanks();
+            if (pos_ == end_ || *pos_ == '\n')
+                return false;
+            if (*pos_ != '"')
+            {
+                out = word();
+                return true;
+            }
+            ++pos_; // Opening quote
+            const char *start = pos_;
+            bool escaped = false;
+            while (pos_ != end_)
+            {
+                char c = *pos_;
+                if (c == '"')
+                {
+                    out = {start, static_cast<std::size_t>(pos_ - start)};
+                    if (escaped)
+                    {
+                        scratch_.clear();
+                        for (const char *p = start; p != pos_; ++p)
+                            scratch_.push_back(*p == '\\' ? *++p : *p);
+                        out = unescaped.store(scratch_);
+                    }
+                    ++pos_; // Closing quote
+                    return atTokenEnd();
+                }
+                if (c == '\\')
+                {
+                    escaped = true;
+                    if (++pos_ == end_)
+                        break;
+                    c = *pos_; // The escaped character is taken literally
+                }
+                if (c == '\n')
+                {
+                    ++line_; // std::quoted writes embedded newlines verbatim
+                }
+                ++pos_;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Reads a number with std::from_chars
+         * @return false if the token is not a complete number
+         */
+        template <typename T>
+        bool number(T &out)
+        {
+            skipBlanks();
+            if (pos_ != end_ && *pos_ == '+')
+                ++pos_; // operator>> accepts an explicit plus sign, from_chars does not
+            auto [next, ec] = std::from_chars(pos_, end_, out);
+            if (ec != std::errc{})
+                return false;
+            pos_ = next;
+            return atTokenEnd();
+        }
+
+        /**
+         * @brief Reads a decimal amount exactly into cents with Money::parse
+         * @return false if the token is not a complete amount
+         */
+        bool money(Money &out)
+        {
+            std::string_view token = word();
+            if (!token.empty() && token.front() == '+')
+                token.remove_prefix(1);
+            auto amount = Money::parse(token);
+            if (!amount)
+                return false;
+            out = *amount;
+            return true;
+        }
+    };
+
+    /**
+     * @brief Maps the type keyword written by saveProductsToFile to its tag
+     */
+    bool parseType(std::string_view keyword, ProductType &type)
+    {
+        if (keyword == "Electronic")
+            type = ProductType::Electronic;
+        else if (keyword == "Clothing")
+            type = ProductType::Clothing;
+        else if (keyword == "Food")
+            type = ProductType::Food;
+        else
+            return false;
+        return true;
+    }
+
+    /**
+     * @brief Parses the fields of one record after its type keyword
+     * @return An empty string on success, otherwise the reason the record is malformed
+     */
+    std::string parseFields(RecordParser &parser, ParsedProduct &row, StringArena &unescaped)
+    {
+        if (!parser.string(row.name, unescaped))
+            return "missing or unterminated product name";
+        if (!parser.money(row.price))
+            return "invalid price";
+        if (!parser.number(row.quantity))
+            return "invalid quantity";
+        if (!parser.number(row.weight))
+            return "invalid weight";
+        if (!parser.string(row.attribute, unescaped))
+            return "missing or unterminated type-specific attribute";
+        parser.skipBlanks();
+        if (!parser.done() && !parser.consumeNewline())
+            return "unexpected data after the last field";
+
+        // Same silent correction the stream operators apply
+        row.price = std::max(row.price, Money());
+        row.quantity = std::max(row.quantity, 0);
+        row.weight = std::max(row.weight, 0.0);
+        return {};
+    }
+
+    /**
+     * @brief Materialises parsed records in order and adds them to the warehouse
+     *
+     * This is the only step that creates Product objects, and it runs on the
+     * calling thread in input order, so IDs come from Product::globalIdCounter_
+     * in exactly the sequence a serial load would produce.
+     */
+    std::size_t insertRows(std::vector<std::vector<ParsedProduct>> &batches, Warehouse &warehouse)
+    {
+        std::size_t total = 0;
+        for (const auto &batch : batches)
+            total += batch.size();
+
+        warehouse.reserve(warehouse.getStore().size() + total);
+        std::string attribute; // Reused, so long attributes do not allocate per row
+        for (auto &batch : batches)
+        {
+            for (const ParsedProduct &row : batch)
+            {
+                attribute.assign(row.attribute);
+                warehouse.createProduct(row.type, row.name, row.price, row.quantity, row.weight, attribute);
+            }
+            batch.clear();
+            batch.shrink_to_fit(); // Release each batch as soon as it is merged
+        }
+        return total;
+    }
+
+    /**
+     * @brief Tells whether a line starts with one of the record type keywords
+     */
+    bool startsRecord(std::string_view line)
+    {
+        for (std::string_view keyword : {"Electronic", "Clothing", "Food"})
+        {
+            if (line.starts_with(keyword) && line.size() > keyword.size() &&
+                (line[keyword.size()] == ' ' || line[keyword.size()] == '\t'))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Guesses where to cut text into roughly equal chunks for parallel parsing
+     *
+     * Each cut is moved forward to the start of the next line that begins with a
+     * type keyword. That is only a guess at a record boundary: a quoted name may
+     * itself contain a newline followed by such a line. loadTextParallel checks
+     * every cut against where the parse of the previous chunk really ended.
+     *
+     * @return std::vector<std::size_t> Offsets of the cuts, starting with 0 and ending with text.size().
+     */
+    std::vector<std::size_t> guessCuts(std::string_view text, std::size_t parts)
+    {
+        std::vector<std::size_t> cuts{0};
+        for (std::size_t k = 1; k < parts; ++k)
+        {
+            std::size_t newline = text.find('\n', std::max(cuts.back(), text.size() / parts * k));
+            while (newline != std::string_view::npos && !startsRecord(text.substr(newline + 1)))
+                newline = text.find('\n', newline + 1);
+            if (newline == std::string_view::npos)
+                break;
+            cuts.push_back(newline + 1);
+        }
+        cuts.push_back(text.size());
+        return cuts;
+    }
+
+    /**
+     * @brief Parses the records of text that start at or after start and before limit
+     *
+     * start must be the beginning of a line. A record that starts before limit
+     * is parsed to its end even if that lies beyond limit, exactly as a parse of
+     * the whole text would.
+     *
+     * @return std::size_t The offset where parsing stopped: the start of the first
+     * line at or after limit that is not part of a parsed record, or text.size().
+     */
+    std::size_t parseRange(std::string_view text, std::size_t start, std::size_t limit, std::size_t firstLine,
+                           std::vector<ParsedProduct> &rows, std::vector<LoadError> &errors, StringArena &unescaped)
+    {
+        RecordParser parser(text, start, firstLine);
+        ParsedProduct row{};
+        while (!parser.done() && parser.offset() < limit)
+        {
+            parser.skipBlanks();
+            if (parser.consumeNewline() || parser.done())
+                continue; // Blank line
+
+            std::size_t recordLine = parser.line();
+            std::string_view keyword = parser.word();
+            std::string problem;
+            if (!parseType(keyword, row.type))
+                problem = "unknown product type '" + std::string(keyword) + "'";
+            else
+                problem = parseFields(parser, row, unescaped);
+
+            if (problem.empty())
+            {
+                rows.push_back(row);
+            }
+            else
+            {
+                errors.push_back({recordLine, std::move(problem)});
+                parser.skipLine();
+                parser.consumeNewline();
+            }
+        }
+        return parser.offset();
+    }
+}
+
+/**
+ * @brief Parses catalog text into product records.
+ *
+ * Blank lines are ignored. A malformed record is reported with the line it
+ * starts on and the parser resumes at the following line.
+ *
+ * @param text The catalog text.
+ * @param firstLine Line number of the first line of text.
+ * @param rows Receives the parsed records in input order.
+ * @param errors Receives one LoadError per rejected line.
+ * @param unescaped Receives the unescaped copies of quoted strings that contained a backslash.
+ */
+void CatalogLoader::parse(std::string_view text, std::size_t firstLine, std::vector<ParsedProduct> &rows,
+                          std::vector<LoadError> &errors, StringArena &unescaped)
+{
+    parseRange(text, 0, text.size(), firstLine, rows, errors, unescaped);
+}
+
+/**
+ * @brief Parses catalog text and adds every valid product to the warehouse.
+ *
+ * The warehouse is reserved once for the number of lines in the text, then
+ * products are inserted in input order.
+ *
+ * @param text The catalog text.
+ * @param warehouse The warehouse to add products to.
+ * @return LoadReport The number of products added and the rejected lines.
+ */
+LoadReport CatalogLoader::loadText(std::string_view text, Warehouse &warehouse)
+{
+    LoadReport report;
+    std::vector<std::vector<ParsedProduct>> batches(1);
+    StringArena unescaped;
+    std::size_t lineCount = static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+    batches[0].reserve(lineCount);
+    parse(text, 1, batches[0], report.errors, unescaped);
+    report.loaded = insertRows(batches, warehouse);
+    return report;
+}
+
+/**
+ * @brief Parses catalog text on several threads and adds the products to the warehouse.
+ *
+ * The text is cut into one chunk per thread at guessed record boundaries. Every
+ * worker parses from its cut, counting lines from 1, and keeps going past the
+ * next cut until the record it is in has ended; it notes where it stopped. The
+ * chunks are then merged in order. A chunk whose cut is exactly where the
+ * previous chunk stopped was parsed from a real record boundary, so its batch
+ * and errors are taken with line numbers shifted by the preceding lines.
+ * Otherwise the cut fell inside a record (e.g. in a quoted name containing a
+ * newline) and the chunk is parsed again on the calling thread from where the
+ * previous one stopped. Products are created during the merge, in input order,
+ * so the warehouse contents, the product IDs and the errors are identical to
+ * those of loadText.
+ *
+ * @param text The catalog text.
+ * @param warehouse The warehouse to add products to.
+ * @param threads Number of worker threads; 0 uses std::thread::hardware_concurrency().
+ * @return LoadReport The number of products added and the rejected lines, in input order.
+ */
+LoadReport CatalogLoader::loadTextParallel(std::string_view text, Warehouse &warehouse, unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads == 1 || text.size() < parallelThreshold)
+        return loadText(text, warehouse);
+
+    std::vector<std::size_t> cuts = guessCuts(text, threads);
+    const std::size_t chunkCount = cuts.size() - 1;
+    std::vector<std::vector<ParsedProduct>> batches(chunkCount);
+    std::vector<std::vector<LoadError>> chunkErrors(chunkCount);
+    std::vector<StringArena> chunkStrings(chunkCount); // Must outlive the batches that point into them
+    std::vector<std::size_t> chunkEnds(chunkCount);
+    std::vector<std::size_t> chunkLines(chunkCount); // Lines from the cut to where the chunk's parse stopped
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(chunkCount);
+        for (std::size_t k = 0; k < chunkCount; ++k)
+        {
+            workers.emplace_back([&, k]
+                                 {
+                auto countLines = [text](std::size_t from, std::size_t to)
+                { return static_cast<std::size_t>(std::count(text.begin() + from, text.begin() + to, '\n')); };
+                chunkLines[k] = countLines(cuts[k], cuts[k + 1]);
+                batches[k].reserve(chunkLines[k] + 1);
+                chunkEnds[k] = parseRange(text, cuts[k], cuts[k + 1], 1, batches[k], chunkErrors[k], chunkStrings[k]);
+                chunkLines[k] += countLines(cuts[k + 1], chunkEnds[k]); });
+        }
+    } // jthreads join here
+
+    LoadReport report;
+    std::size_t position = 0; // Where the merged parse has got to; always the start of a line
+    std::size_t lineOffset = 0; // Lines before position
+    for (std::size_t k = 0; k < chunkCount; ++k)
+    {
+        if (position != cuts[k])
+        {
+            // The cut was not a record boundary: redo the chunk from where the previous one stopped
+            batches[k].clear();
+            chunkErrors[k].clear();
+            chunkEnds[k] = std::max(position, parseRange(text, position, cuts[k + 1], 1, batches[k], chunkErrors[k],
+                                                         chunkStrings[k]));
+            chunkLines[k] = static_cast<std::size_t>(
+                std::count(text.begin() + position, text.begin() + chunkEnds[k], '\n'));
+        }
+        for (LoadError &error : chunkErrors[k])
+        {
+            error.line += lineOffset;
+            report.errors.push_back(std::move(error));
+        }
+        lineOffset += chunkLines[k];
+        position = chunkEnds[k];
+    }
+    report.loaded = insertRows(batches, warehouse);
+    return report;
+}
+
+/**
+ * @brief Memory-maps a catalog file and loads it into the warehouse.
+ *
+ * @param filename The path of the catalog file.
+ * @param warehouse The warehouse to add products to.
+ * @param threads Number of parser threads, as for loadTextParallel.
+ * @return std::expected<LoadReport, std::string> The load report, or an error message
+ * if the file cannot be opened or mapped.
+ */
+std::expected<LoadReport, std::string> CatalogLoader::loadFile(const std::string &filename, Warehouse &warehouse,
+                                                               unsigned threads)
+{
+    auto file = MappedFile::open(filename);
+    if (!file)
+    {
+        return std::unexpected(file.error());
+    }
+    return loadTextParallel(file->view(), warehouse, threads);
+}
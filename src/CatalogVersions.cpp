@@ -0,0 +1,258 @@
+#include "CatalogVersions.hpp"
+#include <algorithm>
+#include <functional> // For std::plus
+#include <limits>
+#include <numeric>    // For std::transform_reduce
+#include <ostream>
+#include <thread>     // For std::this_thread::yield
+#include "Warehouse.hpp"
+
+static_assert(catalogPageSize == Warehouse::changePageSize, "Catalog pages must line up with the warehouse's change pages");
+
+namespace
+{
+    /**
+     * @brief Reader slot a thread tries first, so threads start their search in different places
+     */
+    std::size_t firstReaderSlot()
+    {
+        static std::atomic<std::size_t> nextSlot{0};
+        thread_local const std::size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    std::shared_ptr<const CatalogPricePage> copyPrices(const ProductStore &store, std::size_t begin, std::size_t count,
+                                                       std::uint64_t stamp)
+    {
+        auto page = std::make_shared<CatalogPricePage>();
+        page->stamp = stamp;
+        std::copy_n(store.ids().begin() + begin, count, page->ids.begin());
+        std::copy_n(store.prices().begin() + begin, count, page->prices.begin());
+        std::copy_n(store.quantities().begin() + begin, count, page->quantities.begin());
+        std::copy_n(store.types().begin() + begin, count, page->types.begin());
+        return page;
+    }
+
+    std::shared_ptr<const CatalogDetailPage> copyDetails(const ProductStore &store, std::size_t begin,
+                                                         std::size_t count, std::uint64_t stamp)
+    {
+        auto page = std::make_shared<CatalogDetailPage>();
+        page->stamp = stamp;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            page->names[i] = page->strings.store(store.name(begin + i));
+        }
+        std::copy_n(store.weights().begin() + begin, count, page->weights.begin());
+        std::copy_n(store.attributeHandles().begin() + begin, count, page->attributes.begin());
+        return page;
+    }
+}
+
+/**
+ * @brief Takes over another view, giving this view's version back first.
+ */
+CatalogView &CatalogView::operator=(CatalogView &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        version_ = std::exchange(other.version_, nullptr);
+        pin_ = std::exchange(other.pin_, nullptr);
+    }
+    return *this;
+}
+
+/**
+ * @brief Gives the version back by clearing the reader slot.
+ *
+ * After this the writer may free the version at its next publish.
+ */
+void CatalogView::release()
+{
+    if (pin_)
+    {
+        pin_->store(0, std::memory_order_release);
+    }
+    version_ = nullptr;
+    pin_ = nullptr;
+}
+
+/**
+ * @brief Calculates the value of all stock in this version.
+ *
+ * @return Money The exact sum of price * quantity over every slot.
+ */
+Money CatalogView::totalStockValue() const
+{
+    Money total;
+    for (std::size_t begin = 0; begin < size(); begin += catalogPageSize)
+    {
+        const CatalogPricePage &page = pricePage(begin);
+        const std::size_t count = std::min(catalogPageSize, size() - begin);
+        total += std::transform_reduce(page.prices.begin(), page.prices.begin() + count, page.quantities.begin(),
+                                       Money(), std::plus<>(),
+                                       [](Money price, int quantity) { return price * quantity; });
+    }
+    return total;
+}
+
+/**
+ * @brief Writes one line per product, in the format of the built-in types' printInfo().
+ *
+ * @param os The stream to write to.
+ */
+void CatalogView::print(std::ostream &os) const
+{
+    // Label and attribute caption per ProductType, indexed by the tag value
+    static constexpr const char *labels[productTypeCount] = {"Electronic", "Clothing", "Food", "Product"};
+    static constexpr const char *attributes[productTypeCount] = {"Warranty", "Size", "Expires", nullptr};
+    for (std::size_t slot = 0; slot < size(); ++slot)
+    {
+        const auto type = static_cast<std::size_t>(this->type(slot));
+        os << labels[type] << ": [ID:" << id(slot) << "] " << name(slot) << " | Price: " << price(slot)
+           << " | Qty: " << quantity(slot);
+        if (attributes[type])
+            os << " | Weight: " << weight(slot) << " kg | " << attributes[type] << ": " << attribute(slot);
+        os << "\n";
+    }
+}
+
+/**
+ * @brief Publishes the current state of a warehouse as the first version.
+ *
+ * @param warehouse The warehouse to copy.
+ */
+CatalogVersions::CatalogVersions(const Warehouse &warehouse)
+    : latest_(std::make_unique<CatalogVersion>())
+{
+    current_.store(latest_.get(), std::memory_order_release);
+    publish(warehouse);
+}
+
+/**
+ * @brief Frees every version; no view may still be held.
+ */
+CatalogVersions::~CatalogVersions() = default;
+
+/**
+ * @brief Publishes the current state of a warehouse as a new version.
+ *
+ * Builds the page list of the next version, sharing every page whose change
+ * stamp in the warehouse is still the one its copy was taken at, then swaps
+ * it in. When the warehouse's latest change stamp and size are those of the
+ * current version, nothing changed and no page is looked at. The replaced
+ * version is retired with the epoch that was current when it was replaced:
+ * a reader that pinned a later epoch loaded the version pointer after the
+ * swap, so it cannot be using the replaced version.
+ *
+ * @param warehouse The warehouse to copy.
+ * @return std::uint64_t The number of the version now current.
+ */
+std::uint64_t CatalogVersions::publish(const Warehouse &warehouse)
+{
+    const ProductStore &store = warehouse.getStore();
+    const CatalogVersion &previous = *latest_;
+    if (previous.number != 0 && previous.changeStamp == warehouse.changeStamp() && previous.size == store.size())
+    {
+        reclaim();
+        return previous.number;
+    }
+
+    auto next = std::make_unique<CatalogVersion>();
+    next->size = store.size();
+    next->changeStamp = warehouse.changeStamp();
+    const std::size_t pageCount = (next->size + catalogPageSize - 1) / catalogPageSize;
+    next->pricePages.reserve(pageCount);
+    next->detailPages.reserve(pageCount);
+    std::span<const std::uint64_t> hotStamps = warehouse.hotPageStamps();
+    std::span<const std::uint64_t> coldStamps = warehouse.coldPageStamps();
+
+    bool changed = next->size != previous.size || previous.number == 0;
+    for (std::size_t page = 0; page < pageCount; ++page)
+    {
+        const std::size_t begin = page * catalogPageSize;
+        const std::size_t count = std::min(catalogPageSize, next->size - begin);
+        const bool shared = page < previous.pricePages.size();
+        if (shared && previous.pricePages[page]->stamp == hotStamps[page])
+        {
+            next->pricePages.push_back(previous.pricePages[page]);
+        }
+        else
+        {
+            next->pricePages.push_back(copyPrices(store, begin, count, hotStamps[page]));
+            changed = true;
+        }
+        if (shared && previous.detailPages[page]->stamp == coldStamps[page])
+        {
+            next->detailPages.push_back(previous.detailPages[page]);
+        }
+        else
+        {
+            next->detailPages.push_back(copyDetails(store, begin, count, coldStamps[page]));
+            changed = true;
+        }
+    }
+    if (!changed)
+    {
+        reclaim();
+        return previous.number;
+    }
+
+    next->number = previous.number + 1;
+    current_.store(next.get(), std::memory_order_seq_cst);
+    currentNumber_.store(next->number, std::memory_order_release);
+    const std::uint64_t retiredAt = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    retired_.emplace_back(retiredAt, std::move(latest_));
+    latest_ = std::move(next);
+    reclaim();
+    return latest_->number;
+}
+
+/**
+ * @brief Gets a view of the current version.
+ *
+ * Claims a free reader slot by storing the current epoch in it, then loads
+ * the version pointer. Both are sequentially consistent, so either the
+ * writer's scan in reclaim() sees the pin, or this load sees any version
+ * swapped in before that scan.
+ *
+ * @return CatalogView The view; it pins its version until released.
+ */
+CatalogView CatalogVersions::acquire()
+{
+    const std::size_t first = firstReaderSlot();
+    for (std::size_t attempt = 0;; ++attempt)
+    {
+        ReaderSlot &slot = readers_[(first + attempt) % readerSlots];
+        std::uint64_t free = 0;
+        const std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+        if (slot.pinnedEpoch.compare_exchange_strong(free, epoch, std::memory_order_seq_cst))
+        {
+            return CatalogView(current_.load(std::memory_order_seq_cst), &slot.pinnedEpoch);
+        }
+        if (attempt % readerSlots == readerSlots - 1)
+        {
+            std::this_thread::yield(); // Every slot is busy; wait for a reader to finish
+        }
+    }
+}
+
+/**
+ * @brief Frees the retired versions that no pinned reader can still see.
+ *
+ * A version retired at epoch r may be in use by readers that pinned an epoch
+ * up to r, so it is freed once every pinned epoch is above r.
+ */
+void CatalogVersions::reclaim()
+{
+    std::uint64_t oldestPinned = std::numeric_limits<std::uint64_t>::max();
+    for (const ReaderSlot &slot : readers_)
+    {
+        const std::uint64_t pinned = slot.pinnedEpoch.load(std::memory_order_seq_cst);
+        if (pinned != 0)
+            oldestPinned = std::min(oldestPinned, pinned);
+    }
+    auto stillVisible = std::find_if(retired_.begin(), retired_.end(),
+                                     [oldestPinned](const auto &retired) { return retired.first >= oldestPinned; });
+    retired_.erase(retired_.begin(), stillVisible);
+}
@@ -0,0 +1,215 @@
+#include "CatalogWriter.hpp"
+#include "Warehouse.hpp"
+#include "ProductStore.hpp"
+#include "CatalogVersions.hpp"
+#include <charconv> // For std::to_chars
+#include <fstream>
+#include <span>
+#include <string_view>
+
+namespace
+{
+    /**
+     * @brief Record keyword per ProductType, indexed by the tag value
+     */
+    constexpr std::string_view typeKeywords[productTypeCount] = {"Electronic", "Clothing", "Food", ""};
+
+    /**
+     * @brief Flush the output buffer to the file once it grows past this size
+     */
+    constexpr std::size_t flushBytes = 1 << 20;
+
+    /**
+     * @brief Appends a string in the form std::quoted writes it: in double quotes, with " and \ escaped
+     */
+    void appendQuoted(std::string &out, std::string_view text)
+    {
+        out.push_back('"');
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                out.push_back('\\');
+            out.push_back(c);
+        }
+        out.push_back('"');
+    }
+
+    template <typename T>
+    void appendNumber(std::string &out, T value)
+    {
+        char buffer[32];
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, end);
+    }
+
+    /**
+     * @brief Appends an amount with exactly two fraction digits, so prices round-trip to the cent
+     */
+    void appendNumber(std::string &out, Money value)
+    {
+        char buffer[32];
+        auto [end, ec] = value.toChars(buffer, buffer + sizeof(buffer));
+        out.append(buffer, end);
+    }
+
+    /**
+     * @brief Reads the slots of a ProductStore through the per-slot accessors CatalogView has
+     */
+    struct StoreSlots
+    {
+        const ProductStore &store;
+
+        std::size_t size() const { return store.size(); }
+        ProductType type(std::size_t slot) const { return store.types()[slot]; }
+        std::string_view name(std::size_t slot) const { return store.name(slot); }
+        Money price(std::size_t slot) const { return store.prices()[slot]; }
+        int quantity(std::size_t slot) const { return store.quantities()[slot]; }
+        double weight(std::size_t slot) const { return store.weights()[slot]; }
+        InternedString attribute(std::size_t slot) const { return store.attributeHandles()[slot]; }
+    };
+
+    /**
+     * @brief Formats one slot of a StoreSlots or a CatalogView as a catalog line
+     * @return false if the slot's type has no text representation
+     */
+    template <typename Slots>
+    bool appendRecord(const Slots &slots, std::size_t slot, std::string &out)
+    {
+        std::string_view keyword = typeKeywords[static_cast<std::size_t>(slots.type(slot))];
+        if (keyword.empty())
+            return false;
+        out.append(keyword);
+        out.push_back(' ');
+        appendQuoted(out, slots.name(slot));
+        out.push_back(' ');
+        appendNumber(out, slots.price(slot));
+        out.push_back(' ');
+        appendNumber(out, slots.quantity(slot));
+        out.push_back(' ');
+        appendNumber(out, slots.weight(slot));
+        out.push_back(' ');
+        appendQuoted(out, slots.attribute(slot).str());
+        out.push_back('\n');
+        return true;
+    }
+
+    template <typename Slots>
+    std::size_t appendSlots(const Slots &slots, std::string &out)
+    {
+        std::size_t written = 0;
+        for (std::size_t slot = 0; slot < slots.size(); ++slot)
+        {
+            written += appendRecord(slots, slot, out);
+        }
+        return written;
+    }
+
+    /**
+     * @brief Writes the slots whose mask byte is set (every slot if the mask is empty) to a catalog file
+     * Lines are buffered and written out in blocks of about 1 MiB, so memory use stays bounded.
+     */
+    template <typename Slots>
+    std::expected<std::size_t, std::string> writeSlots(const std::string &filename, const Slots &slots,
+                                                       std::span<const std::uint8_t> mask)
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return std::unexpected("Cannot open file for writing: " + filename);
+        }
+
+        std::string buffer;
+        buffer.reserve(flushBytes + 4096);
+        std::size_t written = 0;
+        for (std::size_t slot = 0; slot < slots.size(); ++slot)
+        {
+            if (!mask.empty() && !mask[slot])
+                continue;
+            written += appendRecord(slots, slot, buffer);
+            if (buffer.size() >= flushBytes)
+            {
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        }
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.close();
+        if (!file)
+        {
+            return std::unexpected("Error while writing file: " + filename);
+        }
+        return written;
+    }
+}
+
+/**
+ * @brief Appends one catalog line per product to a string.
+ *
+ * @param store The products to format.
+ * @param out Receives the catalog text.
+ * @return std::size_t The number of products written.
+ */
+std::size_t CatalogWriter::appendText(const ProductStore &store, std::string &out)
+{
+    return appendSlots(StoreSlots{store}, out);
+}
+
+/**
+ * @brief Appends one catalog line per product of a catalog version to a string.
+ *
+ * @param view The version to format.
+ * @param out Receives the catalog text.
+ * @return std::size_t The number of products written.
+ */
+std::size_t CatalogWriter::appendText(const CatalogView &view, std::string &out)
+{
+    return appendSlots(view, out);
+}
+
+/**
+ * @brief Writes every product of the warehouse to a catalog file.
+ *
+ * @param filename The path of the catalog file.
+ * @param warehouse The warehouse whose products are written.
+ * @return std::expected<std::size_t, std::string> The number of products written, or an error message.
+ */
+std::expected<std::size_t, std::string> CatalogWriter::saveFile(const std::string &filename,
+                                                                const Warehouse &warehouse)
+{
+    return writeSlots(filename, StoreSlots{warehouse.getStore()}, {});
+}
+
+/**
+ * @brief Writes every product of a catalog version to a catalog file.
+ *
+ * Reads only the view's immutable pages, so it can run on a reader thread
+ * while the warehouse keeps changing.
+ *
+ * @param filename The path of the catalog file.
+ * @param view The version whose products are written.
+ * @return std::expected<std::size_t, std::string> The number of products written, or an error message.
+ */
+std::expected<std::size_t, std::string> CatalogWriter::saveFile(const std::string &filename, const CatalogView &view)
+{
+    return writeSlots(filename, view, {});
+}
+
+/**
+ * @brief Writes the selected products of the warehouse to a catalog file.
+ *
+ * The selection is turned into a slot mask in one pass over the ID column,
+ * so the products are written in storage order like saveFile does.
+ *
+ * @param filename The path of the catalog file.
+ * @param warehouse The warehouse whose products are written.
+ * @param selection The IDs of the products to write.
+ * @return std::expected<std::size_t, std::string> The number of products written, or an error message.
+ */
+std::expected<std::size_t, std::string> CatalogWriter::saveFile(const std::string &filename,
+                                                                const Warehouse &warehouse, const Bitmap &selection)
+{
+    const ProductStore &store = warehouse.getStore();
+    std::vector<std::uint8_t> mask(store.size(), 1);
+    selection.select(store.ids(), mask);
+    return writeSlots(filename, StoreSlots{store}, mask);
+}
@@ -10,9 +10,9 @@
  * @param weight The weight of the clothing item.
  * @param size The size of the clothing item (e.g., "S", "M", "L", "XL").
  */
-Clothing::Clothing(const std::string& name, double price, int quantity,
+Clothing::Clothing(const std::string& name, Money price, int quantity,
                    double weight, const std::string& size)
-    : TangibleProduct(name, price, quantity, weight),
+    : TangibleProduct(name, price, quantity, weight, ProductType::Clothing),
       size_(size)
 {}
 
@@ -46,6 +46,8 @@ void Clothing::printInfo() const {
 std::istream &operator>>(std::istream &is, Clothing &c)
 {
   is >> static_cast<TangibleProduct &>(c); // Reads Product (name, price, qty using std::quoted for name) and TangibleProduct (weight)
-  is >> std::quoted(c.size_);              // Read size, using std::quoted for robustness
+  std::string size;
+  if (is >> std::quoted(size))             // Read size, using std::quoted for robustness
+    c.size_ = InternedString(size);        // Stored as a handle into the intern pool
   return is;
 }
\ No newline at end of file
@@ -0,0 +1,454 @@
+#include "ConcurrentWarehouse.hpp"
+#include <algorithm>
+#include <bit>         // For std::bit_width, std::bit_ceil
+#include <thread>      // For std::this_thread::yield
+#include <type_traits>
+#include <utility>     // For std::as_const
+#include "Order.hpp"
+#include "ProductVisit.hpp"
+#include "SmallVector.hpp"
+#include "Warehouse.hpp"
+
+/**
+ * @brief Gets the display name of a reservation error.
+ *
+ * @param error The error to name.
+ * @return const char* A lower-case description.
+ */
+const char *toString(ReservationError error)
+{
+    switch (error)
+    {
+    case ReservationError::InvalidQuantity:   return "invalid quantity";
+    case ReservationError::UnknownProduct:    return "unknown product";
+    case ReservationError::InsufficientStock: return "insufficient stock";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Creates an entry holding a copy of a product's fields.
+ */
+ConcurrentWarehouse::Entry::Entry(int id, ProductType type, std::string_view name, Money price, int quantity,
+                                  double weight, InternedString attribute)
+    : priceCents(price.cents()), quantity(quantity), id(id), type(type), weight(weight), attribute(attribute),
+      name(name)
+{
+}
+
+/**
+ * @brief Creates an empty hash table.
+ *
+ * @param capacity The number of slots, a power of two.
+ */
+ConcurrentWarehouse::Table::Table(std::size_t capacity)
+    : mask(capacity - 1), shift(65 - static_cast<unsigned>(std::bit_width(capacity))),
+      slots(std::make_unique<Slot[]>(capacity))
+{
+}
+
+/**
+ * @brief Gets the slot where probing for a product ID starts.
+ *
+ * A multiplicative (Fibonacci) hash: the top bits of id * 2^64 / phi. The
+ * shard already took the low bits of the ID, so those alone would put every
+ * ID of the shard in a fraction of the slots.
+ *
+ * @param id A non-negative product ID.
+ * @return std::size_t The first slot to probe.
+ */
+std::size_t ConcurrentWarehouse::Table::home(int id) const
+{
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(id) * 0x9E3779B97F4A7C15ull) >> shift) & mask;
+}
+
+/**
+ * @brief Creates an empty warehouse.
+ *
+ * @param shardCount The number of shards, rounded up to a power of two (at least 1).
+ */
+ConcurrentWarehouse::ConcurrentWarehouse(std::size_t shardCount)
+    : shards_(std::make_unique<Shard[]>(std::bit_ceil(std::max<std::size_t>(shardCount, 1)))),
+      shardMask_(std::bit_ceil(std::max<std::size_t>(shardCount, 1)) - 1)
+{
+}
+
+/**
+ * @brief Creates a warehouse holding a copy of every product of a Warehouse.
+ *
+ * Reads the columns of the source directly, so no Product objects are touched.
+ *
+ * @param source The warehouse to copy.
+ * @param shardCount The number of shards, rounded up to a power of two.
+ */
+ConcurrentWarehouse::ConcurrentWarehouse(const Warehouse &source, std::size_t shardCount)
+    : ConcurrentWarehouse(shardCount)
+{
+    const ProductStore &store = source.getStore();
+    for (std::size_t slot = 0; slot < store.size(); ++slot)
+    {
+        insert(store.ids()[slot], store.types()[slot], store.name(slot), store.prices()[slot],
+               store.quantities()[slot], store.weights()[slot], store.attributeHandles()[slot]);
+    }
+}
+
+/**
+ * @brief Finds the entry of a product without taking any lock.
+ *
+ * Probes the shard's current table from the ID's home slot until it finds
+ * the ID or an empty slot; the table is never more than half full, so the
+ * probe ends.
+ *
+ * @param id The product ID.
+ * @return const Entry* The entry, or nullptr if no product has this ID.
+ */
+const ConcurrentWarehouse::Entry *ConcurrentWarehouse::locate(int id) const
+{
+    if (id < 0)
+        return nullptr;
+    const Table *table = shardOf(id).table.load(std::memory_order_acquire);
+    if (!table)
+        return nullptr;
+    for (std::size_t i = table->home(id);; i = (i + 1) & table->mask)
+    {
+        const int slotId = table->slots[i].id.load(std::memory_order_acquire);
+        if (slotId == id)
+            return table->slots[i].entry.load(std::memory_order_acquire);
+        if (slotId == emptyId)
+            return nullptr;
+    }
+}
+
+ConcurrentWarehouse::Entry *ConcurrentWarehouse::locate(int id)
+{
+    return const_cast<Entry *>(std::as_const(*this).locate(id));
+}
+
+/**
+ * @brief Gets the slot of a product ID in its shard's table, claiming an empty one if the ID has none.
+ *
+ * Called with the shard's mutex held. A claim that would fill more than half
+ * the table first moves the live entries into a new table of four times their
+ * number, which also drops the IDs of removed products; the new table is
+ * filled before it is published, so readers see either the old or the
+ * complete new one.
+ *
+ * @param shard The shard of the ID, locked by the caller.
+ * @param id A non-negative product ID.
+ * @return Slot* The slot; its entry is null if the product is not present.
+ */
+ConcurrentWarehouse::Slot *ConcurrentWarehouse::claimSlot(Shard &shard, int id)
+{
+    const Table *table = shard.table.load(std::memory_order_relaxed);
+    if (table)
+    {
+        std::size_t i = table->home(id);
+        for (int slotId; (slotId = table->slots[i].id.load(std::memory_order_relaxed)) != emptyId;
+             i = (i + 1) & table->mask)
+        {
+            if (slotId == id)
+                return &table->slots[i];
+        }
+        if ((shard.usedSlots + 1) * 2 <= table->mask + 1)
+        {
+            ++shard.usedSlots;
+            table->slots[i].id.store(id, std::memory_order_release);
+            return &table->slots[i];
+        }
+    }
+
+    std::size_t live = 1;
+    for (std::size_t i = 0; table && i <= table->mask; ++i)
+        live += table->slots[i].entry.load(std::memory_order_relaxed) != nullptr;
+    auto grown = std::make_unique<Table>(std::max(firstTableSize, std::bit_ceil(live * 4)));
+    for (std::size_t i = 0; table && i <= table->mask; ++i)
+    {
+        if (Entry *entry = table->slots[i].entry.load(std::memory_order_relaxed))
+        {
+            std::size_t j = grown->home(entry->id);
+            while (grown->slots[j].id.load(std::memory_order_relaxed) != emptyId)
+                j = (j + 1) & grown->mask;
+            grown->slots[j].id.store(entry->id, std::memory_order_relaxed);
+            grown->slots[j].entry.store(entry, std::memory_order_relaxed);
+        }
+    }
+    std::size_t j = grown->home(id);
+    while (grown->slots[j].id.load(std::memory_order_relaxed) != emptyId)
+        j = (j + 1) & grown->mask;
+    grown->slots[j].id.store(id, std::memory_order_relaxed);
+    shard.usedSlots = live;
+    shard.table.store(grown.get(), std::memory_order_release);
+    shard.tables.push_back(std::move(grown));
+    return &shard.tables.back()->slots[j];
+}
+
+/**
+ * @brief Adds an entry under its shard's mutex and publishes it in the directory.
+ *
+ * @return bool false if the ID is negative or already present.
+ */
+bool ConcurrentWarehouse::insert(int id, ProductType type, std::string_view name, Money price, int quantity,
+                                 double weight, InternedString attribute)
+{
+    if (id < 0)
+        return false;
+    Shard &shard = shardOf(id);
+    std::lock_guard lock(shard.mutex);
+    Slot *slot = claimSlot(shard, id);
+    if (slot->entry.load(std::memory_order_relaxed))
+        return false;
+    Entry &entry = shard.entries.emplace_back(id, type, name, std::max(price, Money()), std::max(quantity, 0),
+                                              weight, attribute);
+    slot->entry.store(&entry, std::memory_order_release);
+    size_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Adds a copy of a product's fields.
+ *
+ * @param product The product to copy.
+ * @return bool false if a product with the same ID is already present.
+ */
+bool ConcurrentWarehouse::addProduct(const Product &product)
+{
+    double weight = 0.0;
+    InternedString attribute;
+    visitProduct(product, [&](const auto &concrete)
+                 {
+        using Concrete = std::decay_t<decltype(concrete)>;
+        if constexpr (std::is_base_of_v<TangibleProduct, Concrete>)
+            weight = concrete.getWeight();
+        if constexpr (std::is_same_v<Concrete, Electronic>)
+            attribute = concrete.getWarrantyHandle();
+        else if constexpr (std::is_same_v<Concrete, Clothing>)
+            attribute = concrete.getSizeHandle();
+        else if constexpr (std::is_same_v<Concrete, Food>)
+            attribute = concrete.getExpirationDateHandle(); });
+    return insert(product.getId(), product.getType(), product.getName(), product.getPrice(), product.getQuantity(),
+                  weight, attribute);
+}
+
+/**
+ * @brief Removes a product.
+ *
+ * The entry is unlinked from the table, whose slot keeps the ID until the
+ * table is rebuilt; the entry's memory stays with the shard.
+ *
+ * @param productId The product to remove.
+ * @return bool false if no product has this ID.
+ */
+bool ConcurrentWarehouse::removeProduct(int productId)
+{
+    if (productId < 0)
+        return false;
+    Shard &shard = shardOf(productId);
+    std::lock_guard lock(shard.mutex);
+    if (!locate(productId))
+        return false;
+    claimSlot(shard, productId)->entry.store(nullptr, std::memory_order_release);
+    size_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Reads the price and quantity of a product as one consistent pair.
+ *
+ * The seqlock version is read before and after the fields; if it was odd (a
+ * price change in progress) or changed in between, the read is retried.
+ * Quantity changes do not touch the version: they are single atomic updates,
+ * and the price cannot have changed during a read that is not retried.
+ *
+ * @param productId The product to read.
+ * @return std::optional<StockReading> The reading, or std::nullopt if no product has this ID.
+ */
+std::optional<StockReading> ConcurrentWarehouse::read(int productId) const
+{
+    ++accessCount_;
+    const Entry *entry = locate(productId);
+    if (!entry)
+        return std::nullopt;
+    for (;;)
+    {
+        const std::uint32_t before = entry->version.load(std::memory_order_acquire);
+        if (before & 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const std::int64_t cents = entry->priceCents.load(std::memory_order_relaxed);
+        const int quantity = entry->quantity.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry->version.load(std::memory_order_relaxed) == before)
+            return StockReading{productId, Money::fromCents(cents), quantity};
+    }
+}
+
+/**
+ * @brief Gets the name of a product.
+ *
+ * @param productId The product to look up.
+ * @return std::optional<std::string_view> The name, or std::nullopt if no product has this ID.
+ */
+std::optional<std::string_view> ConcurrentWarehouse::name(int productId) const
+{
+    ++accessCount_;
+    const Entry *entry = locate(productId);
+    if (!entry)
+        return std::nullopt;
+    return std::string_view(entry->name);
+}
+
+/**
+ * @brief Sets the price of a product.
+ *
+ * Takes the entry's seqlock (moving the version from even to odd), stores the
+ * price and releases the seqlock with the next even version. Concurrent price
+ * changes of the same product wait for each other; nothing else does.
+ *
+ * @param productId The product to reprice.
+ * @param price The new price; negative prices become 0.
+ * @return bool false if no product has this ID.
+ */
+bool ConcurrentWarehouse::setPrice(int productId, Money price)
+{
+    Entry *entry = locate(productId);
+    if (!entry)
+        return false;
+    std::uint32_t version = entry->version.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        if (version & 1)
+        {
+            std::this_thread::yield();
+            version = entry->version.load(std::memory_order_relaxed);
+        }
+        else if (entry->version.compare_exchange_weak(version, version + 1, std::memory_order_acquire,
+                                                      std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release); // Readers that see the new price also see the odd version
+    entry->priceCents.store(std::max(price, Money()).cents(), std::memory_order_relaxed);
+    entry->version.store(version + 2, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Adjusts the quantity of a product.
+ *
+ * @param productId The product to update.
+ * @param delta The change in quantity; a result below zero becomes 0.
+ * @return bool false if no product has this ID.
+ */
+bool ConcurrentWarehouse::updateQuantity(int productId, int delta)
+{
+    Entry *entry = locate(productId);
+    if (!entry)
+        return false;
+    int current = entry->quantity.load(std::memory_order_relaxed);
+    while (!entry->quantity.compare_exchange_weak(current, std::max(current + delta, 0), std::memory_order_relaxed))
+    {
+    }
+    return true;
+}
+
+/**
+ * @brief Takes units out of an entry's stock if enough are available.
+ *
+ * The compare-and-swap retries only while other threads change the same
+ * quantity; each retry re-checks the stock against the requested units.
+ *
+ * @param entry The product's entry, or nullptr if it was not found.
+ * @param productId The product ID, for the failure report.
+ * @param quantity The number of units, at least 1.
+ * @return std::expected<void, ReservationFailure> Nothing on success, or why the reservation was refused.
+ */
+std::expected<void, ReservationFailure> ConcurrentWarehouse::take(Entry *entry, int productId, int quantity)
+{
+    if (quantity <= 0)
+        return std::unexpected(ReservationFailure{ReservationError::InvalidQuantity, productId, quantity, 0});
+    if (!entry)
+        return std::unexpected(ReservationFailure{ReservationError::UnknownProduct, productId, quantity, 0});
+    int available = entry->quantity.load(std::memory_order_relaxed);
+    do
+    {
+        if (available < quantity)
+            return std::unexpected(
+                ReservationFailure{ReservationError::InsufficientStock, productId, quantity, available});
+    } while (!entry->quantity.compare_exchange_weak(available, available - quantity, std::memory_order_relaxed));
+    return {};
+}
+
+/**
+ * @brief Takes units out of a product's stock if enough are available.
+ *
+ * @param productId The product to reserve.
+ * @param quantity The number of units, at least 1.
+ * @return std::expected<void, ReservationFailure> Nothing on success, or why the reservation was refused.
+ */
+std::expected<void, ReservationFailure> ConcurrentWarehouse::reserveStock(int productId, int quantity)
+{
+    return take(locate(productId), productId, quantity);
+}
+
+/**
+ * @brief Reserves every line of an order, or none of them.
+ *
+ * The entries reserved so far are remembered (inline for orders of up to
+ * Order::inlineItems lines), so a failure puts their units back without
+ * looking the products up again.
+ *
+ * @param order The order whose lines to reserve.
+ * @return std::expected<void, ReservationFailure> Nothing on success, or the first line's failure.
+ */
+std::expected<void, ReservationFailure> ConcurrentWarehouse::reserveStock(const Order &order)
+{
+    SmallVector<Entry *, Order::inlineItems> reserved;
+    reserved.reserve(order.itemCount());
+    for (const auto &[productId, quantity] : order.getItems())
+    {
+        Entry *entry = locate(productId);
+        auto result = take(entry, productId, quantity);
+        if (!result)
+        {
+            for (std::size_t line = 0; line < reserved.size(); ++line)
+            {
+                reserved[line]->quantity.fetch_add(order.getItems()[line].quantity, std::memory_order_relaxed);
+            }
+            return result;
+        }
+        reserved.push_back(entry);
+    }
+    return {};
+}
+
+/**
+ * @brief Puts reserved units back into a product's stock.
+ *
+ * @param productId The product the units were reserved from.
+ * @param quantity The number of units to return.
+ * @return bool false if no product has this ID or the quantity is not positive.
+ */
+bool ConcurrentWarehouse::releaseStock(int productId, int quantity)
+{
+    Entry *entry = quantity > 0 ? locate(productId) : nullptr;
+    if (!entry)
+        return false;
+    entry->quantity.fetch_add(quantity, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Puts back the units of every line of an order.
+ *
+ * @param order An order previously reserved with reserveStock().
+ */
+void ConcurrentWarehouse::releaseStock(const Order &order)
+{
+    for (const auto &[productId, quantity] : order.getItems())
+    {
+        releaseStock(productId, quantity);
+    }
+}
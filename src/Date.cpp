@@ -0,0 +1,64 @@
+#include "Date.hpp"
+#include <charconv> // For std::from_chars
+#include <chrono>
+#include <cstdio>   // For std::snprintf
+
+/**
+ * @brief Parses a date written as YYYY-MM-DD.
+ *
+ * The fields are read with std::from_chars and the result is checked against
+ * the calendar (month lengths and leap years) through std::chrono.
+ *
+ * @param text The text to parse.
+ * @return std::optional<Date> The date, or std::nullopt if the text is not a valid calendar date.
+ */
+std::optional<Date> Date::parse(std::string_view text)
+{
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-')
+    {
+        return std::nullopt;
+    }
+    auto field = [text](std::size_t pos, std::size_t length, int &value)
+    {
+        const char *first = text.data() + pos;
+        auto [ptr, ec] = std::from_chars(first, first + length, value);
+        return ec == std::errc() && ptr == first + length;
+    };
+    int year, month, day;
+    if (!field(0, 4, year) || !field(5, 2, month) || !field(8, 2, day))
+    {
+        return std::nullopt;
+    }
+    std::chrono::year_month_day date{std::chrono::year(year), std::chrono::month(static_cast<unsigned>(month)),
+                                     std::chrono::day(static_cast<unsigned>(day))};
+    if (!date.ok())
+    {
+        return std::nullopt;
+    }
+    return Date(std::chrono::sys_days(date).time_since_epoch().count());
+}
+
+/**
+ * @brief Gets the current date in UTC.
+ *
+ * @return Date Today.
+ */
+Date Date::today()
+{
+    auto now = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now());
+    return Date(static_cast<std::int32_t>(now.time_since_epoch().count()));
+}
+
+/**
+ * @brief Formats the date as YYYY-MM-DD.
+ *
+ * @return std::string The formatted date.
+ */
+std::string Date::toString() const
+{
+    std::chrono::year_month_day date{std::chrono::sys_days(std::chrono::days(days_))};
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", static_cast<int>(date.year()),
+                  static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()));
+    return buffer;
+}
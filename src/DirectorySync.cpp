@@ -0,0 +1,34 @@
+#include "DirectorySync.hpp"
+
+#if __has_include(<unistd.h>)
+#define DIRECTORY_SYNC_POSIX 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Flushes a directory's entries to stable storage.
+ *
+ * @param directory The directory to flush; an empty path means the current directory.
+ * @return std::expected<void, std::string> Nothing on success, or an error message.
+ */
+std::expected<void, std::string> syncDirectory(const std::filesystem::path &directory)
+{
+#ifdef DIRECTORY_SYNC_POSIX
+    const std::string path = directory.empty() ? std::string(".") : directory.string();
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0)
+    {
+        return std::unexpected("Cannot open directory: " + path);
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!synced)
+    {
+        return std::unexpected("Cannot flush directory to disk: " + path);
+    }
+#else
+    (void)directory;
+#endif
+    return {};
+}
@@ -10,9 +10,9 @@
  * @param weight The weight of the electronic item.
  * @param warranty The warranty period of the electronic item (e.g., "2 years").
  */
-Electronic::Electronic(const std::string& name, double price, int quantity,
+Electronic::Electronic(const std::string& name, Money price, int quantity,
                        double weight, const std::string& warranty)
-    : TangibleProduct(name, price, quantity, weight),
+    : TangibleProduct(name, price, quantity, weight, ProductType::Electronic),
       warranty_(warranty)
 {}
 
@@ -42,6 +42,8 @@ void Electronic::printInfo() const {
 std::istream &operator>>(std::istream &is, Electronic &e)
 {
   is >> static_cast<TangibleProduct &>(e); // Reads Product (name, price, qty using std::quoted for name) and TangibleProduct (weight)
-  is >> std::quoted(e.warranty_);          // Read warranty, using std::quoted for robustness
+  std::string warranty;
+  if (is >> std::quoted(warranty))         // Read warranty period, using std::quoted for robustness
+    e.warranty_ = InternedString(warranty); // Stored as a handle into the intern pool
   return is;
 }
\ No newline at end of file
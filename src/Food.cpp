@@ -10,10 +10,11 @@
  * @param weight The weight of the food item.
  * @param expirationDate The expiration date of the food item (e.g., "2025-12-31").
  */
-Food::Food(const std::string& name, double price, int quantity,
+Food::Food(const std::string& name, Money price, int quantity,
            double weight, const std::string& expirationDate)
-    : TangibleProduct(name, price, quantity, weight),
-      expirationDate_(expirationDate)
+    : TangibleProduct(name, price, quantity, weight, ProductType::Food),
+      expirationDate_(expirationDate),
+      expiry_(Date::parse(expirationDate).value_or(noExpiry))
 {}
 
 /**
@@ -42,6 +43,11 @@ void Food::printInfo() const {
 std::istream &operator>>(std::istream &is, Food &f)
 {
   is >> static_cast<TangibleProduct &>(f); // Reads Product (name, price, qty using std::quoted for name) and TangibleProduct (weight)
-  is >> std::quoted(f.expirationDate_);    // Read expirationDate, using std::quoted for robustness
+  std::string expirationDate;
+  if (is >> std::quoted(expirationDate))   // Read expiration date, using std::quoted for robustness
+  {
+    f.expirationDate_ = InternedString(expirationDate); // Stored as a handle into the intern pool
+    f.expiry_ = Date::parse(expirationDate).value_or(Food::noExpiry);
+  }
   return is;
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "InternPool.hpp"
+#include <bit>     // For std::bit_width
+#include <mutex>   // For std::unique_lock
+#include <ostream>
+
+namespace
+{
+    /**
+     * @brief Splits a handle into its chunk number and the index within that chunk
+     *
+     * Chunk k holds firstChunkSize * 2^k strings and starts at handle
+     * firstChunkSize * (2^k - 1).
+     */
+    struct ChunkPosition
+    {
+        std::size_t chunk;
+        std::size_t offset;
+    };
+
+    ChunkPosition locate(std::uint32_t handle, std::size_t firstChunkSize)
+    {
+        std::size_t scaled = handle / firstChunkSize + 1;
+        std::size_t chunk = static_cast<std::size_t>(std::bit_width(scaled)) - 1;
+        std::size_t start = firstChunkSize * ((std::size_t{1} << chunk) - 1);
+        return {chunk, handle - start};
+    }
+}
+
+/**
+ * @brief Creates the pool with the empty string as handle 0.
+ */
+InternPool::InternPool()
+{
+    intern(std::string_view());
+}
+
+/**
+ * @brief Gets the pool shared by the whole process.
+ *
+ * The pool is intentionally never destroyed, so products destroyed during
+ * static destruction can still resolve their strings.
+ *
+ * @return InternPool& The global pool.
+ */
+InternPool &InternPool::global()
+{
+    static InternPool *pool = new InternPool();
+    return *pool;
+}
+
+/**
+ * @brief Gets the handle of a string, adding the string if it is new.
+ *
+ * @param text The string to intern.
+ * @return std::uint32_t Its handle.
+ */
+std::uint32_t InternPool::intern(std::string_view text)
+{
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = index_.find(text); it != index_.end())
+        {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(mutex_);
+    if (auto it = index_.find(text); it != index_.end())
+    {
+        return it->second; // Interned by another thread in the meantime
+    }
+    const std::uint32_t handle = size_.load(std::memory_order_relaxed);
+    auto [chunk, offset] = locate(handle, firstChunkSize);
+    std::string *strings = chunks_[chunk].load(std::memory_order_relaxed);
+    if (!strings)
+    {
+        strings = new std::string[firstChunkSize << chunk];
+        chunks_[chunk].store(strings, std::memory_order_release);
+    }
+    strings[offset].assign(text);
+    index_.emplace(strings[offset], handle);
+    bytes_ += text.size();
+    size_.store(handle + 1, std::memory_order_release);
+    return handle;
+}
+
+/**
+ * @brief Looks up a string without adding it.
+ *
+ * @param text The string to look up.
+ * @return std::optional<InternedString> Its interned string, or std::nullopt if it was never interned.
+ */
+std::optional<InternedString> InternPool::find(std::string_view text) const
+{
+    std::shared_lock lock(mutex_);
+    if (auto it = index_.find(text); it != index_.end())
+    {
+        return InternedString::fromHandle(it->second);
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Gets the string behind a handle.
+ *
+ * @param handle A handle returned by intern().
+ * @return const std::string& The interned string, valid for the life of the process.
+ */
+const std::string &InternPool::resolve(std::uint32_t handle) const
+{
+    auto [chunk, offset] = locate(handle, firstChunkSize);
+    return chunks_[chunk].load(std::memory_order_acquire)[offset];
+}
+
+/**
+ * @brief Gets the total length of all distinct strings in the pool.
+ *
+ * @return std::size_t The number of characters stored.
+ */
+std::size_t InternPool::bytes() const
+{
+    std::shared_lock lock(mutex_);
+    return bytes_;
+}
+
+/**
+ * @brief Writes the text of an interned string to a stream.
+ *
+ * @param os The output stream.
+ * @param value The interned string.
+ * @return std::ostream& The output stream.
+ */
+std::ostream &operator<<(std::ostream &os, InternedString value)
+{
+    return os << value.str();
+}
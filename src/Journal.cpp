@@ -0,0 +1,654 @@
+#include "Journal.hpp"
+#include "Warehouse.hpp"
+#include "OrderManager.hpp"
+#include "MappedFile.hpp"
+#include "ProductStore.hpp"
+#include "Repricing.hpp"
+#include <algorithm> // For std::max
+#include <cstring>   // For std::memcpy
+#include <filesystem>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h> // For fsync
+#define JOURNAL_HAS_FSYNC 1
+#endif
+
+namespace
+{
+    enum class RecordKind : std::uint8_t
+    {
+        ProductAdded = 1,
+        ProductRemoved,
+        PriceSet,
+        QuantitySet,
+        Repriced,
+        SortedByPrice,
+        OrderCreated,
+        OrderUpdated,
+        OrderRemoved,
+        ProductRenamed,
+        OrdersFulfilled,     // Every order's status; no longer written, still replayed
+        OrderStatusesChanged // The (index, status) pairs a fulfillment run changed
+    };
+
+    constexpr std::size_t frameHeaderSize = sizeof(std::uint32_t) * 2 + sizeof(std::uint8_t);
+
+    // File header: magic followed by a u32 format version. Version 1 was the
+    // headerless format with floating-point prices; version 2 stores prices,
+    // adjustment amounts and filter bounds as i64 cents.
+    constexpr char fileMagic[4] = {'S', 'I', 'J', 'L'};
+    constexpr std::uint32_t fileVersion = 2;
+    constexpr std::size_t fileHeaderSize = sizeof(fileMagic) + sizeof(fileVersion);
+
+    /**
+     * @brief FNV-1a hash over the record kind and payload, used to detect torn records
+     */
+    std::uint32_t checksum(std::uint8_t kind, const char *payload, std::size_t size)
+    {
+        std::uint32_t hash = 2166136261u;
+        auto mix = [&hash](std::uint8_t byte)
+        {
+            hash ^= byte;
+            hash *= 16777619u;
+        };
+        mix(kind);
+        for (std::size_t i = 0; i < size; ++i)
+            mix(static_cast<std::uint8_t>(payload[i]));
+        return hash;
+    }
+
+    /**
+     * @brief Appends fixed-size values and length-prefixed strings to a payload
+     */
+    class PayloadWriter
+    {
+        std::vector<char> bytes_;
+
+    public:
+        // Room for a typical record, so that most payloads are built in one allocation
+        PayloadWriter() { bytes_.reserve(64); }
+
+        template <typename T>
+        PayloadWriter &put(T value)
+        {
+            const std::size_t at = bytes_.size();
+            bytes_.resize(at + sizeof(T));
+            std::memcpy(bytes_.data() + at, &value, sizeof(T));
+            return *this;
+        }
+
+        PayloadWriter &put(const std::string &value)
+        {
+            return put(std::string_view(value));
+        }
+
+        PayloadWriter &put(std::string_view value)
+        {
+            put(static_cast<std::uint32_t>(value.size()));
+            bytes_.insert(bytes_.end(), value.begin(), value.end());
+            return *this;
+        }
+
+        PayloadWriter &putItems(const Order &order)
+        {
+            put(static_cast<std::uint32_t>(order.itemCount()));
+            for (const auto &[productId, quantity] : order.getItems())
+                put<std::int32_t>(productId).put<std::int32_t>(quantity);
+            return *this;
+        }
+
+        const std::vector<char> &bytes() const { return bytes_; }
+    };
+
+    /**
+     * @brief Reads values back from a payload; any read past the end marks the reader as failed
+     */
+    class PayloadReader
+    {
+        const char *pos_;
+        const char *end_;
+        bool ok_ = true;
+
+    public:
+        PayloadReader(const char *data, std::size_t size) : pos_(data), end_(data + size) {}
+
+        bool ok() const { return ok_; }
+
+        template <typename T>
+        T get()
+        {
+            T value{};
+            if (static_cast<std::size_t>(end_ - pos_) < sizeof(T))
+            {
+                ok_ = false;
+                return value;
+            }
+            std::memcpy(&value, pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return value;
+        }
+
+        std::string getString()
+        {
+            auto length = get<std::uint32_t>();
+            if (!ok_ || static_cast<std::size_t>(end_ - pos_) < length)
+            {
+                ok_ = false;
+                return {};
+            }
+            std::string value(pos_, length);
+            pos_ += length;
+            return value;
+        }
+
+        Order getItems()
+        {
+            Order order;
+            auto count = get<std::uint32_t>();
+            for (std::uint32_t i = 0; i < count && ok_; ++i)
+            {
+                auto productId = get<std::int32_t>();
+                auto quantity = get<std::int32_t>();
+                if (ok_)
+                    order.addItem(productId, quantity);
+            }
+            return order;
+        }
+    };
+
+    /**
+     * @brief Applies one decoded record to the warehouse and order manager
+     * @return false if the payload does not match its record kind
+     */
+    bool apply(RecordKind kind, PayloadReader &in, Warehouse &warehouse, OrderManager &orderManager, int &nextId)
+    {
+        switch (kind)
+        {
+        case RecordKind::ProductAdded:
+        {
+            auto id = in.get<std::int32_t>();
+            auto type = static_cast<ProductType>(in.get<std::uint8_t>());
+            auto price = Money::fromCents(in.get<std::int64_t>());
+            auto quantity = in.get<std::int32_t>();
+            auto weight = in.get<double>();
+            auto name = in.getString();
+            auto attribute = in.getString();
+            if (!in.ok())
+                return false;
+            Product::setNextId(id); // Re-create the product under its original ID
+            warehouse.createProduct(type, name, price, quantity, weight, attribute);
+            nextId = std::max(nextId, id + 1);
+            return true;
+        }
+        case RecordKind::ProductRemoved:
+        {
+            auto id = in.get<std::int32_t>();
+            if (in.ok())
+                warehouse.removeProduct(id);
+            return in.ok();
+        }
+        case RecordKind::ProductRenamed:
+        {
+            auto id = in.get<std::int32_t>();
+            auto name = in.getString();
+            if (in.ok())
+                warehouse.renameProduct(id, name);
+            return in.ok();
+        }
+        case RecordKind::PriceSet:
+        {
+            auto id = in.get<std::int32_t>();
+            auto price = Money::fromCents(in.get<std::int64_t>());
+            if (in.ok())
+                warehouse.setPrice(id, price);
+            return in.ok();
+        }
+        case RecordKind::QuantitySet:
+        {
+            auto id = in.get<std::int32_t>();
+            auto quantity = in.get<std::int32_t>();
+            if (!in.ok())
+                return false;
+            if (auto product = warehouse.findProductById(id))
+                warehouse.updateQuantity(id, quantity - (*product)->getQuantity());
+            return true;
+        }
+        case RecordKind::Repriced:
+        {
+            std::vector<PriceAdjustment> steps(in.get<std::uint32_t>());
+            for (PriceAdjustment &step : steps)
+            {
+                step.kind = static_cast<PriceAdjustment::Kind>(in.get<std::uint8_t>());
+                step.a = in.get<std::int64_t>();
+                step.b = in.get<std::int64_t>();
+            }
+            ProductFilter filter;
+            auto flags = in.get<std::uint8_t>();
+            auto type = static_cast<ProductType>(in.get<std::uint8_t>());
+            auto minPrice = Money::fromCents(in.get<std::int64_t>());
+            auto maxPrice = Money::fromCents(in.get<std::int64_t>());
+            if (flags & 1)
+                filter.type = type;
+            if (flags & 2)
+                filter.minPrice = minPrice;
+            if (flags & 4)
+                filter.maxPrice = maxPrice;
+            filter.ids.resize(in.get<std::uint32_t>());
+            for (int &id : filter.ids)
+                id = in.get<std::int32_t>();
+            if (flags & 8)
+            {
+                auto selection = Bitmap::deserialize(in.getString());
+                if (!selection)
+                    return false;
+                filter.selection = std::move(*selection);
+            }
+            if (in.ok())
+                warehouse.reprice(steps, filter);
+            return in.ok();
+        }
+        case RecordKind::SortedByPrice:
+            warehouse.sortByPriceAscending();
+            return true;
+        case RecordKind::OrderCreated:
+        {
+            Order order = in.getItems();
+            if (in.ok())
+                orderManager.createOrder(order);
+            return in.ok();
+        }
+        case RecordKind::OrderUpdated:
+        {
+            auto index = in.get<std::uint64_t>();
+            Order order = in.getItems();
+            if (in.ok())
+                orderManager.updateOrder(static_cast<std::size_t>(index), order);
+            return in.ok();
+        }
+        case RecordKind::OrderRemoved:
+        {
+            auto index = in.get<std::uint64_t>();
+            if (in.ok())
+                orderManager.removeOrder(static_cast<std::size_t>(index));
+            return in.ok();
+        }
+        case RecordKind::OrdersFulfilled:
+        {
+            auto bytes = in.getString();
+            if (!in.ok() || std::any_of(bytes.begin(), bytes.end(), [](char status)
+                                        { return static_cast<std::uint8_t>(status) >
+                                                 static_cast<std::uint8_t>(OrderStatus::Backordered); }))
+                return false;
+            std::vector<OrderStatus> statuses(bytes.size());
+            std::memcpy(statuses.data(), bytes.data(), bytes.size());
+            return orderManager.setStatuses(statuses);
+        }
+        case RecordKind::OrderStatusesChanged:
+        {
+            auto count = in.get<std::uint32_t>();
+            for (std::uint32_t i = 0; i < count && in.ok(); ++i)
+            {
+                auto index = in.get<std::uint64_t>();
+                auto status = in.get<std::uint8_t>();
+                if (!in.ok() || status > static_cast<std::uint8_t>(OrderStatus::Backordered) ||
+                    !orderManager.setStatus(static_cast<std::size_t>(index), static_cast<OrderStatus>(status)))
+                    return false;
+            }
+            return in.ok();
+        }
+        }
+        return false; // Unknown record kind
+    }
+}
+
+/**
+ * @brief Creates the journal around an open file and starts the flusher thread.
+ */
+Journal::Journal(std::FILE *file, std::string path, JournalOptions options, std::uint64_t existingBytes)
+    : file_(file), path_(std::move(path)), options_(options),
+      appendedBytes_(existingBytes), durableBytes_(existingBytes),
+      flusher_([this] { flushLoop(); })
+{
+}
+
+/**
+ * @brief Opens (or creates) a journal file for appending.
+ *
+ * A new (empty) file gets the format header before any record is appended.
+ *
+ * @param path The journal file.
+ * @param options Group commit settings.
+ * @return std::expected<std::unique_ptr<Journal>, std::string> The journal, or an error message.
+ */
+std::expected<std::unique_ptr<Journal>, std::string> Journal::open(const std::string &path, JournalOptions options)
+{
+    std::FILE *file = std::fopen(path.c_str(), "ab");
+    if (!file)
+    {
+        return std::unexpected("Cannot open journal for appending: " + path);
+    }
+    std::error_code ec;
+    std::uint64_t existing = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+        existing = 0;
+    }
+    if (existing == 0)
+    {
+        char header[fileHeaderSize];
+        std::memcpy(header, fileMagic, sizeof(fileMagic));
+        std::memcpy(header + sizeof(fileMagic), &fileVersion, sizeof(fileVersion));
+        if (std::fwrite(header, 1, sizeof(header), file) != sizeof(header) || std::fflush(file) != 0)
+        {
+            std::fclose(file);
+            return std::unexpected("Cannot write journal header: " + path);
+        }
+        existing = sizeof(header);
+    }
+    return std::unique_ptr<Journal>(new Journal(file, path, options, existing));
+}
+
+/**
+ * @brief Stops the flusher after it has written everything still pending, then closes the file.
+ */
+Journal::~Journal()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (flusher_.joinable())
+    {
+        flusher_.join();
+    }
+    std::fclose(file_);
+}
+
+/**
+ * @brief Frames a record and queues it for the next group commit.
+ *
+ * @param kind The record kind.
+ * @param payload The encoded record body.
+ */
+void Journal::append(std::uint8_t kind, const std::vector<char> &payload)
+{
+    const auto length = static_cast<std::uint32_t>(payload.size());
+    const std::uint32_t sum = checksum(kind, payload.data(), payload.size());
+    char frame[frameHeaderSize];
+    std::memcpy(frame, &length, sizeof(length));
+    std::memcpy(frame + sizeof(length), &sum, sizeof(sum));
+    frame[sizeof(length) + sizeof(sum)] = static_cast<char>(kind);
+
+    bool full;
+    {
+        std::lock_guard lock(mutex_);
+        pending_.insert(pending_.end(), frame, frame + frameHeaderSize);
+        pending_.insert(pending_.end(), payload.begin(), payload.end());
+        appendedBytes_ += frameHeaderSize + payload.size();
+        full = pending_.size() >= options_.commitBytes;
+    }
+    if (full)
+    {
+        wake_.notify_one();
+    }
+}
+
+/**
+ * @brief Body of the flusher thread: writes and syncs pending records in groups.
+ *
+ * The thread wakes up after each commit interval, when the buffer is full, when
+ * sync() asks for it or when the journal shuts down. Everything buffered at that
+ * moment is written with a single write and a single fsync.
+ */
+void Journal::flushLoop()
+{
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        wake_.wait_for(lock, options_.commitInterval, [this]
+                       { return stopping_ || syncRequested_ || pending_.size() >= options_.commitBytes; });
+        syncRequested_ = false;
+        if (!pending_.empty())
+        {
+            std::vector<char> group;
+            group.swap(pending_);
+            const std::uint64_t groupEnd = appendedBytes_;
+            lock.unlock();
+
+            bool written = std::fwrite(group.data(), 1, group.size(), file_) == group.size() &&
+                           std::fflush(file_) == 0;
+#ifdef JOURNAL_HAS_FSYNC
+            written = written && ::fsync(::fileno(file_)) == 0;
+#endif
+
+            lock.lock();
+            if (!written && writeError_.empty())
+            {
+                writeError_ = "Error while writing journal: " + path_;
+            }
+            durableBytes_ = groupEnd;
+        }
+        durable_.notify_all();
+        if (stopping_ && pending_.empty())
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Blocks until every record appended so far is durable on disk.
+ *
+ * @return std::expected<void, std::string> Nothing on success, or the write error.
+ */
+std::expected<void, std::string> Journal::sync()
+{
+    std::unique_lock lock(mutex_);
+    const std::uint64_t target = appendedBytes_;
+    syncRequested_ = true;
+    wake_.notify_one();
+    durable_.wait(lock, [this, target] { return durableBytes_ >= target; });
+    if (!writeError_.empty())
+    {
+        return std::unexpected(writeError_);
+    }
+    return {};
+}
+
+/**
+ * @brief Gets the journal size including records that are not written yet.
+ *
+ * @return std::uint64_t The size in bytes.
+ */
+std::uint64_t Journal::size()
+{
+    std::lock_guard lock(mutex_);
+    return appendedBytes_;
+}
+
+/**
+ * @brief Applies every intact record of a journal file, in order.
+ *
+ * Replay stops at the first record whose frame is incomplete, whose checksum
+ * does not match or whose payload cannot be decoded; such a tail is what a
+ * crash in the middle of a group commit leaves behind. Files without the
+ * format header or written by another format version are rejected.
+ *
+ * @param path The journal file to replay.
+ * @param warehouse The warehouse to apply product records to.
+ * @param orderManager The order manager to apply order records to.
+ * @return std::expected<ReplayReport, std::string> What was replayed, or an error message.
+ */
+std::expected<ReplayReport, std::string> Journal::replay(const std::string &path, Warehouse &warehouse,
+                                                         OrderManager &orderManager)
+{
+    auto file = MappedFile::open(path);
+    if (!file)
+    {
+        return std::unexpected(file.error());
+    }
+
+    ReplayReport report;
+    int nextId = Product::peekNextId();
+    std::string_view bytes = file->view();
+    if (bytes.size() < fileHeaderSize)
+    {
+        // Empty, or the header itself was torn: nothing was ever recorded
+        report.truncatedTail = !bytes.empty();
+        return report;
+    }
+    std::uint32_t version;
+    std::memcpy(&version, bytes.data() + sizeof(fileMagic), sizeof(version));
+    if (bytes.substr(0, sizeof(fileMagic)) != std::string_view(fileMagic, sizeof(fileMagic)))
+    {
+        return std::unexpected("Not a journal file (or a journal from before format version 2): " + path);
+    }
+    if (version != fileVersion)
+    {
+        return std::unexpected("Unsupported journal format version " + std::to_string(version) + ": " + path);
+    }
+    std::size_t pos = fileHeaderSize;
+    while (pos < bytes.size())
+    {
+        std::uint32_t length, sum;
+        if (bytes.size() - pos < frameHeaderSize)
+        {
+            report.truncatedTail = true;
+            break;
+        }
+        std::memcpy(&length, bytes.data() + pos, sizeof(length));
+        std::memcpy(&sum, bytes.data() + pos + sizeof(length), sizeof(sum));
+        auto kind = static_cast<std::uint8_t>(bytes[pos + sizeof(length) + sizeof(sum)]);
+        const char *payload = bytes.data() + pos + frameHeaderSize;
+        if (bytes.size() - pos - frameHeaderSize < length || checksum(kind, payload, length) != sum)
+        {
+            report.truncatedTail = true;
+            break;
+        }
+
+        PayloadReader in(payload, length);
+        if (!apply(static_cast<RecordKind>(kind), in, warehouse, orderManager, nextId))
+        {
+            report.truncatedTail = true;
+            break;
+        }
+        ++report.records;
+        pos += frameHeaderSize + length;
+    }
+    Product::setNextId(std::max(nextId, Product::peekNextId()));
+    return report;
+}
+
+void Journal::productAdded(const ProductStore &store, std::size_t slot)
+{
+    PayloadWriter out;
+    out.put<std::int32_t>(store.ids()[slot])
+        .put(static_cast<std::uint8_t>(store.types()[slot]))
+        .put(store.prices()[slot].cents())
+        .put<std::int32_t>(store.quantities()[slot])
+        .put(store.weights()[slot])
+        .put(store.name(slot))
+        .put(store.attribute(slot));
+    append(static_cast<std::uint8_t>(RecordKind::ProductAdded), out.bytes());
+}
+
+void Journal::productRemoved(int id)
+{
+    PayloadWriter out;
+    out.put<std::int32_t>(id);
+    append(static_cast<std::uint8_t>(RecordKind::ProductRemoved), out.bytes());
+}
+
+void Journal::productRenamed(int id, std::string_view name)
+{
+    PayloadWriter out;
+    out.put<std::int32_t>(id).put(name);
+    append(static_cast<std::uint8_t>(RecordKind::ProductRenamed), out.bytes());
+}
+
+void Journal::priceSet(int id, Money price)
+{
+    PayloadWriter out;
+    out.put<std::int32_t>(id).put(price.cents());
+    append(static_cast<std::uint8_t>(RecordKind::PriceSet), out.bytes());
+}
+
+void Journal::quantitySet(int id, int quantity)
+{
+    PayloadWriter out;
+    out.put<std::int32_t>(id).put<std::int32_t>(quantity);
+    append(static_cast<std::uint8_t>(RecordKind::QuantitySet), out.bytes());
+}
+
+/**
+ * @brief Records a bulk repricing as the operation itself, not one price per product.
+ *
+ * Replaying the same steps with the same filter on the same state reproduces
+ * the same prices, so the record size depends only on the request.
+ */
+void Journal::repriced(std::span<const PriceAdjustment> steps, const ProductFilter &filter)
+{
+    PayloadWriter out;
+    out.put(static_cast<std::uint32_t>(steps.size()));
+    for (const PriceAdjustment &step : steps)
+    {
+        out.put(static_cast<std::uint8_t>(step.kind)).put(step.a).put(step.b);
+    }
+    std::uint8_t flags = (filter.type ? 1 : 0) | (filter.minPrice ? 2 : 0) | (filter.maxPrice ? 4 : 0) |
+                         (filter.selection ? 8 : 0);
+    out.put(flags)
+        .put(static_cast<std::uint8_t>(filter.type.value_or(ProductType::Other)))
+        .put(filter.minPrice.value_or(Money()).cents())
+        .put(filter.maxPrice.value_or(Money()).cents())
+        .put(static_cast<std::uint32_t>(filter.ids.size()));
+    for (int id : filter.ids)
+    {
+        out.put<std::int32_t>(id);
+    }
+    if (filter.selection)
+    {
+        std::string selection;
+        filter.selection->serialize(selection);
+        out.put(std::string_view(selection));
+    }
+    append(static_cast<std::uint8_t>(RecordKind::Repriced), out.bytes());
+}
+
+void Journal::sortedByPrice()
+{
+    append(static_cast<std::uint8_t>(RecordKind::SortedByPrice), {});
+}
+
+void Journal::orderCreated(const Order &order)
+{
+    PayloadWriter out;
+    out.putItems(order);
+    append(static_cast<std::uint8_t>(RecordKind::OrderCreated), out.bytes());
+}
+
+void Journal::orderUpdated(std::size_t index, const Order &order)
+{
+    PayloadWriter out;
+    out.put(static_cast<std::uint64_t>(index)).putItems(order);
+    append(static_cast<std::uint8_t>(RecordKind::OrderUpdated), out.bytes());
+}
+
+void Journal::orderRemoved(std::size_t index)
+{
+    PayloadWriter out;
+    out.put(static_cast<std::uint64_t>(index));
+    append(static_cast<std::uint8_t>(RecordKind::OrderRemoved), out.bytes());
+}
+
+/**
+ * @brief Records the orders whose status a fulfillment run changed, so the record grows with the changes, not the orders.
+ */
+void Journal::ordersFulfilled(std::span<const OrderStatusChange> changes)
+{
+    PayloadWriter out;
+    out.put(static_cast<std::uint32_t>(changes.size()));
+    for (const OrderStatusChange &change : changes)
+        out.put(change.index).put(static_cast<std::uint8_t>(change.status));
+    append(static_cast<std::uint8_t>(RecordKind::OrderStatusesChanged), out.bytes());
+}
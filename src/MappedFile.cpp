@@ -0,0 +1,124 @@
+#include "MappedFile.hpp"
+#include <utility> // For std::exchange
+
+#if __has_include(<sys/mman.h>)
+#define MAPPEDFILE_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring> // For std::strerror
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+/**
+ * @brief Maps a file for reading.
+ *
+ * An empty file yields an empty view without creating a mapping.
+ *
+ * @param path The path of the file to map.
+ * @return std::expected<MappedFile, std::string> The mapped file, or an error message.
+ */
+std::expected<MappedFile, std::string> MappedFile::open(const std::string &path)
+{
+    MappedFile file;
+#ifdef MAPPEDFILE_USE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return std::unexpected("Unable to open file: " + path + " (" + std::strerror(errno) + ")");
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+        std::string reason = std::strerror(errno);
+        ::close(fd);
+        return std::unexpected("Unable to stat file: " + path + " (" + reason + ")");
+    }
+    file.size_ = static_cast<std::size_t>(info.st_size);
+    if (file.size_ > 0)
+    {
+        void *address = ::mmap(nullptr, file.size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            std::string reason = std::strerror(errno);
+            ::close(fd);
+            return std::unexpected("Unable to map file: " + path + " (" + reason + ")");
+        }
+        ::madvise(address, file.size_, MADV_SEQUENTIAL); // Parsers scan front to back
+        file.data_ = static_cast<const char *>(address);
+        file.mapped_ = true;
+    }
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+    {
+        return std::unexpected("Unable to open file: " + path);
+    }
+    file.buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    file.data_ = file.buffer_.data();
+    file.size_ = file.buffer_.size();
+#endif
+    return file;
+}
+
+/**
+ * @brief Releases the mapping (or the fallback buffer).
+ */
+void MappedFile::release() noexcept
+{
+#ifdef MAPPEDFILE_USE_MMAP
+    if (mapped_)
+    {
+        ::munmap(const_cast<char *>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+/**
+ * @brief Move constructor; the source is left empty.
+ */
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapped_(std::exchange(other.mapped_, false)),
+      buffer_(std::move(other.buffer_))
+{
+    if (!mapped_ && size_ > 0)
+    {
+        data_ = buffer_.data(); // The moved string may own a different allocation (SSO)
+    }
+}
+
+/**
+ * @brief Move assignment; releases the current mapping first.
+ */
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+        buffer_ = std::move(other.buffer_);
+        if (!mapped_ && size_ > 0)
+        {
+            data_ = buffer_.data();
+        }
+    }
+    return *this;
+}
@@ -0,0 +1,191 @@
+#include "Money.hpp"
+#include <cmath>   // For std::llround, std::isfinite, std::fabs
+#include <ostream>
+
+namespace
+{
+    /**
+     * @brief Rounds a double to the nearest 64-bit integer, halves away from zero
+     *
+     * std::llround has an unspecified result outside the int64_t range, so the
+     * value is checked first.
+     *
+     * @return std::optional<std::int64_t> The rounded value, or std::nullopt if the
+     * value is not finite or its magnitude is 2^63 or more.
+     */
+    std::optional<std::int64_t> roundToInt64(double value)
+    {
+        if (!std::isfinite(value) || std::fabs(value) >= 0x1p63)
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::int64_t>(std::llround(value));
+    }
+}
+
+/**
+ * @brief Converts a floating-point amount to Money.
+ *
+ * @param amount The amount in currency units.
+ * @return std::optional<Money> The amount rounded to the nearest cent (halves round away
+ * from zero), or std::nullopt if it is not finite or does not fit in 64-bit cents.
+ */
+std::optional<Money> Money::fromDouble(double amount)
+{
+    if (auto cents = roundToInt64(amount * 100.0))
+    {
+        return Money(*cents);
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Converts a floating-point factor to parts per million.
+ *
+ * @param factor The factor, e.g. 0.99 for a 1% reduction.
+ * @return std::optional<std::int64_t> The factor times ppmScale, rounded to the nearest
+ * integer, or std::nullopt if it is not finite or does not fit in 64 bits.
+ */
+std::optional<std::int64_t> Money::toPpm(double factor)
+{
+    return roundToInt64(factor * static_cast<double>(ppmScale));
+}
+
+/**
+ * @brief Parses a decimal amount.
+ *
+ * Integer and fraction digits are accumulated as integers, so "0.1" becomes
+ * exactly 10 cents. A third and further fraction digits only decide the
+ * rounding of the last cent (half to even). Text with an exponent is read as
+ * a double and rounded like fromDouble, which rejects amounts that do not fit.
+ *
+ * @param text The text to parse.
+ * @return std::optional<Money> The amount, or std::nullopt if the text is not a number or
+ * the amount does not fit in 64-bit cents.
+ */
+std::optional<Money> Money::parse(std::string_view text)
+{
+    if (text.find_first_of("eE") != std::string_view::npos)
+    {
+        double value;
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc() || ptr != text.data() + text.size())
+        {
+            return std::nullopt;
+        }
+        return fromDouble(value);
+    }
+
+    std::size_t pos = 0;
+    bool negative = false;
+    if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+    {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+
+    std::int64_t units = 0;
+    std::size_t digits = 0;
+    for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos, ++digits)
+    {
+        if (units > (INT64_MAX / 100 - 9) / 10)
+        {
+            return std::nullopt; // Would not fit in 64-bit cents
+        }
+        units = units * 10 + (text[pos] - '0');
+    }
+
+    std::int64_t fraction = 0; // First two fraction digits, in cents
+    int fractionDigits = 0;
+    int roundDigit = -1;       // Third fraction digit, -1 if absent
+    bool stickyDigits = false; // Any non-zero digit after the third
+    if (pos < text.size() && text[pos] == '.')
+    {
+        for (++pos; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos, ++digits)
+        {
+            int digit = text[pos] - '0';
+            if (fractionDigits < 2)
+            {
+                fraction = fraction * 10 + digit;
+                ++fractionDigits;
+            }
+            else if (roundDigit < 0)
+            {
+                roundDigit = digit;
+            }
+            else
+            {
+                stickyDigits = stickyDigits || digit != 0;
+            }
+        }
+    }
+    if (digits == 0 || pos != text.size())
+    {
+        return std::nullopt;
+    }
+    for (; fractionDigits < 2; ++fractionDigits)
+    {
+        fraction *= 10;
+    }
+
+    std::int64_t cents = units * 100 + fraction;
+    if (roundDigit > 5 || (roundDigit == 5 && (stickyDigits || (cents & 1))))
+    {
+        ++cents;
+    }
+    return Money(negative ? -cents : cents);
+}
+
+/**
+ * @brief Writes the amount as a decimal with two fraction digits.
+ *
+ * @param first The start of the output buffer.
+ * @param last The end of the output buffer.
+ * @return std::to_chars_result As for std::to_chars.
+ */
+std::to_chars_result Money::toChars(char *first, char *last) const
+{
+    std::uint64_t magnitude = cents_ < 0 ? 0 - static_cast<std::uint64_t>(cents_) : static_cast<std::uint64_t>(cents_);
+    if (cents_ < 0)
+    {
+        if (first == last)
+        {
+            return {last, std::errc::value_too_large};
+        }
+        *first++ = '-';
+    }
+    auto result = std::to_chars(first, last, magnitude / 100);
+    if (result.ec != std::errc() || last - result.ptr < 3)
+    {
+        return {last, std::errc::value_too_large};
+    }
+    const unsigned fraction = static_cast<unsigned>(magnitude % 100);
+    result.ptr[0] = '.';
+    result.ptr[1] = static_cast<char>('0' + fraction / 10);
+    result.ptr[2] = static_cast<char>('0' + fraction % 10);
+    return {result.ptr + 3, std::errc()};
+}
+
+/**
+ * @brief Formats the amount as a decimal with two fraction digits.
+ *
+ * @return std::string The formatted amount, e.g. "4500.00".
+ */
+std::string Money::toString() const
+{
+    char buffer[32];
+    auto [end, ec] = toChars(buffer, buffer + sizeof(buffer));
+    return std::string(buffer, end);
+}
+
+/**
+ * @brief Writes the amount to a stream with two fraction digits.
+ *
+ * @param os The output stream.
+ * @param amount The amount to write.
+ * @return std::ostream& The output stream.
+ */
+std::ostream &operator<<(std::ostream &os, Money amount)
+{
+    return os << amount.toString();
+}
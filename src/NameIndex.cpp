@@ -0,0 +1,94 @@
+#include "NameIndex.hpp"
+#include <algorithm> // For std::sort
+#include <limits> // For std::numeric_limits
+#include "ProductStore.hpp"
+
+/**
+ * @brief Adds a product name to both indexes.
+ *
+ * @param name The name; the characters must outlive the entry.
+ * @param id The product ID.
+ */
+void NameIndex::insert(std::string_view name, int id)
+{
+    exact_.emplace(name, id);
+    ordered_.insert({name, id});
+}
+
+/**
+ * @brief Replaces both indexes with the names of a product store.
+ *
+ * @param store The store whose names are indexed; its arena must outlive the entries.
+ */
+void NameIndex::rebuild(const ProductStore &store)
+{
+    std::vector<Entry> entries;
+    entries.reserve(store.size());
+    for (std::size_t slot = 0; slot < store.size(); ++slot)
+        entries.push_back({store.name(slot), store.ids()[slot]});
+    std::sort(entries.begin(), entries.end());
+
+    exact_.clear();
+    exact_.reserve(entries.size());
+    ordered_.clear();
+    for (const Entry &entry : entries)
+    {
+        exact_.emplace(entry.name, entry.id);
+        ordered_.emplace_hint(ordered_.end(), entry);
+    }
+}
+
+/**
+ * @brief Removes a product name from both indexes.
+ *
+ * @param name The name the product was indexed under.
+ * @param id The product ID.
+ */
+void NameIndex::erase(std::string_view name, int id)
+{
+    auto [first, last] = exact_.equal_range(name);
+    for (; first != last; ++first)
+    {
+        if (first->second == id)
+        {
+            exact_.erase(first);
+            break;
+        }
+    }
+    ordered_.erase({name, id});
+}
+
+/**
+ * @brief Gets the IDs of all products with exactly this name.
+ *
+ * @param name The name to look up.
+ * @return std::vector<int> The IDs, in no particular order.
+ */
+std::vector<int> NameIndex::find(std::string_view name) const
+{
+    std::vector<int> ids;
+    forEachExact(name, [&ids](int id) { ids.push_back(id); });
+    return ids;
+}
+
+/**
+ * @brief Gets the IDs of products whose name starts with a prefix.
+ *
+ * All names with the prefix sort directly after the prefix itself, so one
+ * lower_bound finds the first match and the walk stops at the first name
+ * that does not match.
+ *
+ * @param prefix The prefix to match.
+ * @param limit The largest number of IDs to return.
+ * @return std::vector<int> The IDs ordered by name, then by ID.
+ */
+std::vector<int> NameIndex::withPrefix(std::string_view prefix, std::size_t limit) const
+{
+    std::vector<int> ids;
+    for (auto it = ordered_.lower_bound({prefix, std::numeric_limits<int>::min()});
+         it != ordered_.end() && ids.size() < limit && it->name.starts_with(prefix); ++it)
+    {
+        ids.push_back(it->id);
+    }
+    return ids;
+}
@@ -1,9 +1,22 @@
 #include "Order.hpp"
 #include "Product.hpp"
 #include "Warehouse.hpp" // Required for Warehouse class definition for totalPrice
+#include <algorithm>     // For std::lower_bound
 #include <numeric>       // For std::accumulate
 #include <iostream>      // For std::cerr in totalPrice (optional error logging)
 
+/**
+ * @brief Finds the line for a product, or the position where it belongs
+ * * @param productId The product ID to look up
+ * @return The first line whose product ID is not less than productId
+ */
+OrderItem *Order::lowerBound(int productId)
+{
+    return std::lower_bound(items_.begin(), items_.end(), productId,
+                            [](const OrderItem &item, int id)
+                            { return item.productId < id; });
+}
+
 /**
  * @brief Adds a product to the order or increases its quantity if it already exists.
  * * This method adds a specified quantity of a product to the order. If the product
@@ -13,18 +26,27 @@
  * @param quantity The quantity of the product to add. Must be positive.
  */
 void Order::addItem(const Product& product, int quantity) {
+    addItem(product.getId(), quantity);
+}
+
+/**
+ * @brief Adds a product to the order by its ID or increases its quantity if it already exists.
+ * * @param productId The ID of the product to add to the order.
+ * @param quantity The quantity of the product to add. Must be positive.
+ */
+void Order::addItem(int productId, int quantity) {
     if (quantity <= 0)
     {
         // Optionally, handle this error, e.g., by logging or throwing an exception
         std::cerr << "Warning: Attempted to add non-positive quantity (" << quantity
-                  << ") for product ID " << product.getId() << ". Action ignored." << std::endl;
+                  << ") for product ID " << productId << ". Action ignored." << std::endl;
         return;
     }
-    auto it = items_.find(product.getId());
-    if (it != items_.end()) {
-        it->second += quantity;
+    OrderItem *it = lowerBound(productId);
+    if (it != items_.end() && it->productId == productId) {
+        it->quantity += quantity;
     } else {
-        items_[product.getId()] = quantity;
+        items_.insert(it, {productId, quantity});
     }
 }
 
@@ -34,15 +56,15 @@ void Order::addItem(const Product& product, int quantity) {
  * of their prices by finding each product in the provided warehouse and
  * multiplying its price by the quantity ordered. Uses std::accumulate.
  * * @param warehouse The Warehouse object used to find product details (like price).
- * @return double The total price of the entire order.
+ * @return Money The exact total price of the entire order.
  */
-double Order::totalPrice(const Warehouse &warehouse) const
+Money Order::totalPrice(const Warehouse &warehouse) const
 {
-    return std::accumulate(items_.begin(), items_.end(), 0.0,
-                           [&warehouse](double current_sum, const std::pair<const int, int> &item_pair)
+    return std::accumulate(items_.begin(), items_.end(), Money(),
+                           [&warehouse](Money current_sum, const OrderItem &item)
                            {
-                               int product_id = item_pair.first;
-                               int quantity = item_pair.second;
+                               int product_id = item.productId;
+                               int quantity = item.quantity;
 
                                auto product_expected = warehouse.findProductById(product_id);
                                if (product_expected)
@@ -133,7 +155,11 @@ std::istream &operator>>(std::istream &is, Order &order)
             order.items_.clear();                // Ensure order is not partially filled on error
             return is;
         }
-        order.items_[pid] = qty;
+        OrderItem *it = order.lowerBound(pid);
+        if (it != order.items_.end() && it->productId == pid)
+            it->quantity = qty; // A repeated ID keeps the last quantity
+        else
+            order.items_.insert(it, {pid, qty});
     }
     return is;
 }
@@ -147,7 +173,9 @@ std::istream &operator>>(std::istream &is, Order &order)
  */
 void Order::removeItem(int productId)
 {
-    items_.erase(productId); // erase on map by key
+    OrderItem *it = lowerBound(productId);
+    if (it != items_.end() && it->productId == productId)
+        items_.erase(it);
 }
 
 /**
@@ -161,8 +189,8 @@ void Order::removeItem(int productId)
  */
 void Order::editItemQuantity(int productId, int newQuantity)
 {
-    auto it = items_.find(productId);
-    if (it != items_.end())
+    OrderItem *it = lowerBound(productId);
+    if (it != items_.end() && it->productId == productId)
     {
         if (newQuantity <= 0)
         {
@@ -170,7 +198,7 @@ void Order::editItemQuantity(int productId, int newQuantity)
         }
         else
         {
-            it->second = newQuantity;
+            it->quantity = newQuantity;
         }
     }
     else if (newQuantity > 0)
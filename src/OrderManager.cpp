@@ -1,6 +1,9 @@
 #include "OrderManager.hpp"
+#include "Warehouse.hpp"
+#include "TaskScheduler.hpp"
 #include <algorithm>
-#include <iostream>
+#include <cstdint>
+#include <numeric>
 
 /**
  * @brief Adds a new order to the order manager.
@@ -11,38 +14,478 @@
  */
 void OrderManager::createOrder(const Order& order) {
     orders_.push_back(order);
+    statuses_.push_back(OrderStatus::Open);
+    if (!productLinesStale_)
+        indexOrderLines(orders_.size() - 1);
+    if (listener_)
+        listener_->orderCreated(orders_.back());
 }
 
 /**
- * @brief Processes all orders stored in the OrderManager.
- * 
- * This function iterates through all orders in the orders_ container and prints
- * each order to the standard output. The output includes a header message and
- * each order's details on a new line.
- * 
- * @note This method currently only displays orders and doesn't perform any
- * actual processing logic beyond printing.
+ * @brief Gets the display name of an order status.
+ *
+ * @param status The status to name
+ * @return const char* A lowercase name such as "partially fulfilled"
+ */
+const char *toString(OrderStatus status)
+{
+    switch (status)
+    {
+    case OrderStatus::Open:               return "open";
+    case OrderStatus::Fulfilled:          return "fulfilled";
+    case OrderStatus::PartiallyFulfilled: return "partially fulfilled";
+    case OrderStatus::Backordered:        return "backordered";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Ships every order that is not fulfilled yet.
+ *
+ * Runs in three flat passes instead of one stock update per order line:
+ * 1. The lines of all unfulfilled orders are copied into ID and quantity
+ *    columns and their IDs resolved to store slots in one batch.
+ * 2. The lines are allocated in order: each takes what is left of its
+ *    product's stock, tracked in a per-slot array.
+ * 3. Each product that shipped anything gets one updateQuantity call for its
+ *    total, and then each order gets its new status (partially shipped
+ *    orders are reduced to their outstanding lines).
+ *
+ * Copying the lines, resolving them and adding up each order's shipped and
+ * outstanding units run on the task scheduler in ranges of orders. The
+ * allocation stays sequential, since first come, first served depends on the
+ * order of the lines, and so do the stock and status updates, which notify
+ * the listeners.
+ *
+ * The warehouse listener sees one quantity change per product; the order
+ * listener sees an update for each partially shipped order and then the
+ * orders whose status changed, so what it records grows with the orders
+ * touched rather than with all orders.
+ *
+ * @param warehouse The warehouse to take the stock from
+ * @return FulfillmentSummary What was shipped and what is still outstanding
+ */
+FulfillmentSummary OrderManager::processAllOrders(Warehouse &warehouse)
+{
+    FulfillmentSummary summary;
+    std::vector<std::size_t> pending;
+    std::vector<std::size_t> offsets{0};
+    for (std::size_t index = 0; index < orders_.size(); ++index)
+    {
+        if (statuses_[index] != OrderStatus::Fulfilled)
+        {
+            pending.push_back(index);
+            offsets.push_back(offsets.back() + orders_[index].itemCount());
+        }
+    }
+    summary.ordersProcessed = pending.size();
+
+    TaskScheduler &scheduler = TaskScheduler::global();
+    const std::size_t grain = TaskScheduler::grains().fulfillment;
+    std::vector<int> ids(offsets.back());
+    std::vector<int> quantities(offsets.back());
+    scheduler.parallelFor(0, pending.size(), grain, [&](std::size_t from, std::size_t to)
+                          {
+        for (std::size_t p = from; p < to; ++p)
+        {
+            std::size_t line = offsets[p];
+            for (const auto &[productId, quantity] : orders_[pending[p]].getItems())
+            {
+                ids[line] = productId;
+                quantities[line] = quantity;
+                ++line;
+            }
+        } });
+
+    std::vector<std::size_t> slots(ids.size());
+    warehouse.resolveSlots(ids, slots);
+
+    // Allocate the stock line by line; remaining[slot] < 0 marks a product not seen yet
+    const ProductStore &store = warehouse.getStore();
+    std::span<const int> stock = store.quantities();
+    std::vector<std::int64_t> remaining(store.size(), -1);
+    std::vector<std::size_t> touched;
+    std::vector<int> shipped(ids.size(), 0);
+    for (std::size_t line = 0; line < ids.size(); ++line)
+    {
+        const std::size_t slot = slots[line];
+        if (slot == Warehouse::noSlot)
+            continue;
+        if (remaining[slot] < 0)
+        {
+            remaining[slot] = stock[slot];
+            touched.push_back(slot);
+        }
+        shipped[line] = static_cast<int>(std::min<std::int64_t>(quantities[line], remaining[slot]));
+        remaining[slot] -= shipped[line];
+    }
+
+    // One stock change per product
+    std::vector<std::pair<int, int>> stockChanges; // (product ID, units shipped)
+    for (std::size_t slot : touched)
+    {
+        const std::int64_t units = stock[slot] - remaining[slot];
+        if (units == 0)
+            continue;
+        stockChanges.emplace_back(store.ids()[slot], static_cast<int>(units));
+        summary.unitsShipped += units;
+        summary.shippedValue += store.prices()[slot] * units;
+    }
+    summary.productsShipped = stockChanges.size();
+    for (const auto &[productId, units] : stockChanges)
+        warehouse.updateQuantity(productId, -units);
+
+    // Units shipped and still outstanding per pending order
+    std::vector<std::pair<long long, long long>> orderUnits(pending.size());
+    scheduler.parallelFor(0, pending.size(), grain, [&](std::size_t from, std::size_t to)
+                          {
+        for (std::size_t p = from; p < to; ++p)
+        {
+            for (std::size_t line = offsets[p]; line < offsets[p + 1]; ++line)
+            {
+                orderUnits[p].first += shipped[line];
+                orderUnits[p].second += quantities[line] - shipped[line];
+            }
+        } });
+
+    std::vector<OrderStatusChange> changes;
+    for (std::size_t p = 0; p < pending.size(); ++p)
+    {
+        const std::size_t index = pending[p];
+        const auto [shippedUnits, outstandingUnits] = orderUnits[p];
+        summary.unitsOutstanding += outstandingUnits;
+
+        OrderStatus &status = statuses_[index];
+        const OrderStatus before = status;
+        if (outstandingUnits == 0)
+        {
+            status = OrderStatus::Fulfilled;
+            changes.push_back({index, status});
+            ++summary.fulfilled;
+            continue;
+        }
+        if (shippedUnits == 0)
+        {
+            // An order that shipped part of its lines earlier stays partially fulfilled
+            if (status != OrderStatus::PartiallyFulfilled)
+                status = OrderStatus::Backordered;
+        }
+        else
+        {
+            status = OrderStatus::PartiallyFulfilled;
+            Order outstanding;
+            for (std::size_t line = offsets[p]; line < offsets[p + 1]; ++line)
+            {
+                if (quantities[line] > shipped[line])
+                    outstanding.addItem(ids[line], quantities[line] - shipped[line]);
+            }
+            orders_[index] = outstanding;
+            orderChanged(index);
+            if (listener_)
+                listener_->orderUpdated(index, orders_[index]);
+        }
+        if (status != before)
+            changes.push_back({index, status});
+        if (status == OrderStatus::PartiallyFulfilled)
+            ++summary.partiallyFulfilled;
+        else
+            ++summary.backordered;
+    }
+
+    if (listener_ && !changes.empty())
+        listener_->ordersFulfilled(changes);
+    return summary;
+}
+
+/**
+ * @brief Replaces the status of every order.
+ *
+ * @param statuses One status per order
+ * @return true if the statuses were taken over, false if their number does not match
+ */
+bool OrderManager::setStatuses(std::span<const OrderStatus> statuses)
+{
+    if (statuses.size() != orders_.size())
+        return false;
+    statuses_.assign(statuses.begin(), statuses.end());
+    return true;
+}
+
+/**
+ * @brief Replaces the status of one order.
+ *
+ * @param index The index of the order
+ * @param status The new status
+ * @return true if the order exists, false otherwise
+ */
+bool OrderManager::setStatus(std::size_t index, OrderStatus status)
+{
+    if (index >= statuses_.size())
+        return false;
+    statuses_[index] = status;
+    return true;
+}
+
+/**
+ * @brief Prices every order stored in the OrderManager.
+ *
+ * @param warehouse The warehouse whose current prices are used
+ * @return One total per order, and the lines whose product is missing
  */
-void OrderManager::processAllOrders() {
-    std::cout << "[+] Processing all orders...\n";
-    std::for_each(orders_.begin(), orders_.end(), [](Order& o){
-        std::cout << o << "\n";
-    });
+OrderPricing OrderManager::priceOrders(const Warehouse &warehouse) const
+{
+    std::vector<std::size_t> indexes(orders_.size());
+    std::iota(indexes.begin(), indexes.end(), std::size_t{0});
+    return priceOrders(warehouse, indexes);
 }
 
 /**
- * @brief Gets the collection of orders stored in the OrderManager.
+ * @brief Prices a selected set of orders in one pass.
  *
- * This method returns a reference to the internal orders_ container, allowing
- * external code to access and modify the orders stored in the OrderManager.
+ * Works in four flat steps instead of one product lookup per line:
+ * 1. Copy the lines of the selected orders into ID and quantity columns,
+ *    after counting where each order starts.
+ * 2. Resolve all IDs to store slots with one batch call.
+ * 3. Sum unit price * quantity over each order's range of lines, taking the
+ *    unit price from the price column; a missing product contributes 0.
+ * 4. Record every line whose product is missing as a MissingProduct.
  *
- * @return A reference to the internal vector of Order objects
+ * Steps 1 to 3 run on the task scheduler in ranges of orders, each writing
+ * only its own orders' lines and totals; step 4 runs in order, so the result
+ * does not depend on the number of threads.
+ *
+ * The Product view is never touched, so a bulk reprice does not have to be
+ * written back before pricing.
+ *
+ * @param warehouse The warehouse whose current prices are used
+ * @param indexes The indexes of the orders to price
+ * @return One total per index, and the lines whose product is missing
  */
-Order &OrderManager::getOrder(size_t index)
+OrderPricing OrderManager::priceOrders(const Warehouse &warehouse, std::span<const std::size_t> indexes) const
+{
+    std::vector<std::size_t> offsets;
+    offsets.reserve(indexes.size() + 1);
+    offsets.push_back(0);
+    for (std::size_t index : indexes)
+    {
+        offsets.push_back(offsets.back() + (index < orders_.size() ? orders_[index].itemCount() : 0));
+    }
+    const std::size_t lineCount = offsets.back();
+
+    TaskScheduler &scheduler = TaskScheduler::global();
+    const std::size_t grain = TaskScheduler::grains().orderPricing;
+    std::vector<int> ids(lineCount);
+    std::vector<std::int64_t> quantities(lineCount);
+    scheduler.parallelFor(0, indexes.size(), grain, [&](std::size_t from, std::size_t to)
+                          {
+        for (std::size_t order = from; order < to; ++order)
+        {
+            if (indexes[order] >= orders_.size())
+                continue;
+            std::size_t line = offsets[order];
+            for (const auto &[productId, quantity] : orders_[indexes[order]].getItems())
+            {
+                ids[line] = productId;
+                quantities[line] = quantity;
+                ++line;
+            }
+        } });
+
+    std::vector<std::size_t> slots(lineCount);
+    warehouse.resolveSlots(ids, slots);
+
+    OrderPricing result;
+    result.totals.resize(indexes.size());
+    std::span<const Money> prices = warehouse.getStore().prices();
+    scheduler.parallelFor(0, indexes.size(), grain, [&](std::size_t from, std::size_t to)
+                          {
+        for (std::size_t order = from; order < to; ++order)
+        {
+            std::int64_t cents = 0;
+            for (std::size_t line = offsets[order]; line < offsets[order + 1]; ++line)
+            {
+                const std::size_t slot = slots[line];
+                const std::int64_t unitCents = slot != Warehouse::noSlot ? prices[slot].cents() : 0;
+                cents += unitCents * quantities[line];
+            }
+            result.totals[order] = Money::fromCents(cents);
+        } });
+
+    for (std::size_t order = 0; order < indexes.size(); ++order)
+    {
+        for (std::size_t line = offsets[order]; line < offsets[order + 1]; ++line)
+        {
+            if (slots[line] == Warehouse::noSlot)
+                result.missing.push_back({indexes[order], ids[line], static_cast<int>(quantities[line])});
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Adds the lines of one order to the reverse index.
+ *
+ * Each line becomes the new head of its product's chain.
+ *
+ * @param index The index of the order
+ */
+void OrderManager::indexOrderLines(std::size_t index) const
+{
+    for (const auto &[productId, quantity] : orders_[index].getItems())
+    {
+        auto [head, inserted] = productHeads_.try_emplace(productId, endOfChain);
+        productLines_.push_back({static_cast<std::uint32_t>(index), quantity, head->second});
+        head->second = static_cast<std::uint32_t>(productLines_.size() - 1);
+    }
+}
+
+/**
+ * @brief Brings the cached order totals up to date with the warehouse's prices.
+ *
+ * If the price epoch moved and the warehouse still has every change since the
+ * cached epoch, each change is applied to the known totals of the orders that
+ * contain its product: total += (after - before) * quantity. Otherwise every
+ * total is forgotten. Finally all unknown totals (new or changed orders, or all
+ * of them) are priced in one priceOrders batch.
+ *
+ * @param warehouse The warehouse whose current prices are used
+ */
+void OrderManager::refreshTotals(const Warehouse &warehouse) const
+{
+    totals_.resize(orders_.size());
+    totalKnown_.resize(orders_.size(), 0);
+
+    const std::uint64_t epoch = warehouse.priceEpoch();
+    if (epoch != pricedAt_)
+    {
+        auto changes = warehouse.priceChangesSince(pricedAt_);
+        if (!changes)
+        {
+            std::fill(totalKnown_.begin(), totalKnown_.end(), std::uint8_t{0});
+        }
+        else
+        {
+            if (productLinesStale_)
+            {
+                std::size_t lineCount = 0;
+                for (const Order &order : orders_)
+                    lineCount += order.itemCount();
+                productHeads_.clear();
+                productHeads_.reserve(lineCount);
+                productLines_.clear();
+                productLines_.reserve(lineCount);
+                for (std::size_t index = 0; index < orders_.size(); ++index)
+                    indexOrderLines(index);
+                productLinesStale_ = false;
+            }
+            for (const PriceChange &change : *changes)
+            {
+                auto head = productHeads_.find(change.productId);
+                if (head == productHeads_.end())
+                    continue;
+                const Money delta = change.after - change.before;
+                for (std::uint32_t entry = head->second; entry != endOfChain; entry = productLines_[entry].next)
+                {
+                    const ProductLine &line = productLines_[entry];
+                    if (totalKnown_[line.order])
+                        totals_[line.order] += delta * line.quantity;
+                }
+            }
+        }
+        pricedAt_ = epoch;
+    }
+
+    std::vector<std::size_t> unknown;
+    for (std::size_t index = 0; index < orders_.size(); ++index)
+    {
+        if (!totalKnown_[index])
+            unknown.push_back(index);
+    }
+    if (unknown.empty())
+        return;
+    OrderPricing pricing = priceOrders(warehouse, unknown);
+    for (std::size_t i = 0; i < unknown.size(); ++i)
+    {
+        totals_[unknown[i]] = pricing.totals[i];
+        totalKnown_[unknown[i]] = 1;
+    }
+}
+
+/**
+ * @brief Gets the total of every order, from the cache.
+ *
+ * @param warehouse The warehouse whose current prices are used
+ * @return One total per order
+ */
+std::span<const Money> OrderManager::orderTotals(const Warehouse &warehouse) const
+{
+    refreshTotals(warehouse);
+    return totals_;
+}
+
+/**
+ * @brief Gets the total of one order, from the cache.
+ *
+ * @param warehouse The warehouse whose current prices are used
+ * @param index The index of the order
+ * @return The total, or zero if the index is out of bounds
+ */
+Money OrderManager::orderTotal(const Warehouse &warehouse, size_t index) const
+{
+    if (index >= orders_.size())
+        return Money();
+    refreshTotals(warehouse);
+    return totals_[index];
+}
+
+/**
+ * @brief Forgets the cached total of an order whose lines may have changed.
+ *
+ * The reverse index is marked stale too, since the order's products may differ.
+ *
+ * @param index The index of the order
+ */
+void OrderManager::orderChanged(size_t index)
+{
+    if (index < totalKnown_.size())
+        totalKnown_[index] = 0;
+    productLinesStale_ = true;
+}
+
+/**
+ * @brief Gets one order for reading.
+ *
+ * Orders are only changed through updateOrder, so every edit reaches the listener.
+ *
+ * @param index The position of the order.
+ * @return const Order& The order.
+ */
+const Order &OrderManager::getOrder(size_t index) const
 {
     return orders_.at(index);
 }
 
+/**
+ * @brief Replaces the order at the given index.
+ *
+ * This is the tracked way to edit an order: callers copy the order, modify the
+ * copy and hand it back here, so the listener sees the change. If the index is
+ * out of bounds, no action is taken.
+ *
+ * @param index The index of the order to replace
+ * @param order The new contents of the order
+ */
+void OrderManager::updateOrder(size_t index, const Order& order)
+{
+    if (index < orders_.size())
+    {
+        orders_[index] = order;
+        orderChanged(index);
+        if (listener_)
+            listener_->orderUpdated(index, orders_[index]);
+    }
+}
+
 /**
  * @brief Removes an order from the OrderManager by index.
  *
@@ -56,5 +499,14 @@ void OrderManager::removeOrder(size_t index)
     if (index < orders_.size())
     {
         orders_.erase(orders_.begin() + index);
+        statuses_.erase(statuses_.begin() + index);
+        if (index < totals_.size())
+        {
+            totals_.erase(totals_.begin() + index);
+            totalKnown_.erase(totalKnown_.begin() + index);
+        }
+        productLinesStale_ = true; // Every later order moved down one index
+        if (listener_)
+            listener_->orderRemoved(index);
     }
 }
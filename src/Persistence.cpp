@@ -0,0 +1,286 @@
+#include "Persistence.hpp"
+#include "Warehouse.hpp"
+#include "OrderManager.hpp"
+#include "Snapshot.hpp"
+#include "DirectorySync.hpp"
+#include <algorithm> // For std::sort
+#include <charconv>  // For std::from_chars
+#include <iostream>
+#include <utility> // For std::exchange
+#include <vector>
+
+namespace
+{
+    struct Generation
+    {
+        std::uint64_t number;
+        std::filesystem::path path;
+    };
+
+    /**
+     * @brief Lists the files named <prefix><number><suffix> in a directory, oldest first
+     */
+    std::vector<Generation> listGenerations(const std::filesystem::path &directory, std::string_view prefix,
+                                            std::string_view suffix)
+    {
+        std::vector<Generation> found;
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::directory_iterator(directory, ec))
+        {
+            std::string name = entry.path().filename().string();
+            if (name.size() <= prefix.size() + suffix.size() || !name.starts_with(prefix) || !name.ends_with(suffix))
+                continue;
+            std::string_view digits(name.data() + prefix.size(), name.size() - prefix.size() - suffix.size());
+            std::uint64_t number;
+            auto [ptr, err] = std::from_chars(digits.data(), digits.data() + digits.size(), number);
+            if (err == std::errc() && ptr == digits.data() + digits.size())
+                found.push_back({number, entry.path()});
+        }
+        std::sort(found.begin(), found.end(), [](const Generation &a, const Generation &b)
+                  { return a.number < b.number; });
+        return found;
+    }
+
+    std::filesystem::path snapshotPath(const std::filesystem::path &directory, std::uint64_t generation)
+    {
+        return directory / ("snapshot." + std::to_string(generation) + ".bin");
+    }
+
+    std::filesystem::path journalPath(const std::filesystem::path &directory, std::uint64_t generation)
+    {
+        return directory / ("journal." + std::to_string(generation) + ".log");
+    }
+}
+
+Persistence::Persistence(std::filesystem::path directory, Warehouse &warehouse, OrderManager &orderManager,
+                         PersistenceOptions options)
+    : directory_(std::move(directory)), warehouse_(warehouse), orderManager_(orderManager), options_(options)
+{
+}
+
+/**
+ * @brief Recovers the state stored in a directory and starts journaling changes.
+ *
+ * @param directory The data directory; created if missing.
+ * @param warehouse The warehouse to recover into and observe.
+ * @param orderManager The order manager to recover into and observe.
+ * @param options Journal and compaction settings.
+ * @return std::expected<std::unique_ptr<Persistence>, std::string> The persistence handle, or an error message.
+ */
+std::expected<std::unique_ptr<Persistence>, std::string> Persistence::open(const std::filesystem::path &directory,
+                                                                           Warehouse &warehouse,
+                                                                           OrderManager &orderManager,
+                                                                           PersistenceOptions options)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec)
+    {
+        return std::unexpected("Cannot create data directory " + directory.string() + ": " + ec.message());
+    }
+
+    std::unique_ptr<Persistence> persistence(new Persistence(directory, warehouse, orderManager, options));
+    if (auto recovered = persistence->recover(); !recovered)
+    {
+        return std::unexpected(recovered.error());
+    }
+    persistence->attach();
+    return persistence;
+}
+
+/**
+ * @brief Restores the newest readable snapshot and replays the journals written after it.
+ *
+ * A snapshot that cannot be opened is skipped in favour of the one before it;
+ * its journal generation is still on disk because older generations are only
+ * removed after a newer snapshot has been written. Journaling then continues
+ * in a fresh generation, so a torn tail left by a crash is never appended to.
+ *
+ * @return std::expected<void, std::string> Nothing on success, or an error message.
+ */
+std::expected<void, std::string> Persistence::recover()
+{
+    auto snapshots = listGenerations(directory_, "snapshot.", ".bin");
+    auto journals = listGenerations(directory_, "journal.", ".log");
+
+    std::uint64_t base = 0;
+    for (auto it = snapshots.rbegin(); it != snapshots.rend(); ++it)
+    {
+        if (auto loaded = Snapshot::load(it->path.string(), warehouse_, orderManager_); loaded)
+        {
+            base = it->number;
+            break;
+        }
+        else
+        {
+            std::cerr << "Warning: skipping unreadable snapshot: " << loaded.error() << "\n";
+        }
+    }
+
+    std::uint64_t last = base;
+    for (const Generation &journal : journals)
+    {
+        last = std::max(last, journal.number);
+        if (journal.number < base)
+            continue;
+        auto replayed = Journal::replay(journal.path.string(), warehouse_, orderManager_);
+        if (!replayed)
+        {
+            return std::unexpected(replayed.error());
+        }
+        if (replayed->truncatedTail)
+        {
+            std::cerr << "Warning: journal " << journal.path.string()
+                      << " ends with an incomplete record; it was ignored.\n";
+        }
+    }
+
+    return startJournal(last + 1);
+}
+
+/**
+ * @brief Opens the journal of a new generation and makes it the current one.
+ *
+ * The directory is flushed after the file is opened, so a journal created here
+ * cannot vanish in a crash while records synced to it are counted as durable.
+ *
+ * @param generation The generation number of the new journal.
+ * @return std::expected<void, std::string> Nothing on success, or an error message.
+ */
+std::expected<void, std::string> Persistence::startJournal(std::uint64_t generation)
+{
+    auto journal = Journal::open(journalPath(directory_, generation).string(), options_.journal);
+    if (!journal)
+    {
+        return std::unexpected(journal.error());
+    }
+    if (auto synced = syncDirectory(directory_); !synced)
+    {
+        return synced;
+    }
+    journal_ = std::move(*journal);
+    generation_ = generation;
+    return {};
+}
+
+void Persistence::attach()
+{
+    warehouse_.setListener(journal_.get());
+    orderManager_.setListener(journal_.get());
+}
+
+void Persistence::detach()
+{
+    warehouse_.setListener(nullptr);
+    orderManager_.setListener(nullptr);
+}
+
+/**
+ * @brief Syncs the journal, waits for a running compaction and stops observing.
+ */
+Persistence::~Persistence()
+{
+    detach();
+    if (auto synced = journal_->sync(); !synced)
+    {
+        std::cerr << synced.error() << "\n";
+    }
+    if (compactor_.joinable())
+    {
+        compactor_.join();
+    }
+}
+
+/**
+ * @brief Blocks until every change made so far is durable on disk.
+ *
+ * @return std::expected<void, std::string> Nothing on success, or the journal write error.
+ */
+std::expected<void, std::string> Persistence::sync()
+{
+    return journal_->sync();
+}
+
+/**
+ * @brief Folds the current state into a new snapshot generation.
+ *
+ * The current journal is synced and closed and a new generation is started
+ * before the state is encoded, so the snapshot and the new journal describe
+ * the same point in time. Only the file write and the removal of the older
+ * generations run on the background thread.
+ *
+ * @return std::expected<void, std::string> Nothing if the compaction was started, or an error message.
+ */
+std::expected<void, std::string> Persistence::compact()
+{
+    if (compactor_.joinable())
+    {
+        compactor_.join(); // One compaction at a time
+    }
+    if (auto synced = journal_->sync(); !synced)
+    {
+        return std::unexpected(synced.error());
+    }
+    if (auto started = startJournal(generation_ + 1); !started)
+    {
+        return started;
+    }
+    attach();
+
+    std::vector<char> bytes = Snapshot::encode(warehouse_, orderManager_);
+    const std::uint64_t generation = generation_;
+    compactor_ = std::jthread([this, generation, bytes = std::move(bytes)]
+                              {
+        auto target = snapshotPath(directory_, generation);
+        auto written = Snapshot::writeFile(target.string(), bytes);
+        {
+            std::lock_guard lock(compactionMutex_);
+            if (!written)
+                compactionError_ = written.error();
+        }
+        if (!written)
+        {
+            return; // Keep the older generations; they still recover everything
+        }
+        // writeFile has flushed the directory after its rename, and startJournal
+        // did so after creating the new journal, so both are durable by now and
+        // the older generations are no longer needed.
+
+        std::error_code ec;
+        for (const Generation &old : listGenerations(directory_, "snapshot.", ".bin"))
+        {
+            if (old.number < generation)
+                std::filesystem::remove(old.path, ec);
+        }
+        for (const Generation &old : listGenerations(directory_, "journal.", ".log"))
+        {
+            if (old.number < generation)
+                std::filesystem::remove(old.path, ec);
+        } });
+    return {};
+}
+
+/**
+ * @brief Calls compact() if the current journal has grown past compactAfterBytes.
+ *
+ * @return std::expected<void, std::string> Nothing on success or if no compaction was needed, or an error message.
+ */
+std::expected<void, std::string> Persistence::compactIfNeeded()
+{
+    if (journal_->size() < options_.compactAfterBytes)
+    {
+        return {};
+    }
+    return compact();
+}
+
+/**
+ * @brief Gets and clears the error of the last background compaction.
+ *
+ * @return std::string The error message, or an empty string if it succeeded.
+ */
+std::string Persistence::takeCompactionError()
+{
+    std::lock_guard lock(compactionMutex_);
+    return std::exchange(compactionError_, {});
+}
@@ -0,0 +1,76 @@
+#include "PriceIndex.hpp"
+#include <algorithm> // For std::sort
+#include <limits>    // For std::numeric_limits
+
+/**
+ * @brief Replaces the index with the (price, ID) pairs of the given columns.
+ *
+ * @param prices The price of every product.
+ * @param ids The ID of every product, aligned with prices.
+ */
+void PriceIndex::rebuild(std::span<const Money> prices, std::span<const int> ids)
+{
+    std::vector<Entry> sorted;
+    sorted.reserve(ids.size());
+    for (std::size_t slot = 0; slot < ids.size(); ++slot)
+    {
+        sorted.push_back({prices[slot], ids[slot]});
+    }
+    std::sort(sorted.begin(), sorted.end());
+    entries_ = Entries(sorted.begin(), sorted.end()); // Linear for sorted input
+}
+
+/**
+ * @brief Gets the entries whose price lies in [low, high].
+ *
+ * Both ends are found with a tree search, so the cost is O(log n) plus the
+ * number of entries the caller walks.
+ *
+ * @param low The lowest price included.
+ * @param high The highest price included.
+ * @return std::ranges::subrange<PriceIndex::const_iterator> The entries in ascending price order.
+ */
+std::ranges::subrange<PriceIndex::const_iterator> PriceIndex::range(Money low, Money high) const
+{
+    if (high < low)
+    {
+        return {entries_.end(), entries_.end()};
+    }
+    auto first = entries_.lower_bound({low, std::numeric_limits<int>::min()});
+    auto last = entries_.upper_bound({high, std::numeric_limits<int>::max()});
+    return {first, last};
+}
+
+/**
+ * @brief Gets the IDs of the k cheapest products.
+ *
+ * @param k The number of products wanted; fewer are returned if the index is smaller.
+ * @return std::vector<int> The IDs, cheapest first.
+ */
+std::vector<int> PriceIndex::cheapest(std::size_t k) const
+{
+    std::vector<int> ids;
+    ids.reserve(std::min(k, entries_.size()));
+    for (auto it = entries_.begin(); it != entries_.end() && ids.size() < k; ++it)
+    {
+        ids.push_back(it->id);
+    }
+    return ids;
+}
+
+/**
+ * @brief Gets the IDs of the k most expensive products.
+ *
+ * @param k The number of products wanted; fewer are returned if the index is smaller.
+ * @return std::vector<int> The IDs, most expensive first.
+ */
+std::vector<int> PriceIndex::mostExpensive(std::size_t k) const
+{
+    std::vector<int> ids;
+    ids.reserve(std::min(k, entries_.size()));
+    for (auto it = entries_.rbegin(); it != entries_.rend() && ids.size() < k; ++it)
+    {
+        ids.push_back(it->id);
+    }
+    return ids;
+}
@@ -1,25 +1,26 @@
 #include "Product.hpp"
 #include <iomanip> // For std::quoted (used in operator>>)
-#include <cmath>   // For std::isnan
 
 // Initialize static member
-int Product::globalIdCounter_ = 0;
+std::atomic<int> Product::globalIdCounter_{0};
 
 /**
  * @brief Constructor for the Product class.
  * * @param name The name of the product.
  * @param price The price of the product.
  * @param quantity The quantity of the product in inventory.
+ * @param type The concrete subclass being constructed.
  */
-Product::Product(const std::string& name, double price, int quantity)
-    : name_(name), price_(price), quantity_(quantity), productId_(++globalIdCounter_)
+Product::Product(const std::string& name, Money price, int quantity, ProductType type)
+    : ownedName_(name), name_(ownedName_), price_(price), quantity_(quantity),
+      productId_(globalIdCounter_.fetch_add(1, std::memory_order_relaxed) + 1), type_(type)
 {
     // Basic validation, can be expanded
-    if (price < 0)
+    if (price < Money())
     {
         // Consider throwing an exception or setting a default valid price
         std::cerr << "Warning: Product '" << name << "' created with negative price. Setting to 0." << std::endl;
-        price_ = 0.0;
+        price_ = Money();
     }
     if (quantity < 0)
     {
@@ -29,16 +30,100 @@ Product::Product(const std::string& name, double price, int quantity)
     }
 }
 
+/**
+ * @brief Copy constructor; the copy keeps its own copy of the name.
+ * * @param other The product to copy.
+ */
+Product::Product(const Product &other)
+    : ownedName_(other.name_), name_(ownedName_), price_(other.price_), quantity_(other.quantity_),
+      productId_(other.productId_), type_(other.type_)
+{
+}
+
+/**
+ * @brief Move constructor; takes over the other product's name storage if it owns one.
+ * * @param other The product to move from.
+ */
+Product::Product(Product &&other) noexcept
+    : ownedName_(other.name_.data() == other.ownedName_.data() ? std::move(other.ownedName_) : std::string(other.name_)),
+      name_(ownedName_), price_(other.price_), quantity_(other.quantity_), productId_(other.productId_),
+      type_(other.type_)
+{
+    other.name_ = other.ownedName_;
+}
+
+/**
+ * @brief Copy assignment; this product ends up owning a copy of the name.
+ * * @param other The product to copy.
+ * @return Product& This product.
+ */
+Product &Product::operator=(const Product &other)
+{
+    if (this != &other)
+    {
+        ownedName_.assign(other.name_);
+        name_ = ownedName_;
+        price_ = other.price_;
+        quantity_ = other.quantity_;
+        productId_ = other.productId_;
+        type_ = other.type_;
+    }
+    return *this;
+}
+
+/**
+ * @brief Move assignment; takes over the other product's name storage if it owns one.
+ * * @param other The product to move from.
+ * @return Product& This product.
+ */
+Product &Product::operator=(Product &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (other.name_.data() == other.ownedName_.data())
+            ownedName_ = std::move(other.ownedName_);
+        else
+            ownedName_.assign(other.name_);
+        name_ = ownedName_;
+        other.name_ = other.ownedName_;
+        price_ = other.price_;
+        quantity_ = other.quantity_;
+        productId_ = other.productId_;
+        type_ = other.type_;
+    }
+    return *this;
+}
+
+/**
+ * @brief Renames the product; the new name is kept by the product itself.
+ * * @param newName The new name.
+ */
+void Product::setName(const std::string& newName)
+{
+    ownedName_ = newName;
+    name_ = ownedName_;
+}
+
+/**
+ * @brief Points the name at characters kept alive by the caller and frees the product's own copy.
+ * * @param name The name; Warehouse passes the copy in its ProductStore arena.
+ */
+void Product::useArenaName(std::string_view name)
+{
+    std::string().swap(ownedName_);
+    name_ = name;
+}
+
 /**
  * @brief Sets the price of the product.
  * * @param newPrice The new price of the product. If negative, price is set to 0.
  */
-void Product::setPrice(double newPrice) {
-    if (newPrice < 0)
+void Product::setPrice(Money newPrice) {
+    if (newPrice < Money())
     {
         std::cerr << "Warning: Attempted to set negative price for product ID " << productId_
                   << ". Setting price to 0." << std::endl;
-        price_ = 0.0;
+        price_ = Money();
     }
     else
     {
@@ -67,15 +152,12 @@ void Product::updateQuantity(int delta) {
 /**
  * @brief Three-way comparison operator for Product.
  * * This operator compares two products based on their price (ascending) and then by name (ascending lexicographically).
- * It handles NaN values in the price by returning std::partial_ordering::unordered if either price is NaN.
+ * Prices are exact cents, so the result is never unordered.
  * * @param other The other product to compare with.
  * @return std::partial_ordering The result of the comparison.
  */
 std::partial_ordering Product::operator<=>(const Product& other) const {
     // Compare price first
-    if (std::isnan(price_) || std::isnan(other.price_)) {
-        return std::partial_ordering::unordered;
-    }
     if (price_ < other.price_) {
         return std::partial_ordering::less;
     }
@@ -119,7 +201,7 @@ std::ostream& operator<<(std::ostream& os, const Product& prod) {
     // For file I/O that needs to be parsed by operator>>, save attributes manually.
     os << "[ID:" << prod.productId_ << "] "
        << prod.name_                                                        // Name displayed as is, std::quoted not typically used for console display here
-       << " | Price: " << std::fixed << std::setprecision(2) << prod.price_ // Format price
+       << " | Price: " << prod.price_                                       // Money prints with two decimals
        << " | Qty: " << prod.quantity_;
     return os;
 }
@@ -141,13 +223,23 @@ std::istream &operator>>(std::istream &is, Product &prod)
 {
     // Reads name (quoted), price, quantity.
     // Derived classes will call this and then read their own members.
-    is >> std::quoted(prod.name_) >> prod.price_ >> prod.quantity_;
+    // The price is read as a token and parsed exactly into cents.
+    std::string name, priceText;
+    is >> std::quoted(name) >> priceText >> prod.quantity_;
+    if (is)
+    {
+        prod.setName(name);
+        if (auto price = Money::parse(priceText))
+            prod.price_ = *price;
+        else
+            is.setstate(std::ios::failbit);
+    }
 
     // Basic validation after read
-    if (prod.price_ < 0 && is.good())
+    if (prod.price_ < Money() && is.good())
     { // Check is.good() in case read itself failed
         // std::cerr << "Warning: Read negative price for product. Setting to 0." << std::endl; // Could be noisy
-        prod.price_ = 0.0;
+        prod.price_ = Money();
     }
     if (prod.quantity_ < 0 && is.good())
     {
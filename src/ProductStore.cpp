@@ -0,0 +1,165 @@
+#include "ProductStore.hpp"
+#include "ProductVisit.hpp"
+
+namespace
+{
+    /**
+     * @brief Gathers a column through a permutation: result[i] = column[order[i]]
+     */
+    template <typename T>
+    void gather(std::vector<T> &column, const std::vector<std::size_t> &order)
+    {
+        std::vector<T> reordered;
+        reordered.reserve(column.size());
+        for (std::size_t from : order)
+        {
+            reordered.push_back(std::move(column[from]));
+        }
+        column = std::move(reordered);
+    }
+
+    // Type-specific fields, selected at compile time by visitProduct
+    InternedString attributeOf(const Electronic &product) { return product.getWarrantyHandle(); }
+    InternedString attributeOf(const Clothing &product) { return product.getSizeHandle(); }
+    InternedString attributeOf(const Food &product) { return product.getExpirationDateHandle(); }
+    InternedString attributeOf(const Product &) { return {}; }
+
+    double weightOf(const TangibleProduct &product) { return product.getWeight(); }
+    double weightOf(const Product &product)
+    {
+        // Only subclasses outside the built-in set get here
+        const auto *tangible = dynamic_cast<const TangibleProduct *>(&product);
+        return tangible ? tangible->getWeight() : 0.0;
+    }
+}
+
+/**
+ * @brief Determines the concrete type of a product.
+ *
+ * Reads the tag the product's constructor recorded; no RTTI is involved.
+ *
+ * @param product The product to classify.
+ * @return ProductType The matching tag, or ProductType::Other for unknown subclasses.
+ */
+ProductType ProductStore::classify(const Product &product)
+{
+    return product.getType();
+}
+
+/**
+ * @brief Creates a Product object of the subclass matching a type tag.
+ *
+ * This is the inverse of classify() and is used by loaders that build products
+ * from columns or parsed records.
+ *
+ * @return std::unique_ptr<Product> The new product, or nullptr for ProductType::Other.
+ */
+std::unique_ptr<Product> ProductStore::makeProduct(ProductType type, const std::string &name, Money price,
+                                                   int quantity, double weight, const std::string &attribute)
+{
+    switch (type)
+    {
+    case ProductType::Electronic:
+        return std::make_unique<Electronic>(name, price, quantity, weight, attribute);
+    case ProductType::Clothing:
+        return std::make_unique<Clothing>(name, price, quantity, weight, attribute);
+    case ProductType::Food:
+        return std::make_unique<Food>(name, price, quantity, weight, attribute);
+    default:
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Appends a copy of the product's fields as a new slot.
+ *
+ * @param product The product whose data is copied into the hot columns and side tables.
+ */
+void ProductStore::append(const Product &product)
+{
+    ids_.push_back(product.getId());
+    prices_.push_back(product.getPrice());
+    quantities_.push_back(product.getQuantity());
+    types_.push_back(product.getType());
+    names_.push_back(strings_.store(product.getName()));
+    visitProduct(product, [this](const auto &concrete)
+                 {
+        weights_.push_back(weightOf(concrete));
+        attributes_.push_back(attributeOf(concrete)); });
+}
+
+/**
+ * @brief Replaces the name of a slot.
+ *
+ * @param slot The slot to rename.
+ * @param name The new name, copied into the arena.
+ * @return std::string_view A view of the stored name.
+ */
+std::string_view ProductStore::rename(std::size_t slot, std::string_view name)
+{
+    names_[slot] = strings_.store(name);
+    return names_[slot];
+}
+
+/**
+ * @brief Removes a slot from every column.
+ *
+ * @param slot The slot to remove. Following slots shift down by one.
+ */
+void ProductStore::erase(std::size_t slot)
+{
+    auto at = [slot](auto &column) { column.erase(column.begin() + static_cast<std::ptrdiff_t>(slot)); };
+    at(ids_);
+    at(prices_);
+    at(quantities_);
+    at(weights_);
+    at(types_);
+    at(names_);
+    at(attributes_);
+}
+
+/**
+ * @brief Reorders all columns according to a permutation.
+ *
+ * @param order A permutation of slots; new slot i receives the data of old slot order[i].
+ */
+void ProductStore::permute(const std::vector<std::size_t> &order)
+{
+    gather(ids_, order);
+    gather(prices_, order);
+    gather(quantities_, order);
+    gather(weights_, order);
+    gather(types_, order);
+    gather(names_, order);
+    gather(attributes_, order);
+}
+
+/**
+ * @brief Pre-allocates room in every column.
+ *
+ * @param capacity The number of products to reserve space for.
+ */
+void ProductStore::reserve(std::size_t capacity)
+{
+    ids_.reserve(capacity);
+    prices_.reserve(capacity);
+    quantities_.reserve(capacity);
+    weights_.reserve(capacity);
+    types_.reserve(capacity);
+    names_.reserve(capacity);
+    attributes_.reserve(capacity);
+}
+
+/**
+ * @brief Copies the hot price and quantity of a slot into a Product object.
+ *
+ * Used by Warehouse to refresh its Product view after bulk column operations.
+ *
+ * @param slot The slot to read from.
+ * @param product The product object to update.
+ */
+void ProductStore::writeBack(std::size_t slot, Product &product) const
+{
+    product.price_ = prices_[slot];
+    product.quantity_ = quantities_[slot];
+}
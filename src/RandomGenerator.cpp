@@ -1,49 +1,213 @@
 #include "RandomGenerator.hpp"
+#include <atomic>
+#include <chrono>
+
+namespace
+{
+    /**
+     * @brief Master seed shared by every thread's engine
+     *
+     * The generation counts calls to RandomGenerator::seed(); a thread whose
+     * engine was seeded in an older generation reseeds before its next draw.
+     */
+    struct SeedState
+    {
+        std::atomic<std::uint64_t> masterSeed{static_cast<std::uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count())};
+        std::atomic<std::uint64_t> generation{0};
+        std::atomic<std::uint64_t> nextStream{0};
+    };
+
+    SeedState &seedState()
+    {
+        static SeedState state;
+        return state;
+    }
+
+    /**
+     * @brief The calling thread's engine, with the stream and generation it was seeded for
+     */
+    struct ThreadEngine
+    {
+        std::uint64_t stream = seedState().nextStream.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t generation = ~std::uint64_t{0}; // Seeded on the first draw
+        Xoshiro256 engine;
+    };
+
+    thread_local ThreadEngine threadEngine;
+
+    // splitmix64 finaliser, so that neighbouring streams get unrelated seeds
+    std::uint64_t mix(std::uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    Xoshiro256 streamEngine(std::uint64_t masterSeed, std::uint64_t stream)
+    {
+        return Xoshiro256(masterSeed ^ mix(stream + 0x9E3779B97F4A7C15ull));
+    }
+
+    Xoshiro256 &engine()
+    {
+        SeedState &state = seedState();
+        const std::uint64_t generation = state.generation.load(std::memory_order_acquire);
+        if (threadEngine.generation != generation)
+        {
+            threadEngine.engine = streamEngine(state.masterSeed.load(std::memory_order_relaxed), threadEngine.stream);
+            threadEngine.generation = generation;
+        }
+        return threadEngine.engine;
+    }
+
+    /**
+     * @brief Number of values in [min, max], from 1 up to 2^32
+     */
+    std::uint64_t rangeSize(int min, int max)
+    {
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+    }
+
+    /**
+     * @brief Draws a uniform value below range with Lemire's multiply-and-reject method
+     *
+     * The high word of draw * range is a value below range. It would favour
+     * some values slightly, so draws whose low word falls under 2^64 mod range
+     * are rejected; that threshold is only computed when the low word is
+     * below range, which is rare.
+     */
+    std::uint64_t below(Xoshiro256 &engine, std::uint64_t range)
+    {
+        __extension__ using Wide = unsigned __int128;
+        Wide product = static_cast<Wide>(engine()) * range;
+        std::uint64_t low = static_cast<std::uint64_t>(product);
+        if (low < range)
+        {
+            const std::uint64_t threshold = (0 - range) % range;
+            while (low < threshold)
+            {
+                product = static_cast<Wide>(engine()) * range;
+                low = static_cast<std::uint64_t>(product);
+            }
+        }
+        return static_cast<std::uint64_t>(product >> 64);
+    }
+
+    /**
+     * @brief Converts the top 53 bits of a draw to a double in [0, 1)
+     */
+    double unit(std::uint64_t bits)
+    {
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+}
+
+/**
+ * @brief Sets the master seed and restarts every thread's engine from it.
+ *
+ * @param masterSeed The seed every stream is derived from.
+ */
+void RandomGenerator::seed(std::uint64_t masterSeed)
+{
+    SeedState &state = seedState();
+    state.masterSeed.store(masterSeed, std::memory_order_relaxed);
+    state.generation.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Gets the current master seed.
+ *
+ * @return std::uint64_t The seed, taken from the clock unless seed() was called.
+ */
+std::uint64_t RandomGenerator::masterSeed()
+{
+    return seedState().masterSeed.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Restarts the calling thread's engine at the given stream of the master seed.
+ *
+ * @param stream The stream number.
+ */
+void RandomGenerator::useStream(std::uint64_t stream)
+{
+    threadEngine.stream = stream;
+    threadEngine.generation = ~std::uint64_t{0};
+}
+
+/**
+ * @brief Creates a stand-alone engine for a stream of the master seed.
+ *
+ * @param stream The stream number.
+ * @return Xoshiro256 The engine.
+ */
+Xoshiro256 RandomGenerator::engineForStream(std::uint64_t stream)
+{
+    return streamEngine(masterSeed(), stream);
+}
+
+/**
+ * @brief Generates a random integer within a specified range.
+ *
+ * @param min The minimum value of the range.
+ * @param max The maximum value of the range.
+ * @return int A random integer between min and max (inclusive).
+ */
+int RandomGenerator::getRandomInt(int min, int max)
+{
+    return static_cast<int>(min + static_cast<std::int64_t>(below(engine(), rangeSize(min, max))));
+}
 
 /**
- * @brief Returns a reference to a static random number engine
- * 
- * This method initializes a static random number engine using the current time
- * as the seed and returns a reference to it. The engine is used for generating
- * random numbers.
- * 
- * @return A reference to a static std::mt19937 random number engine
+ * @brief Generates a random double within a specified range.
+ *
+ * @param min The minimum value of the range.
+ * @param max The maximum value of the range.
+ * @return double A random double between min (inclusive) and max (exclusive).
  */
-std::mt19937& RandomGenerator::getEngine() {
-    static std::mt19937 engine(
-        static_cast<unsigned>(
-            std::chrono::steady_clock::now().time_since_epoch().count()
-        )
-    );
-    return engine;
+double RandomGenerator::getRandomDouble(double min, double max)
+{
+    return min + unit(engine()()) * (max - min);
 }
 
 /**
- * @brief Generates a random integer within a specified range
- * 
- * This method generates a random integer between the specified minimum and
- * maximum values (inclusive) using a uniform integer distribution.
- * 
- * @param min The minimum value of the range
- * @param max The maximum value of the range
- * @return A random integer between min and max (inclusive)
+ * @brief Fills a span with random integers within a specified range.
+ *
+ * Works on a local copy of the thread's engine so that its state stays in
+ * registers through the loop.
+ *
+ * @param out The integers to overwrite.
+ * @param min The minimum value of the range.
+ * @param max The maximum value of the range.
  */
-int RandomGenerator::getRandomInt(int min, int max) {
-    std::uniform_int_distribution<> dist(min, max);
-    return dist(getEngine());
+void RandomGenerator::fillInts(std::span<int> out, int min, int max)
+{
+    Xoshiro256 &shared = engine();
+    Xoshiro256 local = shared;
+    const std::uint64_t range = rangeSize(min, max);
+    for (int &value : out)
+    {
+        value = static_cast<int>(min + static_cast<std::int64_t>(below(local, range)));
+    }
+    shared = local;
 }
 
 /**
- * @brief Generates a random double within a specified range
- * 
- * This method generates a random double between the specified minimum and
- * maximum values (inclusive) using a uniform real distribution.
- * 
- * @param min The minimum value of the range
- * @param max The maximum value of the range
- * @return A random double between min and max (inclusive)
+ * @brief Fills a span with random doubles within a specified range.
+ *
+ * @param out The doubles to overwrite.
+ * @param min The minimum value of the range.
+ * @param max The maximum value of the range (exclusive).
  */
-double RandomGenerator::getRandomDouble(double min, double max) {
-    std::uniform_real_distribution<double> dist(min, max);
-    return dist(getEngine());
+void RandomGenerator::fillDoubles(std::span<double> out, double min, double max)
+{
+    Xoshiro256 &shared = engine();
+    Xoshiro256 local = shared;
+    const double width = max - min;
+    for (double &value : out)
+    {
+        value = min + unit(local()) * width;
+    }
+    shared = local;
 }
@@ -0,0 +1,94 @@
+#include "Repricing.hpp"
+#include <algorithm> // For std::min, std::max
+#include <limits>
+
+namespace
+{
+    /**
+     * @brief Runs kernel with the element-wise operation described by adjustment
+     *
+     * The switch happens once per column, never per element, so each kernel
+     * instantiation is a straight loop over a single arithmetic operation.
+     * Operations work on whole cents; Multiply rounds half to even. Multiply
+     * and Add saturate instead of overflowing: Multiply goes through
+     * Money::scaleCents, which only leaves 64-bit arithmetic for a product
+     * that does not fit, and Add clamps its operand first so the sum stays in
+     * range.
+     */
+    template <typename Kernel>
+    void dispatch(const PriceAdjustment &adjustment, Kernel kernel)
+    {
+        constexpr std::int64_t lowest = std::numeric_limits<std::int64_t>::min();
+        constexpr std::int64_t highest = std::numeric_limits<std::int64_t>::max();
+        const std::int64_t a = adjustment.a;
+        const std::int64_t b = adjustment.b;
+        switch (adjustment.kind)
+        {
+        case PriceAdjustment::Kind::Multiply:
+            kernel([a](std::int64_t cents) { return Money::scaleCents(cents, a); });
+            break;
+        case PriceAdjustment::Kind::Add:
+            if (a >= 0)
+            {
+                kernel([a](std::int64_t cents) { return std::min(cents, highest - a) + a; });
+            }
+            else
+            {
+                kernel([a](std::int64_t cents) { return std::max(cents, lowest - a) + a; });
+            }
+            break;
+        case PriceAdjustment::Kind::Clamp:
+            kernel([a, b](std::int64_t cents) { return std::min(std::max(cents, a), b); });
+            break;
+        case PriceAdjustment::Kind::Set:
+            kernel([a](std::int64_t) { return a; });
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Applies an adjustment to every price in the column.
+ *
+ * Each result is clamped to 0 with std::max instead of a branch.
+ *
+ * @param prices The contiguous price column.
+ * @param adjustment The operation to apply.
+ */
+void Repricing::apply(std::span<Money> prices, const PriceAdjustment &adjustment)
+{
+    Money *const data = prices.data();
+    const std::size_t count = prices.size();
+    dispatch(adjustment, [data, count](auto op)
+             {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            data[i] = Money::fromCents(std::max<std::int64_t>(op(data[i].cents()), 0));
+        } });
+}
+
+/**
+ * @brief Applies an adjustment to the prices selected by a byte mask.
+ *
+ * Every price is computed and then blended with the old value depending on the
+ * mask, so the loop body has no branch and vectorises like the unmasked one.
+ *
+ * @param prices The contiguous price column.
+ * @param mask One byte per price; non-zero selects the price.
+ * @param adjustment The operation to apply.
+ */
+void Repricing::applyMasked(std::span<Money> prices, std::span<const std::uint8_t> mask,
+                            const PriceAdjustment &adjustment)
+{
+    Money *const data = prices.data();
+    const std::uint8_t *const selected = mask.data();
+    const std::size_t count = std::min(prices.size(), mask.size());
+    dispatch(adjustment, [data, selected, count](auto op)
+             {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::int64_t cents = data[i].cents();
+            const std::int64_t adjusted = std::max<std::int64_t>(op(cents), 0);
+            data[i] = Money::fromCents(selected[i] ? adjusted : cents);
+        } });
+}
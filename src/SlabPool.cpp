@@ -0,0 +1,106 @@
+#include "SlabPool.hpp"
+#include <utility> // For std::exchange
+
+/**
+ * @brief Takes over the slabs of another pool, leaving it empty.
+ *
+ * @param other The pool to move from.
+ */
+SlabPool::SlabPool(SlabPool &&other) noexcept
+    : slabs_(std::move(other.slabs_)),
+      free_(std::exchange(other.free_, {})),
+      cursor_(std::exchange(other.cursor_, nullptr)),
+      remaining_(std::exchange(other.remaining_, 0)),
+      live_(std::exchange(other.live_, 0))
+{
+    other.slabs_.clear();
+}
+
+/**
+ * @brief Frees this pool's slabs and takes over those of another pool.
+ *
+ * @param other The pool to move from.
+ * @return SlabPool& This pool.
+ */
+SlabPool &SlabPool::operator=(SlabPool &&other) noexcept
+{
+    if (this != &other)
+    {
+        slabs_ = std::move(other.slabs_);
+        other.slabs_.clear();
+        free_ = std::exchange(other.free_, {});
+        cursor_ = std::exchange(other.cursor_, nullptr);
+        remaining_ = std::exchange(other.remaining_, 0);
+        live_ = std::exchange(other.live_, 0);
+    }
+    return *this;
+}
+
+/**
+ * @brief Hands out uninitialised storage.
+ *
+ * Takes the head of the size class's free list if there is one, and otherwise
+ * carves the object from the newest slab, starting a new slab when it is full
+ * (the few bytes left in the old one are not used).
+ *
+ * @param size The object size in bytes; the object's alignment must be at most granularity.
+ * @return void* The storage.
+ */
+void *SlabPool::allocate(std::size_t size)
+{
+    if (size > maxObjectSize)
+    {
+        return ::operator new(size);
+    }
+    ++live_;
+    FreeSlot *&head = free_[classOf(size)];
+    if (head)
+    {
+        return std::exchange(head, head->next);
+    }
+    const std::size_t rounded = (classOf(size) + 1) * granularity;
+    if (remaining_ < rounded)
+    {
+        // operator new[] of std::byte aligns to __STDCPP_DEFAULT_NEW_ALIGNMENT__, which is at least granularity
+        static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= granularity);
+        slabs_.push_back(std::make_unique_for_overwrite<std::byte[]>(slabSize));
+        cursor_ = slabs_.back().get();
+        remaining_ = slabSize;
+    }
+    remaining_ -= rounded;
+    return std::exchange(cursor_, cursor_ + rounded);
+}
+
+/**
+ * @brief Returns storage to the free list of its size class.
+ *
+ * @param block Storage obtained from allocate() with the same size.
+ * @param size The object size in bytes.
+ */
+void SlabPool::deallocate(void *block, std::size_t size) noexcept
+{
+    if (!block)
+    {
+        return;
+    }
+    if (size > maxObjectSize)
+    {
+        ::operator delete(block, size);
+        return;
+    }
+    --live_;
+    FreeSlot *&head = free_[classOf(size)];
+    head = ::new (block) FreeSlot{head};
+}
+
+/**
+ * @brief Frees every slab at once.
+ */
+void SlabPool::release() noexcept
+{
+    slabs_.clear();
+    free_ = {};
+    cursor_ = nullptr;
+    remaining_ = 0;
+    live_ = 0;
+}
@@ -0,0 +1,457 @@
+#include "Snapshot.hpp"
+#include "Warehouse.hpp"
+#include "OrderManager.hpp"
+#include "ProductStore.hpp"
+#include "DirectorySync.hpp"
+#include <algorithm>  // For std::max, std::all_of
+#include <cstring>    // For std::memcmp, std::memcpy
+#include <filesystem> // For std::filesystem::rename
+#include <fstream>
+#include <type_traits> // For std::is_trivially_copyable_v
+#include <unordered_map>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#define SNAPSHOT_USE_POSIX_IO 1
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace SnapshotFormat;
+
+static_assert(sizeof(int) == sizeof(std::int32_t), "Snapshot columns store int as int32");
+static_assert(sizeof(Header) == 32 && sizeof(SectionEntry) == 24, "Snapshot structs must have a fixed layout");
+
+namespace
+{
+    constexpr std::uint64_t sectionAlignment = 8;
+
+    std::uint64_t alignUp(std::uint64_t value)
+    {
+        return (value + sectionAlignment - 1) & ~(sectionAlignment - 1);
+    }
+
+    /**
+     * @brief A section waiting to be written: its table entry plus the bytes to copy
+     */
+    struct PendingSection
+    {
+        SectionEntry entry;
+        const void *data;
+    };
+
+    // The price column is written as-is and read back as int64 cents
+    static_assert(sizeof(Money) == sizeof(std::int64_t) && std::is_trivially_copyable_v<Money>);
+
+    template <typename T>
+    PendingSection section(SectionKind kind, std::span<const T> elements)
+    {
+        return {{kind, static_cast<std::uint32_t>(sizeof(T)), 0, elements.size()}, elements.data()};
+    }
+
+    /**
+     * @brief Collects strings into one pool, storing each distinct value once
+     *
+     * Attribute values such as sizes and warranties repeat across many products,
+     * so deduplication keeps the pool small.
+     */
+    class StringPoolBuilder
+    {
+        std::vector<char> bytes_;
+        std::unordered_map<std::string_view, StringRef> seen_; // Views into the store being encoded
+        std::unordered_map<InternedString, StringRef> interned_;
+
+    public:
+        StringRef add(std::string_view value)
+        {
+            auto [it, inserted] = seen_.try_emplace(value);
+            if (inserted)
+            {
+                it->second = {static_cast<std::uint32_t>(bytes_.size()), static_cast<std::uint32_t>(value.size())};
+                bytes_.insert(bytes_.end(), value.begin(), value.end());
+            }
+            return it->second;
+        }
+
+        /**
+         * @brief Adds an interned string; repeats are found by handle without touching the text
+         */
+        StringRef add(InternedString value)
+        {
+            auto [it, inserted] = interned_.try_emplace(value);
+            if (inserted)
+            {
+                it->second = add(std::string_view(value.str()));
+            }
+            return it->second;
+        }
+
+        std::span<const char> bytes() const { return bytes_; }
+    };
+
+    /**
+     * @brief Returns a span over a section if its kind and element size match, or an error
+     */
+    template <typename T>
+    std::expected<std::span<const T>, std::string> bind(std::string_view file, const SectionEntry &entry)
+    {
+        if (entry.elementSize != sizeof(T))
+            return std::unexpected("Section " + std::to_string(static_cast<std::uint32_t>(entry.kind)) +
+                                   " has an unexpected element size");
+        if (entry.offset % alignof(T) != 0)
+            return std::unexpected("Section " + std::to_string(static_cast<std::uint32_t>(entry.kind)) +
+                                   " is misaligned");
+        if (entry.offset > file.size() || entry.count > (file.size() - entry.offset) / sizeof(T))
+            return std::unexpected("Section " + std::to_string(static_cast<std::uint32_t>(entry.kind)) +
+                                   " extends past the end of the file");
+        return std::span<const T>(reinterpret_cast<const T *>(file.data() + entry.offset),
+                                  static_cast<std::size_t>(entry.count));
+    }
+}
+
+/**
+ * @brief Maps and validates a snapshot file.
+ *
+ * @param path The snapshot file to open.
+ * @return std::expected<SnapshotView, std::string> The view, or an error message.
+ */
+std::expected<SnapshotView, std::string> SnapshotView::open(const std::string &path)
+{
+    auto file = MappedFile::open(path);
+    if (!file)
+    {
+        return std::unexpected(file.error());
+    }
+    SnapshotView view(std::move(*file));
+    if (auto bound = view.bindSections(); !bound)
+    {
+        return std::unexpected(path + ": " + bound.error());
+    }
+    return view;
+}
+
+/**
+ * @brief Validates the header and section table and points the spans into the mapping.
+ *
+ * Besides bounds and alignment, this checks that all product columns have the
+ * same length, that every string reference lies inside the string pool and
+ * that the order offsets describe valid ranges of order lines, so the accessors
+ * can index without further checks.
+ *
+ * @return std::expected<void, std::string> Nothing on success, or what is wrong with the file.
+ */
+std::expected<void, std::string> SnapshotView::bindSections()
+{
+    const std::string_view bytes = file_.view();
+    if (bytes.size() < sizeof(Header))
+        return std::unexpected("file is too small to be a snapshot");
+
+    Header header;
+    std::memcpy(&header, bytes.data(), sizeof(Header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+        return std::unexpected("not a snapshot file");
+    if (header.byteOrder != byteOrderMark)
+        return std::unexpected("snapshot was written on a machine with a different byte order");
+    if (header.version == 0 || header.version > currentVersion)
+        return std::unexpected("unsupported snapshot version " + std::to_string(header.version));
+    if (header.fileSize != bytes.size())
+        return std::unexpected("snapshot is truncated");
+    if (header.sectionCount > (bytes.size() - sizeof(Header)) / sizeof(SectionEntry))
+        return std::unexpected("section table extends past the end of the file");
+    version_ = header.version;
+
+    auto table = reinterpret_cast<const SectionEntry *>(bytes.data() + sizeof(Header));
+    for (std::uint32_t i = 0; i < header.sectionCount; ++i)
+    {
+        const SectionEntry &entry = table[i];
+        std::expected<void, std::string> bound;
+        auto assign = [&](auto &target, auto result)
+        {
+            if (result)
+                target = *result;
+            else
+                bound = std::unexpected(result.error());
+        };
+        switch (entry.kind)
+        {
+        case SectionKind::ProductIds:        assign(ids_, bind<std::int32_t>(bytes, entry)); break;
+        case SectionKind::ProductPrices:     assign(legacyPrices_, bind<double>(bytes, entry)); break;
+        case SectionKind::ProductPriceCents: assign(priceCents_, bind<std::int64_t>(bytes, entry)); break;
+        case SectionKind::ProductQuantities: assign(quantities_, bind<std::int32_t>(bytes, entry)); break;
+        case SectionKind::ProductWeights:    assign(weights_, bind<double>(bytes, entry)); break;
+        case SectionKind::ProductTypes:      assign(types_, bind<std::uint8_t>(bytes, entry)); break;
+        case SectionKind::ProductNames:      assign(names_, bind<StringRef>(bytes, entry)); break;
+        case SectionKind::ProductAttributes: assign(attributes_, bind<StringRef>(bytes, entry)); break;
+        case SectionKind::StringPool:        assign(stringPool_, bind<char>(bytes, entry)); break;
+        case SectionKind::OrderOffsets:      assign(orderOffsets_, bind<std::uint64_t>(bytes, entry)); break;
+        case SectionKind::OrderLines:        assign(orderLines_, bind<OrderLine>(bytes, entry)); break;
+        case SectionKind::OrderStatuses:     assign(orderStatuses_, bind<std::uint8_t>(bytes, entry)); break;
+        default: break; // Sections added by later versions are skipped
+        }
+        if (!bound)
+            return bound;
+    }
+
+    const std::size_t count = ids_.size();
+    const std::size_t priceCount = priceCents_.empty() ? legacyPrices_.size() : priceCents_.size();
+    if (priceCount != count || quantities_.size() != count || weights_.size() != count ||
+        types_.size() != count || names_.size() != count || attributes_.size() != count)
+        return std::unexpected("product columns have different lengths");
+
+    auto inPool = [this](StringRef ref)
+    { return ref.offset <= stringPool_.size() && ref.length <= stringPool_.size() - ref.offset; };
+    if (!std::all_of(names_.begin(), names_.end(), inPool) ||
+        !std::all_of(attributes_.begin(), attributes_.end(), inPool))
+        return std::unexpected("string reference outside the string pool");
+    if (!std::all_of(types_.begin(), types_.end(),
+                     [](std::uint8_t t) { return t <= static_cast<std::uint8_t>(ProductType::Other); }))
+        return std::unexpected("unknown product type tag");
+    {
+        std::vector<std::int32_t> sortedIds(ids_.begin(), ids_.end());
+        std::sort(sortedIds.begin(), sortedIds.end());
+        if (std::adjacent_find(sortedIds.begin(), sortedIds.end()) != sortedIds.end())
+            return std::unexpected("duplicate product ID");
+    }
+
+    if (!orderOffsets_.empty())
+    {
+        if (orderOffsets_.front() != 0 || orderOffsets_.back() != orderLines_.size() ||
+            !std::is_sorted(orderOffsets_.begin(), orderOffsets_.end()))
+            return std::unexpected("order offsets do not match the order lines");
+    }
+    else if (!orderLines_.empty())
+        return std::unexpected("order lines without order offsets");
+    if (!orderStatuses_.empty())
+    {
+        if (orderStatuses_.size() != orderCount())
+            return std::unexpected("order statuses do not match the orders");
+        if (!std::all_of(orderStatuses_.begin(), orderStatuses_.end(),
+                         [](std::uint8_t s) { return s <= static_cast<std::uint8_t>(OrderStatus::Backordered); }))
+            return std::unexpected("unknown order status");
+    }
+    return {};
+}
+
+/**
+ * @brief Serialises the warehouse and all orders into snapshot bytes.
+ *
+ * The product columns are copied straight from the warehouse's ProductStore;
+ * names and attributes go into a deduplicated string pool.
+ *
+ * @param warehouse The warehouse whose products are saved.
+ * @param orderManager The orders to save.
+ * @return std::vector<char> The complete snapshot file contents.
+ */
+std::vector<char> Snapshot::encode(const Warehouse &warehouse, const OrderManager &orderManager)
+{
+    const ProductStore &store = warehouse.getStore();
+    const std::size_t count = store.size();
+
+    StringPoolBuilder pool;
+    std::vector<StringRef> names(count), attributes(count);
+    auto attributeHandles = store.attributeHandles();
+    for (std::size_t slot = 0; slot < count; ++slot)
+    {
+        names[slot] = pool.add(store.name(slot));
+        attributes[slot] = pool.add(attributeHandles[slot]);
+    }
+
+    std::vector<std::uint64_t> orderOffsets{0};
+    std::vector<OrderLine> orderLines;
+    std::vector<std::uint8_t> orderStatuses;
+    orderStatuses.reserve(orderManager.getOrders().size());
+    for (const Order &order : orderManager.getOrders())
+    {
+        for (const auto &[productId, quantity] : order.getItems())
+        {
+            orderLines.push_back({productId, quantity});
+        }
+        orderOffsets.push_back(orderLines.size());
+        orderStatuses.push_back(static_cast<std::uint8_t>(orderManager.getStatus(orderStatuses.size())));
+    }
+
+    auto types = store.types();
+    std::vector<PendingSection> sections = {
+        section(SectionKind::ProductIds, store.ids()),
+        section(SectionKind::ProductPriceCents, store.prices()),
+        section(SectionKind::ProductQuantities, store.quantities()),
+        section(SectionKind::ProductWeights, store.weights()),
+        section(SectionKind::ProductTypes,
+                std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t *>(types.data()), types.size())),
+        section(SectionKind::ProductNames, std::span<const StringRef>(names)),
+        section(SectionKind::ProductAttributes, std::span<const StringRef>(attributes)),
+        section(SectionKind::StringPool, pool.bytes()),
+        section(SectionKind::OrderOffsets, std::span<const std::uint64_t>(orderOffsets)),
+        section(SectionKind::OrderLines, std::span<const OrderLine>(orderLines)),
+        section(SectionKind::OrderStatuses, std::span<const std::uint8_t>(orderStatuses)),
+    };
+
+    // Lay the sections out one after another, each at an aligned offset
+    std::uint64_t offset = alignUp(sizeof(Header) + sections.size() * sizeof(SectionEntry));
+    for (PendingSection &pending : sections)
+    {
+        pending.entry.offset = offset;
+        offset = alignUp(offset + pending.entry.count * pending.entry.elementSize);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = currentVersion;
+    header.byteOrder = byteOrderMark;
+    header.sectionCount = static_cast<std::uint32_t>(sections.size());
+    header.fileSize = offset;
+
+    std::vector<char> bytes(static_cast<std::size_t>(header.fileSize), '\0'); // Padding stays zero
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    char *table = bytes.data() + sizeof(header);
+    for (const PendingSection &pending : sections)
+    {
+        std::memcpy(table, &pending.entry, sizeof(SectionEntry));
+        table += sizeof(SectionEntry);
+        if (pending.entry.count > 0)
+        {
+            std::memcpy(bytes.data() + pending.entry.offset, pending.data,
+                        static_cast<std::size_t>(pending.entry.count * pending.entry.elementSize));
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief Durably writes snapshot bytes to a file.
+ *
+ * The bytes go to path + ".tmp", which is flushed to stable storage (fsync on
+ * POSIX systems) and then renamed over path. The directory is flushed after
+ * the rename, so once this returns the new file survives a crash under its
+ * final name.
+ *
+ * @param path The snapshot file to write.
+ * @param bytes The snapshot contents, as produced by encode().
+ * @return std::expected<void, std::string> Nothing on success, or an error message.
+ */
+std::expected<void, std::string> Snapshot::writeFile(const std::string &path, std::span<const char> bytes)
+{
+    const std::string temporary = path + ".tmp";
+#ifdef SNAPSHOT_USE_POSIX_IO
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return std::unexpected("Cannot open file for writing: " + temporary);
+    }
+    const char *data = bytes.data();
+    std::size_t remaining = bytes.size();
+    while (remaining > 0)
+    {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            ::close(fd);
+            return std::unexpected("Error while writing snapshot: " + temporary);
+        }
+        data += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!synced)
+    {
+        return std::unexpected("Cannot flush snapshot to disk: " + temporary);
+    }
+#else
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            return std::unexpected("Cannot open file for writing: " + temporary);
+        }
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!out.good())
+        {
+            return std::unexpected("Error while writing snapshot: " + temporary);
+        }
+    }
+#endif
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec)
+    {
+        return std::unexpected("Cannot replace " + path + ": " + ec.message());
+    }
+    return syncDirectory(std::filesystem::path(path).parent_path());
+}
+
+/**
+ * @brief Writes the warehouse and all orders to a binary snapshot file.
+ *
+ * @param path The snapshot file to write.
+ * @param warehouse The warehouse whose products are saved.
+ * @param orderManager The orders to save.
+ * @return std::expected<void, std::string> Nothing on success, or an error message.
+ */
+std::expected<void, std::string> Snapshot::save(const std::string &path, const Warehouse &warehouse,
+                                                const OrderManager &orderManager)
+{
+    return writeFile(path, encode(warehouse, orderManager));
+}
+
+/**
+ * @brief Replaces the contents of a warehouse and order manager with a snapshot.
+ *
+ * The product columns are copied from the mapped sections into a ProductStore
+ * in one pass and handed to Warehouse::assign, which builds the Product view
+ * and each index in bulk. Products keep the IDs recorded in the snapshot, so
+ * orders and later journals keep referring to the same products.
+ *
+ * @param view The snapshot to restore.
+ * @param warehouse The warehouse to fill.
+ * @param orderManager The order manager to fill.
+ */
+void Snapshot::restore(const SnapshotView &view, Warehouse &warehouse, OrderManager &orderManager)
+{
+    orderManager = OrderManager();
+
+    ProductStore store;
+    store.assign(view); // Products of unknown subclasses cannot be re-created and are skipped
+    warehouse.assign(std::move(store));
+
+    for (std::size_t i = 0; i < view.orderCount(); ++i)
+    {
+        Order order;
+        for (const OrderLine &line : view.orderLines(i))
+        {
+            order.addItem(line.productId, line.quantity);
+        }
+        orderManager.createOrder(order);
+    }
+    if (auto statuses = view.orderStatuses(); !statuses.empty())
+    {
+        std::vector<OrderStatus> restored(statuses.size());
+        std::transform(statuses.begin(), statuses.end(), restored.begin(),
+                       [](std::uint8_t s) { return static_cast<OrderStatus>(s); });
+        orderManager.setStatuses(restored);
+    }
+}
+
+/**
+ * @brief Opens a snapshot file and restores it.
+ *
+ * @param path The snapshot file to read.
+ * @param warehouse The warehouse to fill.
+ * @param orderManager The order manager to fill.
+ * @return std::expected<void, std::string> Nothing on success, or an error message.
+ */
+std::expected<void, std::string> Snapshot::load(const std::string &path, Warehouse &warehouse,
+                                                OrderManager &orderManager)
+{
+    auto view = SnapshotView::open(path);
+    if (!view)
+    {
+        return std::unexpected(view.error());
+    }
+    restore(*view, warehouse, orderManager);
+    return {};
+}
@@ -0,0 +1,87 @@
+#include "StringArena.hpp"
+#include <cstring> // For std::memcpy
+#include <utility> // For std::exchange
+
+/**
+ * @brief Takes over the chunks of another arena, leaving it empty.
+ *
+ * @param other The arena to move from.
+ */
+StringArena::StringArena(StringArena &&other) noexcept
+    : chunks_(std::move(other.chunks_)),
+      cursor_(std::exchange(other.cursor_, nullptr)),
+      remaining_(std::exchange(other.remaining_, 0)),
+      bytesUsed_(std::exchange(other.bytesUsed_, 0)),
+      bytesReserved_(std::exchange(other.bytesReserved_, 0))
+{
+    other.chunks_.clear();
+}
+
+/**
+ * @brief Frees this arena's chunks and takes over those of another arena.
+ *
+ * @param other The arena to move from.
+ * @return StringArena& This arena.
+ */
+StringArena &StringArena::operator=(StringArena &&other) noexcept
+{
+    if (this != &other)
+    {
+        chunks_ = std::move(other.chunks_);
+        other.chunks_.clear();
+        cursor_ = std::exchange(other.cursor_, nullptr);
+        remaining_ = std::exchange(other.remaining_, 0);
+        bytesUsed_ = std::exchange(other.bytesUsed_, 0);
+        bytesReserved_ = std::exchange(other.bytesReserved_, 0);
+    }
+    return *this;
+}
+
+/**
+ * @brief Copies a string into the arena.
+ *
+ * Strings longer than a quarter of a chunk get a dedicated chunk, so a long
+ * string never wastes the tail of the current one.
+ *
+ * @param text The string to copy.
+ * @return std::string_view A view of the copy, valid until reset().
+ */
+std::string_view StringArena::store(std::string_view text)
+{
+    if (text.empty())
+    {
+        return {};
+    }
+    bytesUsed_ += text.size();
+    if (text.size() > chunkSize / 4)
+    {
+        chunks_.push_back(std::make_unique_for_overwrite<char[]>(text.size()));
+        bytesReserved_ += text.size();
+        std::memcpy(chunks_.back().get(), text.data(), text.size());
+        return {chunks_.back().get(), text.size()};
+    }
+    if (remaining_ < text.size())
+    {
+        chunks_.push_back(std::make_unique_for_overwrite<char[]>(chunkSize));
+        bytesReserved_ += chunkSize;
+        cursor_ = chunks_.back().get();
+        remaining_ = chunkSize;
+    }
+    char *copy = cursor_;
+    std::memcpy(copy, text.data(), text.size());
+    cursor_ += text.size();
+    remaining_ -= text.size();
+    return {copy, text.size()};
+}
+
+/**
+ * @brief Frees every chunk at once.
+ */
+void StringArena::reset()
+{
+    chunks_.clear();
+    cursor_ = nullptr;
+    remaining_ = 0;
+    bytesUsed_ = 0;
+    bytesReserved_ = 0;
+}
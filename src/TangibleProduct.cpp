@@ -8,9 +8,11 @@
  * @param price The price of the tangible product.
  * @param quantity The quantity of the tangible product in inventory.
  * @param weight The weight of the tangible product.
+ * @param type The concrete subclass being constructed.
  */
-TangibleProduct::TangibleProduct(const std::string& name, double price, int quantity, double weight)
-    : Product(name, price, quantity), weight_(weight)
+TangibleProduct::TangibleProduct(const std::string& name, Money price, int quantity, double weight,
+                                 ProductType type)
+    : Product(name, price, quantity, type), weight_(weight)
 {
     if (weight_ < 0)
     {
@@ -31,7 +33,7 @@ TangibleProduct::~TangibleProduct() {} // Default implementation is fine.
  * * @param other The TangibleProduct object to copy from.
  */
 TangibleProduct::TangibleProduct(const TangibleProduct &other)
-    : Product(other.name_, other.price_, other.quantity_), // Calls Product constructor, gets new ID
+    : Product(std::string(other.name_), other.price_, other.quantity_, other.type_), // Calls Product constructor, gets new ID
       weight_(other.weight_)
 {
     // productId_ is handled by Product constructor
@@ -46,12 +48,11 @@ TangibleProduct::TangibleProduct(const TangibleProduct &other)
  * * @param other The TangibleProduct object to move from.
  */
 TangibleProduct::TangibleProduct(TangibleProduct &&other) noexcept
-    : Product(std::move(other.name_), other.price_, other.quantity_), // name_ is moved, price/qty copied, new ID from Product ctor
+    : Product(std::string(other.name_), other.price_, other.quantity_, other.type_), // name copied (name_ is a view), price/qty copied, new ID from Product ctor
       weight_(other.weight_)
 {
     // Reset other's members that were copied or might hold significant value
-    // other.name_ is already moved from.
-    other.price_    = 0.0;
+    other.price_    = Money();
     other.quantity_ = 0;
     other.weight_   = 0.0;
     // other.productId_ remains, but this new object has a different productId_.
@@ -69,7 +70,7 @@ TangibleProduct& TangibleProduct::operator=(const TangibleProduct& other) {
         // Call base class assignment operator if it exists and makes sense
         // Product::operator=(other); // If Product had one.
         // For now, assign Product members directly (except productId_).
-        name_     = other.name_;
+        setName(std::string(other.name_)); // name_ is a view, so the characters are copied
         price_    = other.price_;
         quantity_ = other.quantity_;
         // productId_ is not changed by assignment of content.
@@ -90,7 +91,7 @@ TangibleProduct& TangibleProduct::operator=(const TangibleProduct& other) {
 TangibleProduct& TangibleProduct::operator=(TangibleProduct&& other) noexcept {
     if (this != &other) {
         // Product::operator=(std::move(other)); // If Product had one
-        name_     = std::move(other.name_);
+        setName(std::string(other.name_)); // name_ is a view, so the characters are copied
         price_    = other.price_;
         quantity_ = other.quantity_;
         // productId_ is not changed by assignment of content.
@@ -98,8 +99,7 @@ TangibleProduct& TangibleProduct::operator=(TangibleProduct&& other) noexcept {
         weight_ = other.weight_; // Assign TangibleProduct specific members
 
         // Reset other's members
-        // other.name_ is already moved from.
-        other.price_    = 0.0;
+        other.price_    = Money();
         other.quantity_ = 0;
         other.weight_   = 0.0;
     }
@@ -0,0 +1,280 @@
+#include "TaskScheduler.hpp"
+
+namespace
+{
+    // The scheduler and queue of the worker running on this thread, if any
+    thread_local const TaskScheduler *currentScheduler = nullptr;
+    thread_local std::size_t currentQueue = 0;
+
+    // Rounds a worker spends looking for work before it goes to sleep
+    constexpr int idleRounds = 64;
+}
+
+/**
+ * @brief Starts a scheduler.
+ *
+ * @param threads The number of threads that run tasks, counting the caller (at least 1).
+ */
+TaskScheduler::TaskScheduler(std::size_t threads)
+{
+    start(threads);
+}
+
+/**
+ * @brief Stops and joins the workers.
+ */
+TaskScheduler::~TaskScheduler()
+{
+    stop();
+}
+
+/**
+ * @brief Gets the scheduler the bulk operations use.
+ *
+ * @return TaskScheduler& A scheduler with one thread per hardware thread.
+ */
+TaskScheduler &TaskScheduler::global()
+{
+    static TaskScheduler scheduler(std::thread::hardware_concurrency());
+    return scheduler;
+}
+
+/**
+ * @brief Gets the grain sizes the bulk operations use.
+ *
+ * @return ParallelGrains& The process-wide settings.
+ */
+ParallelGrains &TaskScheduler::grains()
+{
+    static ParallelGrains grains;
+    return grains;
+}
+
+/**
+ * @brief Replaces the workers so that the given number of threads run tasks.
+ *
+ * @param threads The new thread count, counting the caller (at least 1).
+ */
+void TaskScheduler::setThreadCount(std::size_t threads)
+{
+    stop();
+    start(threads);
+}
+
+/**
+ * @brief Creates one queue per thread and starts a worker for every queue but the first.
+ */
+void TaskScheduler::start(std::size_t threads)
+{
+    threads = std::max<std::size_t>(threads, 1);
+    stopping_ = false;
+    queues_.clear();
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+    for (std::size_t queue = 1; queue < threads; ++queue)
+    {
+        workers_.emplace_back([this, queue] { workerLoop(queue); });
+    }
+}
+
+/**
+ * @brief Wakes every worker, tells it to exit and joins it.
+ */
+void TaskScheduler::stop()
+{
+    {
+        std::lock_guard lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_)
+    {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+/**
+ * @brief Gets the queue of the calling thread: its own for a worker, 0 for any other thread.
+ */
+std::size_t TaskScheduler::ownQueue() const
+{
+    return currentScheduler == this ? currentQueue : 0;
+}
+
+/**
+ * @brief Pushes a task onto the back of the calling thread's queue.
+ *
+ * The task is wrapped so that it records the first exception of its group
+ * and then counts itself as done. A sleeping worker is woken only if there
+ * is one: the count of queued tasks is raised before the sleepers are
+ * counted, and a worker counts itself as a sleeper before it checks the
+ * queued tasks, so one of the two always sees the other.
+ *
+ * @param group The group the task belongs to.
+ * @param task The work to run.
+ */
+void TaskScheduler::spawn(TaskGroup &group, std::function<void()> task)
+{
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    auto wrapped = [&group, task = std::move(task)]
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            std::lock_guard lock(group.errorMutex);
+            if (!group.error)
+                group.error = std::current_exception();
+        }
+        group.pending.fetch_sub(1, std::memory_order_release);
+    };
+    TaskQueue &queue = *queues_[ownQueue()];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(wrapped));
+    }
+    queued_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard lock(sleepMutex_);
+        wake_.notify_one();
+    }
+}
+
+/**
+ * @brief Runs one queued task, if there is any.
+ *
+ * Takes the newest task of the thread's own queue, or else steals the oldest
+ * task of another queue, visiting the others in a fixed rotation.
+ *
+ * @param queue The calling thread's queue.
+ * @return bool Whether a task was run.
+ */
+bool TaskScheduler::runOne(std::size_t queue)
+{
+    std::function<void()> task;
+    {
+        TaskQueue &own = *queues_[queue];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (std::size_t offset = 1; !task && offset < queues_.size(); ++offset)
+    {
+        TaskQueue &victim = *queues_[(queue + offset) % queues_.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+    if (!task)
+        return false;
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+/**
+ * @brief Runs queued tasks until every task of the group has finished.
+ *
+ * @param group The group to wait for; its first exception is rethrown.
+ */
+void TaskScheduler::wait(TaskGroup &group)
+{
+    const std::size_t queue = ownQueue();
+    while (group.pending.load(std::memory_order_acquire) != 0)
+    {
+        if (!runOne(queue))
+            std::this_thread::yield(); // The remaining tasks are running on other threads
+    }
+    if (group.error)
+        std::rethrow_exception(group.error);
+}
+
+/**
+ * @brief Runs tasks until the scheduler stops, sleeping while there are none.
+ *
+ * @param queue The worker's own queue.
+ */
+void TaskScheduler::workerLoop(std::size_t queue)
+{
+    currentScheduler = this;
+    currentQueue = queue;
+    for (;;)
+    {
+        bool ran = false;
+        for (int round = 0; round < idleRounds && !ran; ++round)
+        {
+            ran = runOne(queue);
+            if (!ran)
+                std::this_thread::yield();
+        }
+        if (ran)
+            continue;
+
+        std::unique_lock lock(sleepMutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        wake_.wait(lock, [this] { return stopping_ || queued_.load(std::memory_order_seq_cst) > 0; });
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        if (stopping_)
+            return;
+    }
+}
+
+/**
+ * @brief Runs the chunks [first, last), handing the upper halves to other threads.
+ *
+ * Each step spawns the upper half of the remaining chunks as one task, which
+ * splits again when it runs, so a thief always takes a large piece of work.
+ */
+void TaskScheduler::splitChunks(TaskGroup &group, std::size_t first, std::size_t last,
+                                const std::function<void(std::size_t)> &runChunk)
+{
+    while (last - first > 1)
+    {
+        const std::size_t middle = first + (last - first) / 2;
+        spawn(group, [this, &group, middle, last, &runChunk] { splitChunks(group, middle, last, runChunk); });
+        last = middle;
+    }
+    runChunk(first);
+}
+
+/**
+ * @brief Runs every chunk and waits for all of them.
+ *
+ * With a single thread, or a single chunk, the chunks run in order on the
+ * caller without creating any task.
+ *
+ * @param chunks The number of chunks.
+ * @param runChunk Called once with each chunk number.
+ */
+void TaskScheduler::runChunks(std::size_t chunks, const std::function<void(std::size_t)> &runChunk)
+{
+    if (chunks <= 1 || queues_.size() == 1)
+    {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+            runChunk(chunk);
+        return;
+    }
+    TaskGroup group;
+    try
+    {
+        splitChunks(group, 0, chunks, runChunk);
+    }
+    catch (...)
+    {
+        wait(group); // Let the spawned tasks finish before their captures go out of scope
+        throw;
+    }
+    wait(group);
+}
@@ -0,0 +1,430 @@
+#include "TrigramIndex.hpp"
+#include "ProductStore.hpp"
+#include <algorithm> // For std::sort, std::unique, std::push_heap, std::set_difference
+#include <iterator>  // For std::back_inserter
+#include <limits>    // For std::numeric_limits
+#include <numeric>   // For std::iota
+
+namespace
+{
+    constexpr std::int32_t exhausted = std::numeric_limits<std::int32_t>::max();
+
+    void putVarint(std::vector<std::uint8_t> &out, std::uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    std::uint32_t getVarint(const std::uint8_t *&pos)
+    {
+        std::uint32_t value = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            const std::uint8_t byte = *pos++;
+            value |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+            if (byte < 0x80)
+                return value;
+        }
+    }
+
+    /**
+     * @brief Folds ASCII letters to lower case; other bytes (digits, UTF-8) are kept
+     */
+    char fold(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    /**
+     * @brief Word characters: ASCII letters and digits, and every byte of a UTF-8 sequence
+     */
+    bool isWordChar(char c)
+    {
+        const auto byte = static_cast<unsigned char>(c);
+        return (byte >= '0' && byte <= '9') || (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') ||
+               byte >= 0x80;
+    }
+
+    std::uint32_t pack(char a, char b, char c)
+    {
+        return (static_cast<std::uint32_t>(static_cast<unsigned char>(a)) << 16) |
+               (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8) |
+               static_cast<std::uint32_t>(static_cast<unsigned char>(c));
+    }
+
+    std::size_t countCommon(const std::vector<std::uint32_t> &a, const std::vector<std::uint32_t> &b)
+    {
+        std::size_t common = 0;
+        for (std::size_t i = 0, j = 0; i < a.size() && j < b.size();)
+        {
+            if (a[i] < b[j])
+                ++i;
+            else if (b[j] < a[i])
+                ++j;
+            else
+            {
+                ++common;
+                ++i;
+                ++j;
+            }
+        }
+        return common;
+    }
+}
+
+/**
+ * @brief Forward-only reader over a posting list that can skip ahead
+ *
+ * The blocks and the pending list are read side by side; current() is the
+ * smaller of the two positions, so IDs come out in ascending order. seek()
+ * targets must not decrease. The block part is walked with the help of the
+ * block headers; the pending part with a binary search.
+ */
+class TrigramIndex::PostingList::Cursor
+{
+    const PostingList &list_;
+    std::size_t block_ = 0;
+    const std::uint8_t *pos_ = nullptr;
+    std::size_t remaining_ = 0; // Deltas left in the current block
+    std::int32_t inBlocks_ = exhausted;
+    std::size_t pending_ = 0;
+
+    void load(std::size_t block)
+    {
+        block_ = block;
+        inBlocks_ = list_.blocks_[block].first;
+        pos_ = list_.bytes_.data() + list_.blocks_[block].offset;
+        remaining_ = std::min<std::size_t>(blockSize, list_.count_ - block * blockSize) - 1;
+    }
+
+public:
+    explicit Cursor(const PostingList &list) : list_(list)
+    {
+        if (!list.blocks_.empty())
+            load(0);
+    }
+
+    /**
+     * @brief Gets the ID under the cursor, or exhausted past the end
+     */
+    std::int32_t current() const
+    {
+        const auto &pending = list_.pending_;
+        return pending_ < pending.size() ? std::min(inBlocks_, pending[pending_]) : inBlocks_;
+    }
+
+    /**
+     * @brief Advances to the first ID not below target
+     * @return true if target is in the list
+     */
+    bool seek(std::int32_t target)
+    {
+        if (inBlocks_ < target)
+        {
+            const auto &blocks = list_.blocks_;
+            if (block_ + 1 < blocks.size() && blocks[block_ + 1].first <= target)
+            {
+                // Last block whose first ID is not above target
+                auto next = std::upper_bound(blocks.begin() + static_cast<std::ptrdiff_t>(block_) + 1, blocks.end(),
+                                             target, [](std::int32_t id, const Block &b) { return id < b.first; });
+                load(static_cast<std::size_t>(next - blocks.begin()) - 1);
+            }
+            while (inBlocks_ < target && remaining_ > 0)
+            {
+                inBlocks_ += static_cast<std::int32_t>(getVarint(pos_));
+                --remaining_;
+            }
+            if (inBlocks_ < target)
+            {
+                if (block_ + 1 < blocks.size())
+                    load(block_ + 1); // Its first ID is above target
+                else
+                    inBlocks_ = exhausted;
+            }
+        }
+        const auto &pending = list_.pending_;
+        if (pending_ < pending.size() && pending[pending_] < target)
+        {
+            pending_ = static_cast<std::size_t>(
+                std::lower_bound(pending.begin() + static_cast<std::ptrdiff_t>(pending_), pending.end(), target) -
+                pending.begin());
+        }
+        return current() == target;
+    }
+};
+
+void TrigramIndex::PostingList::append(std::int32_t id)
+{
+    if (count_ % blockSize == 0)
+        blocks_.push_back({id, static_cast<std::uint32_t>(bytes_.size())});
+    else
+        putVarint(bytes_, static_cast<std::uint32_t>(id - last_));
+    last_ = id;
+    ++count_;
+}
+
+/**
+ * @brief Adds an ID, appending when it is the largest so far.
+ *
+ * A smaller ID goes to the pending list (unless it is already present) and
+ * the pending list is merged into the blocks once it reaches an eighth of
+ * their size, so merging costs amortised O(1) per ID.
+ */
+void TrigramIndex::PostingList::add(std::int32_t id)
+{
+    if (count_ == 0 || id > last_)
+    {
+        append(id);
+        return;
+    }
+    if (Cursor(*this).seek(id))
+        return; // Already present
+    pending_.insert(std::lower_bound(pending_.begin(), pending_.end(), id), id);
+    if (pending_.size() > std::max<std::size_t>(64, count_ / 8))
+        merge();
+}
+
+void TrigramIndex::PostingList::merge()
+{
+    std::vector<std::int32_t> ids;
+    ids.reserve(size());
+    collect(ids);
+    std::inplace_merge(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(count_), ids.end());
+    bytes_.clear();
+    blocks_.clear();
+    pending_.clear();
+    count_ = 0;
+    for (std::int32_t id : ids)
+        append(id);
+}
+
+void TrigramIndex::PostingList::collect(std::vector<std::int32_t> &out) const
+{
+    for (std::size_t block = 0; block < blocks_.size(); ++block)
+    {
+        std::int32_t id = blocks_[block].first;
+        const std::uint8_t *pos = bytes_.data() + blocks_[block].offset;
+        out.push_back(id);
+        const std::size_t deltas = std::min<std::size_t>(blockSize, count_ - block * blockSize) - 1;
+        for (std::size_t i = 0; i < deltas; ++i)
+        {
+            id += static_cast<std::int32_t>(getVarint(pos));
+            out.push_back(id);
+        }
+    }
+    out.insert(out.end(), pending_.begin(), pending_.end());
+}
+
+std::size_t TrigramIndex::PostingList::bytes() const
+{
+    return bytes_.capacity() + blocks_.capacity() * sizeof(Block) + pending_.capacity() * sizeof(std::int32_t);
+}
+
+/**
+ * @brief Computes the distinct trigrams of a text.
+ *
+ * @param text The text to split into padded, lower-cased words.
+ * @param out Receives the trigrams in ascending order, without duplicates.
+ */
+void TrigramIndex::trigrams(std::string_view text, std::vector<std::uint32_t> &out)
+{
+    out.clear();
+    std::size_t pos = 0;
+    while (pos < text.size())
+    {
+        if (!isWordChar(text[pos]))
+        {
+            ++pos;
+            continue;
+        }
+        std::size_t end = pos;
+        while (end < text.size() && isWordChar(text[end]))
+            ++end;
+        // Trigrams of "  word ": a = two characters back, b = one back, c = current
+        char a = ' ', b = ' ';
+        for (std::size_t i = pos; i <= end; ++i)
+        {
+            const char c = i < end ? fold(text[i]) : ' ';
+            out.push_back(pack(a, b, c));
+            a = b;
+            b = c;
+        }
+        pos = end;
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void TrigramIndex::add(int id, std::string_view name)
+{
+    std::vector<std::uint32_t> grams;
+    trigrams(name, grams);
+    for (std::uint32_t gram : grams)
+        lists_[gram].add(id);
+    livePostings_ += grams.size();
+}
+
+void TrigramIndex::remove(int /*id*/, std::string_view name)
+{
+    std::vector<std::uint32_t> grams;
+    trigrams(name, grams);
+    livePostings_ -= std::min(livePostings_, grams.size());
+    stalePostings_ += grams.size();
+}
+
+/**
+ * @brief Indexes the trigrams only the new name has; the ones only the old name had go stale.
+ */
+void TrigramIndex::rename(int id, std::string_view oldName, std::string_view newName)
+{
+    std::vector<std::uint32_t> before, after, added, dropped;
+    trigrams(oldName, before);
+    trigrams(newName, after);
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(added));
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(dropped));
+    for (std::uint32_t gram : added)
+        lists_[gram].add(id);
+    livePostings_ = livePostings_ + added.size() - std::min(livePostings_, dropped.size());
+    stalePostings_ += dropped.size();
+}
+
+void TrigramIndex::rebuild(const ProductStore &store)
+{
+    lists_.clear();
+    livePostings_ = 0;
+    stalePostings_ = 0;
+    auto ids = store.ids();
+    std::vector<std::size_t> order(ids.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [ids](std::size_t a, std::size_t b) { return ids[a] < ids[b]; });
+    for (std::size_t slot : order)
+        add(ids[slot], store.name(slot));
+}
+
+/**
+ * @brief Finds the names that best match a query.
+ *
+ * Walks the candidates in ascending ID order while keeping the best k in a
+ * heap. A name sharing at least t of the query's m trigrams must appear in
+ * one of the m - t + 1 shortest posting lists, so only those lists are
+ * enumerated; the longer ones are probed with seeks, cheapest first, and the
+ * probing stops as soon as the candidate cannot reach t. Once the heap is
+ * full, t rises to one more than the weakest kept hit (a later ID with the
+ * same score would lose the tie), which shrinks the enumerated lists; the
+ * walk ends when k names contain every trigram. Counts can include stale
+ * postings, so each candidate that reaches t is re-scored against its
+ * current name before it is kept.
+ *
+ * @param query The text to look for.
+ * @param k The largest number of results.
+ * @param nameOf Returns the current name of a product ID.
+ * @return std::vector<SearchHit> Up to k hits, best first.
+ */
+std::vector<SearchHit> TrigramIndex::search(std::string_view query, std::size_t k, const NameLookup &nameOf) const
+{
+    std::vector<std::uint32_t> wanted;
+    trigrams(query, wanted);
+    const std::size_t m = wanted.size();
+    if (m == 0 || k == 0)
+        return {};
+
+    static const PostingList empty;
+    std::vector<const PostingList *> lists;
+    lists.reserve(m);
+    for (std::uint32_t gram : wanted)
+    {
+        auto it = lists_.find(gram);
+        lists.push_back(it == lists_.end() ? &empty : &it->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const PostingList *a, const PostingList *b) { return a->size() < b->size(); });
+    std::vector<PostingList::Cursor> cursors;
+    cursors.reserve(m);
+    for (const PostingList *list : lists)
+        cursors.emplace_back(*list);
+
+    struct Ranked
+    {
+        std::int32_t id;
+        std::size_t common;
+    };
+    // Heap order: the weakest hit (fewest common trigrams, then highest ID) on top
+    auto better = [](const Ranked &a, const Ranked &b)
+    { return a.common != b.common ? a.common > b.common : a.id < b.id; };
+    std::vector<Ranked> heap;
+    heap.reserve(k + 1);
+
+    std::size_t threshold = (m + 1) / 2;
+    std::vector<std::uint32_t> grams;
+    while (threshold <= m)
+    {
+        const std::size_t essential = m - threshold + 1;
+        std::int32_t id = exhausted;
+        for (std::size_t i = 0; i < essential; ++i)
+            id = std::min(id, cursors[i].current());
+        if (id == exhausted)
+            break;
+
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < essential; ++i)
+        {
+            if (cursors[i].current() == id)
+            {
+                ++count;
+                cursors[i].seek(id + 1);
+            }
+        }
+        for (std::size_t i = essential; i < m && count + (m - i) >= threshold; ++i)
+        {
+            if (cursors[i].seek(id))
+                ++count;
+            else if (threshold == m)
+                cursors[0].seek(cursors[i].current()); // Every list is required: leapfrog past the gap
+        }
+        if (count < threshold)
+            continue;
+
+        auto name = nameOf(id);
+        if (!name)
+            continue; // Removed product
+        trigrams(*name, grams);
+        const std::size_t common = countCommon(wanted, grams);
+        if (common < threshold)
+            continue; // Only matched through stale postings
+
+        heap.push_back({id, common});
+        std::push_heap(heap.begin(), heap.end(), better);
+        if (heap.size() > k)
+        {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.pop_back();
+        }
+        if (heap.size() == k)
+            threshold = std::max(threshold, heap.front().common + 1);
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), better);
+    std::vector<SearchHit> hits;
+    hits.reserve(heap.size());
+    for (const Ranked &hit : heap)
+    {
+        hits.push_back({hit.id, static_cast<double>(hit.common) / static_cast<double>(m)});
+    }
+    return hits;
+}
+
+/**
+ * @brief Gets the number of bytes held by the posting lists.
+ *
+ * @return std::size_t The capacity of all delta, block and pending arrays.
+ */
+std::size_t TrigramIndex::postingBytes() const
+{
+    std::size_t total = 0;
+    for (const auto &[gram, list] : lists_)
+        total += list.bytes();
+    return total;
+}
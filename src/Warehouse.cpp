@@ -1,52 +1,817 @@
 #include "Warehouse.hpp"
+#include "Electronic.hpp"
+#include "Clothing.hpp"
+#include "Food.hpp"
+#include "TaskScheduler.hpp"
 #include <algorithm> // For std::sort, std::find_if, std::for_each
+#include <atomic>    // For the price epoch counter
 #include <iostream>  // For std::cout, std::cerr (debugging/info)
+#include <numeric>   // For std::iota, std::transform_reduce
+#include <limits>    // For std::numeric_limits
+
+namespace
+{
+    /** Last price epoch handed out by any warehouse in the process. */
+    std::atomic<std::uint64_t> lastPriceEpoch{0};
+
+    /** Last page change stamp handed out by any warehouse in the process. */
+    std::atomic<std::uint64_t> lastChangeStamp{0};
+}
+
+/**
+ * @brief Draws a new price epoch from the process-wide counter.
+ *
+ * @return An epoch no warehouse has used before.
+ */
+std::uint64_t Warehouse::nextPriceEpoch()
+{
+    return lastPriceEpoch.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/**
+ * @brief Draws a new change stamp and puts it on the pages holding slots [first, last).
+ *
+ * Slots past the end of the store are ignored: when the last slot of a page
+ * is removed, the slots left on that page are unchanged.
+ *
+ * @param first The first changed slot.
+ * @param last One past the last changed slot.
+ * @param hot Whether the ID, price, quantity or type of those slots changed.
+ * @param cold Whether the name, weight or attribute of those slots changed.
+ */
+void Warehouse::markChanged(std::size_t first, std::size_t last, bool hot, bool cold)
+{
+    const std::size_t pages = (store_.size() + changePageSize - 1) / changePageSize;
+    hotPageStamps_.resize(pages);
+    coldPageStamps_.resize(pages);
+    changeStamp_ = lastChangeStamp.fetch_add(1, std::memory_order_relaxed) + 1;
+    last = std::min(last, store_.size());
+    for (std::size_t page = first / changePageSize; first < last && page <= (last - 1) / changePageSize; ++page)
+    {
+        if (hot)
+            hotPageStamps_[page] = changeStamp_;
+        if (cold)
+            coldPageStamps_[page] = changeStamp_;
+    }
+}
+
+/**
+ * @brief Starts a new price epoch for a change to one product and records it.
+ *
+ * When the log is full it is dropped first, so a cache stamped with an epoch
+ * older than that has to recompute.
+ *
+ * @param id The product whose price changed.
+ * @param before The price it contributed before (zero if it did not exist).
+ * @param after The price it contributes now (zero if it was removed).
+ */
+void Warehouse::logPriceChange(int id, Money before, Money after)
+{
+    if (priceLog_.size() == priceLogCapacity)
+    {
+        priceLog_.clear();
+        priceLogStart_ = priceEpoch_;
+    }
+    priceEpoch_ = nextPriceEpoch();
+    priceLog_.push_back({priceEpoch_, id, before, after});
+}
+
+/**
+ * @brief Gets the single-product price changes made since an epoch.
+ *
+ * Epochs in the log are increasing, so the entry that started the given
+ * epoch is found by binary search.
+ *
+ * @param epoch A value priceEpoch() returned earlier.
+ * @return The changes made since, or std::nullopt if they are not all in the log.
+ */
+std::optional<std::span<const PriceChange>> Warehouse::priceChangesSince(std::uint64_t epoch) const
+{
+    std::span<const PriceChange> log = priceLog_;
+    if (epoch == priceLogStart_)
+    {
+        return log;
+    }
+    auto it = std::lower_bound(log.begin(), log.end(), epoch,
+                               [](const PriceChange &change, std::uint64_t e)
+                               { return change.epoch < e; });
+    if (it == log.end() || it->epoch != epoch)
+    {
+        return std::nullopt;
+    }
+    return log.subspan(static_cast<std::size_t>(it - log.begin()) + 1);
+}
+
+namespace
+{
+    static_assert(std::max({alignof(Electronic), alignof(Clothing), alignof(Food)}) <= SlabPool::granularity,
+                  "pooled products must fit SlabPool's alignment");
+
+    /**
+     * @brief Size of the object a pooled product of this type occupies
+     */
+    std::size_t pooledSize(ProductType type)
+    {
+        switch (type)
+        {
+        case ProductType::Electronic:
+            return sizeof(Electronic);
+        case ProductType::Clothing:
+            return sizeof(Clothing);
+        default:
+            return sizeof(Food);
+        }
+    }
+
+    /**
+     * @brief Constructs a product of a built-in type, with an empty name, in a pool
+     * @return Product* The product, or nullptr for ProductType::Other.
+     */
+    Product *constructPooled(SlabPool &pool, ProductType type, Money price, int quantity, double weight,
+                             const std::string &attribute)
+    {
+        switch (type)
+        {
+        case ProductType::Electronic:
+            return ::new (pool.allocate(sizeof(Electronic))) Electronic({}, price, quantity, weight, attribute);
+        case ProductType::Clothing:
+            return ::new (pool.allocate(sizeof(Clothing))) Clothing({}, price, quantity, weight, attribute);
+        case ProductType::Food:
+            return ::new (pool.allocate(sizeof(Food))) Food({}, price, quantity, weight, attribute);
+        default:
+            return nullptr;
+        }
+    }
+}
 
 /**
  * @brief Adds a product to the warehouse.
  *
  * This method takes ownership of a Product represented by a std::unique_ptr and stores it
  * in the warehouse. The use of std::unique_ptr ensures proper memory management by transferring
- * ownership to the products_ container.
+ * ownership to the owned_ container.
  *
  * @param product A unique pointer to the Product to be added. The pointer should not be null.
+ * @return bool false if the pointer is null or a product with the same ID is already present.
  */
-void Warehouse::addProduct(std::unique_ptr<Product> product) {
-    if (product)
+bool Warehouse::addProduct(std::unique_ptr<Product> product) {
+    if (!product)
     { // Ensure product is not nullptr before adding
-        products_.push_back(std::move(product));
+        std::cerr << "Warning: Attempted to add a null product to the warehouse." << std::endl;
+        return false;
     }
-    else
+    if (idIndex_.contains(product->getId()))
     {
-        std::cerr << "Warning: Attempted to add a null product to the warehouse." << std::endl;
+        std::cerr << "Warning: A product with ID " << product->getId() << " is already in the warehouse." << std::endl;
+        return false;
+    }
+    store_.append(*product);
+    Product *raw = product.get();
+    insertAppended(raw, std::move(product));
+    return true;
+}
+
+/**
+ * @brief Builds a product of a built-in type in the product pool and adds it.
+ *
+ * The object is constructed with an empty name, then pointed at the caller's
+ * characters just long enough for the store to copy them into its arena.
+ *
+ * @return const Product* The new product, or nullptr for ProductType::Other or a duplicate ID.
+ */
+const Product *Warehouse::createProduct(ProductType type, std::string_view name, Money price, int quantity,
+                                        double weight, const std::string &attribute)
+{
+    Product *product = constructPooled(productPool_, type, std::max(price, Money()), std::max(quantity, 0),
+                                       weight, attribute);
+    if (product && idIndex_.contains(product->getId()))
+    {
+        std::cerr << "Warning: A product with ID " << product->getId() << " is already in the warehouse." << std::endl;
+        destroyPooled(product);
+        return nullptr;
+    }
+    if (product)
+    {
+        product->useArenaName(name);
+        store_.append(*product);
+        insertAppended(product, nullptr);
+    }
+    return product;
+}
+
+/**
+ * @brief Keeps a product whose data was just appended to the store and indexes it.
+ *
+ * @param product The product.
+ * @param owner Its owner if it came from addProduct, or null if it lives in productPool_.
+ */
+void Warehouse::insertAppended(Product *product, std::unique_ptr<Product> owner)
+{
+    idIndex_[product->getId()] = products_.size();
+    product->useArenaName(store_.name(store_.size() - 1));
+    products_.push_back(product);
+    owned_.push_back(std::move(owner));
+    nameIndex_.insert(store_.name(store_.size() - 1), store_.ids().back());
+    if (!trigramIndexStale_)
+        trigramIndex_.add(store_.ids().back(), store_.name(store_.size() - 1));
+    if (!priceIndexStale_)
+        priceIndex_.insert(store_.prices().back(), store_.ids().back());
+    if (store_.quantities().back() > 0)
+        indexExpiry(products_.size() - 1);
+    indexBitmaps(products_.size() - 1);
+    markChanged(store_.size() - 1, store_.size(), true, true);
+    if (store_.prices().back() != Money())
+        logPriceChange(store_.ids().back(), Money(), store_.prices().back());
+    if (listener_)
+        listener_->productAdded(store_, store_.size() - 1);
+}
+
+/**
+ * @brief Destroys a pooled product and returns its storage to the product pool.
+ *
+ * @param product A product built by constructPooled().
+ */
+void Warehouse::destroyPooled(Product *product)
+{
+    const std::size_t size = pooledSize(product->getType());
+    product->~Product();
+    productPool_.deallocate(product, size);
+}
+
+/**
+ * @brief Pre-allocates room for the given total number of products.
+ *
+ * @param capacity The total number of products to make room for.
+ */
+void Warehouse::reserve(std::size_t capacity)
+{
+    products_.reserve(capacity);
+    owned_.reserve(capacity);
+    store_.reserve(capacity);
+    idIndex_.reserve(capacity);
+    nameIndex_.reserve(capacity);
+}
+
+/**
+ * @brief Replaces the whole warehouse with the products of a filled store.
+ *
+ * Rather than adding the products one at a time, which would update every
+ * index and draw a change stamp and price epoch per product, the indexes are
+ * built from the complete columns. The bitmaps are filled from the IDs in
+ * ascending order and the expiry buckets from the food sorted by date.
+ *
+ * @param store The products; every slot must have a built-in type and a unique ID.
+ */
+void Warehouse::assign(ProductStore store)
+{
+    *this = Warehouse();
+    store_ = std::move(store);
+    const std::size_t count = store_.size();
+    auto ids = store_.ids();
+    auto types = store_.types();
+
+    int nextId = Product::peekNextId();
+    products_.reserve(count);
+    owned_.resize(count);
+    idIndex_.reserve(count);
+    for (std::size_t slot = 0; slot < count; ++slot)
+    {
+        Product::setNextId(ids[slot]);
+        products_.push_back(constructPooled(productPool_, types[slot], store_.prices()[slot],
+                                            store_.quantities()[slot], store_.weights()[slot],
+                                            store_.attributeHandles()[slot].str()));
+        products_.back()->useArenaName(store_.name(slot));
+        idIndex_.emplace(ids[slot], slot);
+        nextId = std::max(nextId, ids[slot] + 1);
+    }
+    Product::setNextId(nextId);
+    nameIndex_.rebuild(store_);
+    priceIndexStale_ = true;
+
+    std::vector<std::size_t> byId(count);
+    std::iota(byId.begin(), byId.end(), std::size_t{0});
+    std::sort(byId.begin(), byId.end(), [ids](std::size_t a, std::size_t b) { return ids[a] < ids[b]; });
+    std::vector<std::uint32_t> all, inStock;
+    std::array<std::vector<std::uint32_t>, productTypeCount> byType;
+    std::array<std::unordered_map<InternedString, std::vector<std::uint32_t>>, productTypeCount> byAttribute;
+    all.reserve(count);
+    for (std::size_t slot : byId)
+    {
+        const auto id = static_cast<std::uint32_t>(ids[slot]);
+        const auto type = static_cast<std::size_t>(types[slot]);
+        all.push_back(id);
+        byType[type].push_back(id);
+        byAttribute[type][store_.attributeHandles()[slot]].push_back(id);
+        if (store_.quantities()[slot] > 0)
+            inStock.push_back(id);
+    }
+    allIds_ = Bitmap::fromSorted(all);
+    inStockIds_ = Bitmap::fromSorted(inStock);
+    for (std::size_t type = 0; type < productTypeCount; ++type)
+    {
+        typeIds_[type] = Bitmap::fromSorted(byType[type]);
+        for (const auto &[value, valueIds] : byAttribute[type])
+            attributeIds_[type].emplace(value, Bitmap::fromSorted(valueIds));
+    }
+
+    std::vector<std::pair<Date, int>> expiring;
+    for (std::size_t slot = 0; slot < count; ++slot)
+    {
+        if (types[slot] != ProductType::Food || store_.quantities()[slot] <= 0)
+            continue;
+        if (auto expiry = static_cast<const Food &>(*products_[slot]).getExpiryDate())
+            expiring.emplace_back(*expiry, ids[slot]);
+    }
+    std::stable_sort(expiring.begin(), expiring.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    for (const auto &[date, id] : expiring)
+        expiryIndex_.try_emplace(expiryIndex_.end(), date)->second.push_back(id);
+
+    markChanged(0, count, true, true);
+}
+
+/**
+ * @brief Removes a product from the warehouse by its ID.
+ *
+ * The product is located through the ID index and erased from products_.
+ * Products behind it shift down one slot, so their index entries are refreshed.
+ *
+ * @param id The ID of the product to remove.
+ * @return true if a product was removed, false if no product with that ID exists.
+ */
+bool Warehouse::removeProduct(int id)
+{
+    auto it = idIndex_.find(id);
+    if (it == idIndex_.end())
+    {
+        return false;
+    }
+    std::size_t slot = it->second;
+    idIndex_.erase(it);
+    unindexExpiry(slot);
+    unindexBitmaps(slot);
+    nameIndex_.erase(store_.name(slot), id);
+    if (!trigramIndexStale_)
+    {
+        trigramIndex_.remove(id, store_.name(slot));
+        trigramIndexStale_ = trigramIndex_.needsRebuild();
+    }
+    if (!priceIndexStale_)
+        priceIndex_.erase(store_.prices()[slot], id);
+    if (store_.prices()[slot] != Money())
+        logPriceChange(id, store_.prices()[slot], Money());
+    if (!owned_[slot])
+        destroyPooled(products_[slot]);
+    products_.erase(products_.begin() + static_cast<std::ptrdiff_t>(slot));
+    owned_.erase(owned_.begin() + static_cast<std::ptrdiff_t>(slot));
+    store_.erase(slot);
+    reindexFrom(slot);
+    markChanged(slot, store_.size(), true, true); // Every later slot moved down
+    if (listener_)
+        listener_->productRemoved(id);
+    return true;
+}
+
+/**
+ * @brief Adds the product in a slot to the expiry index.
+ *
+ * @param slot The slot of the product; ignored unless it is Food with a parsed expiration date.
+ */
+void Warehouse::indexExpiry(std::size_t slot)
+{
+    if (store_.types()[slot] != ProductType::Food)
+    {
+        return;
+    }
+    if (auto expiry = static_cast<const Food &>(*products_[slot]).getExpiryDate())
+    {
+        expiryIndex_[*expiry].push_back(products_[slot]->getId());
+    }
+}
+
+/**
+ * @brief Removes the product in a slot from the expiry index, if it is there.
+ *
+ * Only the bucket of the product's own expiration date is searched.
+ *
+ * @param slot The slot of the product.
+ */
+void Warehouse::unindexExpiry(std::size_t slot)
+{
+    if (store_.types()[slot] != ProductType::Food)
+    {
+        return;
+    }
+    auto expiry = static_cast<const Food &>(*products_[slot]).getExpiryDate();
+    if (!expiry)
+    {
+        return;
+    }
+    auto bucket = expiryIndex_.find(*expiry);
+    if (bucket == expiryIndex_.end())
+    {
+        return;
+    }
+    std::vector<int> &ids = bucket->second;
+    if (auto it = std::find(ids.begin(), ids.end(), products_[slot]->getId()); it != ids.end())
+    {
+        ids.erase(it);
+        if (ids.empty())
+            expiryIndex_.erase(bucket);
+    }
+}
+
+/**
+ * @brief Adds the product in a slot to the bitmap indexes.
+ *
+ * @param slot The slot of the product.
+ */
+void Warehouse::indexBitmaps(std::size_t slot)
+{
+    const auto id = static_cast<std::uint32_t>(store_.ids()[slot]);
+    const auto type = static_cast<std::size_t>(store_.types()[slot]);
+    allIds_.add(id);
+    typeIds_[type].add(id);
+    attributeIds_[type][store_.attributeHandles()[slot]].add(id);
+    if (store_.quantities()[slot] > 0)
+        inStockIds_.add(id);
+}
+
+/**
+ * @brief Removes the product in a slot from the bitmap indexes.
+ *
+ * An attribute value whose last product goes away loses its bitmap too.
+ *
+ * @param slot The slot of the product.
+ */
+void Warehouse::unindexBitmaps(std::size_t slot)
+{
+    const auto id = static_cast<std::uint32_t>(store_.ids()[slot]);
+    const auto type = static_cast<std::size_t>(store_.types()[slot]);
+    allIds_.remove(id);
+    typeIds_[type].remove(id);
+    inStockIds_.remove(id);
+    auto &byValue = attributeIds_[type];
+    if (auto it = byValue.find(store_.attributeHandles()[slot]); it != byValue.end())
+    {
+        it->second.remove(id);
+        if (it->second.empty())
+            byValue.erase(it);
+    }
+}
+
+/**
+ * @brief Rebuilds the ID index entries for every slot from first onwards.
+ *
+ * @param first The first slot of products_ whose index entry may be stale.
+ */
+void Warehouse::reindexFrom(std::size_t first)
+{
+    for (std::size_t slot = first; slot < products_.size(); ++slot)
+    {
+        idIndex_[products_[slot]->getId()] = slot;
+    }
+}
+
+/**
+ * @brief Refreshes the Product view from the hot columns.
+ *
+ * Bulk column operations only mark the view stale; the per-object write-back is
+ * paid once, the next time somebody asks for Product objects.
+ */
+void Warehouse::refreshView() const
+{
+    if (!viewStale_)
+    {
+        return;
+    }
+    for (std::size_t slot = 0; slot < products_.size(); ++slot)
+    {
+        store_.writeBack(slot, *products_[slot]);
+    }
+    viewStale_ = false;
+}
+
+/**
+ * @brief Returns the Product view, refreshed from the columns if necessary.
+ *
+ * @return std::span<const Product *const> The products in slot order.
+ */
+std::span<const Product *const> Warehouse::getProducts() const
+{
+    refreshView();
+    return products_;
+}
+
+/**
+ * @brief Sets the price of a product identified by its ID.
+ *
+ * The Product object applies its usual validation (negative prices become 0)
+ * and the resulting price is stored in the price column.
+ *
+ * @param id The ID of the product.
+ * @param newPrice The new price.
+ * @return true if the product exists, false otherwise.
+ */
+bool Warehouse::setPrice(int id, Money newPrice)
+{
+    auto it = idIndex_.find(id);
+    if (it == idIndex_.end())
+    {
+        return false;
+    }
+    std::size_t slot = it->second;
+    Product &product = *products_[slot];
+    store_.writeBack(slot, product); // The object may be stale after a bulk update
+    const Money oldPrice = product.getPrice();
+    product.setPrice(newPrice);
+    store_.prices()[slot] = product.getPrice();
+    if (!priceIndexStale_)
+    {
+        priceIndex_.erase(oldPrice, id);
+        priceIndex_.insert(product.getPrice(), id);
+    }
+    if (product.getPrice() != oldPrice)
+    {
+        logPriceChange(id, oldPrice, product.getPrice());
+        markChanged(slot, slot + 1, true, false);
+    }
+    if (listener_)
+        listener_->priceSet(id, product.getPrice());
+    return true;
+}
+
+/**
+ * @brief Changes the stock quantity of a product identified by its ID.
+ *
+ * The Product object applies its usual validation (the result never drops below 0)
+ * and the resulting quantity is stored in the quantity column.
+ *
+ * @param id The ID of the product.
+ * @param delta The change in quantity.
+ * @return true if the product exists, false otherwise.
+ */
+bool Warehouse::updateQuantity(int id, int delta)
+{
+    auto it = idIndex_.find(id);
+    if (it == idIndex_.end())
+    {
+        return false;
+    }
+    std::size_t slot = it->second;
+    Product &product = *products_[slot];
+    store_.writeBack(slot, product);
+    const int oldQuantity = product.getQuantity();
+    const bool wasInStock = oldQuantity > 0;
+    product.updateQuantity(delta);
+    store_.quantities()[slot] = product.getQuantity();
+    if (product.getQuantity() != oldQuantity)
+        markChanged(slot, slot + 1, true, false);
+    if (wasInStock && product.getQuantity() == 0)
+    {
+        unindexExpiry(slot);
+        inStockIds_.remove(static_cast<std::uint32_t>(id));
+    }
+    else if (!wasInStock && product.getQuantity() > 0)
+    {
+        indexExpiry(slot);
+        inStockIds_.add(static_cast<std::uint32_t>(id));
+    }
+    if (listener_)
+        listener_->quantitySet(id, product.getQuantity());
+    return true;
+}
+
+/**
+ * @brief Calculates the value of all stock in the warehouse.
+ *
+ * @return Money The exact sum of price * quantity over the hot columns.
+ */
+Money Warehouse::totalStockValue() const
+{
+    auto prices = store_.prices();
+    auto quantities = store_.quantities();
+    return std::transform_reduce(prices.begin(), prices.end(), quantities.begin(), Money(), std::plus<>(),
+                                 [](Money price, int quantity) { return price * quantity; });
+}
+
+/**
+ * @brief Counts the units in stock across all products.
+ *
+ * @return long long The sum of the quantity column.
+ */
+long long Warehouse::totalUnits() const
+{
+    auto quantities = store_.quantities();
+    return std::accumulate(quantities.begin(), quantities.end(), 0LL);
+}
+
+/**
+ * @brief Calculates the stock value of each product type.
+ *
+ * A single pass over the price, quantity and type columns; the type tag
+ * selects the accumulator directly.
+ *
+ * @return std::array<Money, productTypeCount> The stock value per ProductType.
+ */
+std::array<Money, productTypeCount> Warehouse::stockValueByType() const
+{
+    std::array<Money, productTypeCount> values{};
+    auto prices = store_.prices();
+    auto quantities = store_.quantities();
+    auto types = store_.types();
+    for (std::size_t slot = 0; slot < types.size(); ++slot)
+    {
+        values[static_cast<std::size_t>(types[slot])] += prices[slot] * quantities[slot];
+    }
+    return values;
+}
+
+/**
+ * @brief Groups the products of one type by their attribute value.
+ *
+ * Walks the type, attribute-handle and quantity columns once; the handle is
+ * the grouping key.
+ *
+ * @param type The product type to group.
+ * @return std::vector<AttributeGroup> One group per distinct value, in order of first appearance.
+ */
+std::vector<AttributeGroup> Warehouse::groupByAttribute(ProductType type) const
+{
+    std::vector<AttributeGroup> groups;
+    std::unordered_map<InternedString, std::size_t> groupOf;
+    auto types = store_.types();
+    auto attributes = store_.attributeHandles();
+    auto quantities = store_.quantities();
+    for (std::size_t slot = 0; slot < types.size(); ++slot)
+    {
+        if (types[slot] != type)
+            continue;
+        auto [it, inserted] = groupOf.try_emplace(attributes[slot], groups.size());
+        if (inserted)
+            groups.push_back({attributes[slot]});
+        AttributeGroup &group = groups[it->second];
+        ++group.products;
+        group.units += quantities[slot];
+    }
+    return groups;
+}
+
+/**
+ * @brief Lists food in stock that expires before a date.
+ *
+ * Walks the expiry buckets in date order and stops at the first bucket on or
+ * after the limit.
+ *
+ * @param limit The first date not included.
+ * @return std::vector<int> The product IDs, earliest expiration date first.
+ */
+std::vector<int> Warehouse::expiringBefore(Date limit) const
+{
+    std::vector<int> ids;
+    for (auto bucket = expiryIndex_.begin(); bucket != expiryIndex_.end() && bucket->first < limit; ++bucket)
+    {
+        ids.insert(ids.end(), bucket->second.begin(), bucket->second.end());
     }
+    return ids;
+}
+
+/**
+ * @brief Sets the quantity of all food that expired before a date to zero.
+ *
+ * The expired IDs are collected first, because writing a product off removes
+ * it from the index being walked.
+ *
+ * @param today Products with an expiration date before this day are written off.
+ * @return WriteOffReport How many products and units were written off, and their value.
+ */
+WriteOffReport Warehouse::writeOffExpired(Date today)
+{
+    WriteOffReport report;
+    for (int id : expiringBefore(today))
+    {
+        std::size_t slot = idIndex_.at(id);
+        const int units = store_.quantities()[slot];
+        report.products += 1;
+        report.units += units;
+        report.value += store_.prices()[slot] * units;
+        updateQuantity(id, -units);
+    }
+    return report;
+}
+
+/**
+ * @brief Renames a product identified by its ID.
+ *
+ * The old name is removed from the name index before the column entry is
+ * replaced, because the index holds a view of the old name.
+ *
+ * @param id The ID of the product.
+ * @param newName The new name.
+ * @return true if the product exists, false otherwise.
+ */
+bool Warehouse::renameProduct(int id, const std::string &newName)
+{
+    auto it = idIndex_.find(id);
+    if (it == idIndex_.end())
+    {
+        return false;
+    }
+    std::size_t slot = it->second;
+    nameIndex_.erase(store_.name(slot), id);
+    const std::string_view oldName = store_.name(slot); // The arena keeps the old characters
+    products_[slot]->useArenaName(store_.rename(slot, newName));
+    nameIndex_.insert(store_.name(slot), id);
+    markChanged(slot, slot + 1, false, true);
+    if (!trigramIndexStale_)
+    {
+        trigramIndex_.rename(id, oldName, newName);
+        trigramIndexStale_ = trigramIndex_.needsRebuild();
+    }
+    if (listener_)
+        listener_->productRenamed(id, newName);
+    return true;
 }
 
 /**
  * @brief Finds a product in the warehouse by its name.
- * * This method searches the warehouse inventory for a product with the specified name
- * using std::find_if. Each call to this method increments an internal access counter.
+ * * This method looks the name up in the exact-match name index (constant time
+ * on average). When several products share the name, the one in the lowest
+ * slot wins, which is the product a scan of products_ would find first.
+ * Each call to this method increments an internal access counter.
  * * @param name The name of the product to find.
  * @return std::optional<const Product*> An optional containing a pointer to the found product,
  * or std::nullopt if no product with the given name exists in the warehouse.
  * * @note This is a const method that modifies the mutable accessCount_ member variable.
  */
-std::optional<const Product*> Warehouse::findProductByName(const std::string& name) const {
+std::optional<const Product*> Warehouse::findProductByName(std::string_view name) const {
     ++accessCount_; // mutable variable can be changed in const method
-    auto it = std::find_if(products_.begin(), products_.end(),
-                           [&name](const std::unique_ptr<Product> &p_ptr) { // Capture name by reference
-                               return p_ptr && p_ptr->getName() == name;    // Add null check for p_ptr
-                           });
-    if (it != products_.end()) {
-        return it->get(); // Returns const Product*
+    std::size_t best = products_.size();
+    nameIndex_.forEachExact(name, [this, &best](int id)
+                            { best = std::min(best, idIndex_.at(id)); });
+    if (best == products_.size()) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    refreshView();
+    return products_[best]; // Returns const Product*
+}
+
+/**
+ * @brief Finds the products whose name starts with a prefix.
+ *
+ * @param prefix The start of the name.
+ * @param limit The largest number of IDs to return.
+ * @return std::vector<int> The product IDs, ordered by name (then by ID).
+ */
+std::vector<int> Warehouse::findProductsByPrefix(std::string_view prefix, std::size_t limit) const
+{
+    ++accessCount_;
+    return nameIndex_.withPrefix(prefix, limit);
+}
+
+/**
+ * @brief Searches product names for a text, tolerating typos.
+ *
+ * Builds the trigram index on first use. Candidates are re-scored against
+ * their current names, looked up through the ID index.
+ *
+ * @param query The text to look for.
+ * @param k The largest number of results.
+ * @return std::vector<SearchHit> Up to k product IDs with their scores, best first.
+ */
+std::vector<SearchHit> Warehouse::searchProducts(std::string_view query, std::size_t k) const
+{
+    ++accessCount_;
+    return trigramIndex().search(query, k, [this](int id) -> std::optional<std::string_view>
+                                 {
+        auto it = idIndex_.find(id);
+        if (it == idIndex_.end())
+            return std::nullopt;
+        return store_.name(it->second); });
+}
+
+/**
+ * @brief Returns the trigram index, rebuilt from the name column if it is stale.
+ *
+ * The index is built on the first search rather than on every insert, so
+ * warehouses that are never searched do not pay for it.
+ *
+ * @return const TrigramIndex& The trigram index over all product names.
+ */
+const TrigramIndex &Warehouse::trigramIndex() const
+{
+    if (trigramIndexStale_)
+    {
+        trigramIndex_.rebuild(store_);
+        trigramIndexStale_ = false;
+    }
+    return trigramIndex_;
 }
 
 /**
  * @brief Searches for a product with the specified ID in the warehouse.
  *
- * This method iterates through the products in the warehouse using std::find_if
+ * This method looks the ID up in the idIndex_ hash map (constant time on average)
  * and returns a product pointer wrapped in std::expected if found, or an error message
  * if not found. The returned pointer points to the product owned by the
  * warehouse and should not be deleted by the caller.
@@ -57,13 +822,10 @@ std::optional<const Product*> Warehouse::findProductByName(const std::string& na
  */
 std::expected<const Product *, std::string> Warehouse::findProductById(int id) const
 {
-    auto it = std::find_if(products_.begin(), products_.end(),
-                           [id](const std::unique_ptr<Product> &p_ptr) // Capture id by value
-                           {
-                               return p_ptr && p_ptr->getId() == id; // Add null check for p_ptr
-                           });
-    if (it != products_.end()) {
-        return it->get(); // Returns const Product*
+    auto it = idIndex_.find(id);
+    if (it != idIndex_.end()) {
+        refreshView();
+        return products_[it->second]; // Returns const Product*
     }
     else
     {
@@ -71,23 +833,45 @@ std::expected<const Product *, std::string> Warehouse::findProductById(int id) c
     }
 }
 
+/**
+ * @brief Resolves product IDs to their slots in the columnar store.
+ *
+ * One hash lookup per ID; unknown IDs get noSlot. The lookups only read the
+ * index, so ranges of IDs are resolved in parallel on the task scheduler.
+ *
+ * @param ids The product IDs to resolve.
+ * @param slots Receives one slot per ID.
+ */
+void Warehouse::resolveSlots(std::span<const int> ids, std::span<std::size_t> slots) const
+{
+    TaskScheduler::global().parallelFor(0, ids.size(), TaskScheduler::grains().slotResolution,
+                                        [this, ids, slots](std::size_t from, std::size_t to)
+                                        {
+                                            for (std::size_t i = from; i < to; ++i)
+                                            {
+                                                auto it = idIndex_.find(ids[i]);
+                                                slots[i] = it != idIndex_.end() ? it->second : noSlot;
+                                            }
+                                        });
+}
+
 /**
  * @brief Prints information about all products in the given span.
  *
  * This method iterates through each product in the provided span using std::for_each
  * and calls the printInfo() method on each product to display its information.
  *
- * @param products_span A span of const unique_ptr<Product> objects whose
+ * @param products_span A span of pointers to Product objects whose
  * information will be printed.
  */
-void Warehouse::printProductsInfo(std::span<const std::unique_ptr<Product>> products_span) const
+void Warehouse::printProductsInfo(std::span<const Product *const> products_span) const
 {
     if (products_span.empty())
     {
         std::cout << "No products to display." << std::endl;
         return;
     }
-    std::for_each(products_span.begin(), products_span.end(), [](const std::unique_ptr<Product> &p_ptr)
+    std::for_each(products_span.begin(), products_span.end(), [](const Product *p_ptr)
                   {
         if (p_ptr) { // Check if the pointer is not null
             p_ptr->printInfo();
@@ -96,41 +880,251 @@ void Warehouse::printProductsInfo(std::span<const std::unique_ptr<Product>> prod
 
 /**
  * @brief Sorts the products in the warehouse by price in ascending order.
- * * This method uses std::sort with a lambda comparator to sort all products
- * based on their prices, from lowest to highest. If prices are equal,
- * the original relative order might not be preserved (std::sort is not guaranteed to be stable).
- * It relies on Product::operator<=> for comparison logic indirectly via getPrice().
- * * @note This operation modifies the order of products in the warehouse.
+ * * The comparison runs over the contiguous price column: a permutation of slots
+ * is sorted stably on the task scheduler (so equal prices keep their relative
+ * order and the result is deterministic whatever the thread count), then
+ * applied to the columns and the Product view.
+ * * @note This operation modifies the order of products in the warehouse,
+ * so the ID index is rebuilt afterwards.
  */
 void Warehouse::sortByPriceAscending() {
-    std::sort(products_.begin(), products_.end(),
-              [](const std::unique_ptr<Product> &a, const std::unique_ptr<Product> &b)
-              {
-                  if (!a || !b)
-                      return false; // Handle nullptrs if they could exist, 'a' less than 'b' if 'b' is null
-                  // For a more robust sort considering potential NaN or using spaceship:
-                  // return (*a <=> *b) < 0; // If spaceship gives total order or partial that works for sort
-                  // Simpler price comparison:
-                  return a->getPrice() < b->getPrice();
-              });
+    auto prices = store_.prices();
+    std::vector<std::size_t> order(prices.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    TaskScheduler::global().parallelSort(
+        order.begin(), order.end(), [prices](std::size_t a, std::size_t b) { return prices[a] < prices[b]; },
+        TaskScheduler::grains().sort);
+
+    std::vector<Product *> reordered;
+    std::vector<std::unique_ptr<Product>> reorderedOwners;
+    reordered.reserve(products_.size());
+    reorderedOwners.reserve(owned_.size());
+    for (std::size_t from : order)
+    {
+        reordered.push_back(products_[from]);
+        reorderedOwners.push_back(std::move(owned_[from]));
+    }
+    products_ = std::move(reordered);
+    owned_ = std::move(reorderedOwners);
+    store_.permute(order);
+    reindexFrom(0);
+    markChanged(0, store_.size(), true, true);
+    if (listener_)
+        listener_->sortedByPrice();
+}
+
+/**
+ * @brief Builds a selection mask for the products matched by a filter.
+ *
+ * Type and price criteria are evaluated column-wise; an ID list is resolved
+ * through the ID index, so its cost depends on the list length, not the catalog.
+ * A bitmap selection is tested against the ID column in one pass.
+ *
+ * @param filter The criteria to evaluate (all set criteria must match).
+ * @return std::vector<std::uint8_t> One byte per slot, 1 for selected products.
+ */
+std::vector<std::uint8_t> Warehouse::select(const ProductFilter &filter) const
+{
+    const std::size_t count = store_.size();
+    std::vector<std::uint8_t> mask(count, 1);
+
+    if (!filter.ids.empty())
+    {
+        std::fill(mask.begin(), mask.end(), 0);
+        for (int id : filter.ids)
+        {
+            auto it = idIndex_.find(id);
+            if (it != idIndex_.end())
+            {
+                mask[it->second] = 1;
+            }
+        }
+    }
+    if (filter.type)
+    {
+        auto types = store_.types();
+        const ProductType wanted = *filter.type;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            mask[i] &= static_cast<std::uint8_t>(types[i] == wanted);
+        }
+    }
+    if (filter.selection)
+    {
+        filter.selection->select(store_.ids(), mask);
+    }
+    if (filter.minPrice || filter.maxPrice)
+    {
+        auto prices = store_.prices();
+        const Money low = filter.minPrice.value_or(Money::fromCents(std::numeric_limits<std::int64_t>::min()));
+        const Money high = filter.maxPrice.value_or(Money::fromCents(std::numeric_limits<std::int64_t>::max()));
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            mask[i] &= static_cast<std::uint8_t>(prices[i] >= low && prices[i] <= high);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Applies a sequence of bulk price adjustments to the selected products.
+ *
+ * When the filter selects everything the unmasked kernel is used; otherwise the
+ * mask from select() is computed once and every step blends through it. The
+ * price column is cut into ranges that are repriced in parallel on the task
+ * scheduler, each range going through all the steps while it is in cache.
+ *
+ * @param steps The adjustments to apply, in order.
+ * @param filter The products to reprice.
+ * @return std::size_t The number of products repriced.
+ */
+std::size_t Warehouse::reprice(std::span<const PriceAdjustment> steps, const ProductFilter &filter)
+{
+    auto prices = store_.prices();
+    std::size_t affected = prices.size();
+
+    TaskScheduler &scheduler = TaskScheduler::global();
+    const std::size_t grain = TaskScheduler::grains().reprice;
+    if (filter.selectsAll())
+    {
+        scheduler.parallelFor(0, prices.size(), grain, [prices, steps](std::size_t from, std::size_t to)
+                              {
+            for (const PriceAdjustment &step : steps)
+            {
+                Repricing::apply(prices.subspan(from, to - from), step);
+            } });
+        if (!steps.empty())
+            markChanged(0, prices.size(), true, false);
+    }
+    else
+    {
+        std::vector<std::uint8_t> mask = select(filter);
+        affected = static_cast<std::size_t>(std::count(mask.begin(), mask.end(), std::uint8_t{1}));
+        std::span<const std::uint8_t> selected = mask;
+        scheduler.parallelFor(0, prices.size(), grain, [prices, selected, steps](std::size_t from, std::size_t to)
+                              {
+            for (const PriceAdjustment &step : steps)
+            {
+                Repricing::applyMasked(prices.subspan(from, to - from), selected.subspan(from, to - from), step);
+            } });
+        if (affected > 0 && !steps.empty())
+        {
+            // Only the pages holding a selected product are stamped
+            markChanged(0, 0, false, false);
+            for (std::size_t page = 0; page < hotPageStamps_.size(); ++page)
+            {
+                auto begin = mask.begin() + static_cast<std::ptrdiff_t>(page * changePageSize);
+                auto end = mask.begin() + static_cast<std::ptrdiff_t>(std::min(mask.size(), (page + 1) * changePageSize));
+                if (std::find(begin, end, std::uint8_t{1}) != end)
+                    hotPageStamps_[page] = changeStamp_;
+            }
+        }
+    }
+
+    if (affected > 0 && !steps.empty())
+    {
+        viewStale_ = true;
+        priceIndexStale_ = true; // Rebuilding once is cheaper than one tree update per product
+        priceEpoch_ = nextPriceEpoch(); // Too many changes to log one by one
+        priceLogStart_ = priceEpoch_;
+        priceLog_.clear();
+        if (listener_)
+            listener_->repriced(steps, filter);
+    }
+    return affected;
+}
+
+/**
+ * @brief Applies a single bulk price adjustment to the selected products.
+ *
+ * @param step The adjustment to apply.
+ * @param filter The products to reprice.
+ * @return std::size_t The number of products repriced.
+ */
+std::size_t Warehouse::reprice(const PriceAdjustment &step, const ProductFilter &filter)
+{
+    return reprice(std::span<const PriceAdjustment>(&step, 1), filter);
+}
+
+/**
+ * @brief Gets the IDs of the products of one type with an attribute value.
+ *
+ * @param type The product type.
+ * @param value The warranty, size or expiration date, depending on type.
+ * @return const Bitmap& The matching IDs; an empty bitmap if no product has that value.
+ */
+const Bitmap &Warehouse::idsWithAttribute(ProductType type, InternedString value) const
+{
+    static const Bitmap none;
+    const auto &byValue = attributeIds_[static_cast<std::size_t>(type)];
+    auto it = byValue.find(value);
+    return it != byValue.end() ? it->second : none;
+}
+
+/**
+ * @brief Returns the price index, rebuilt from the columns if a bulk reprice made it stale.
+ *
+ * @return const PriceIndex& The (price, ID) entries of all products in ascending order.
+ */
+const PriceIndex &Warehouse::priceIndex() const
+{
+    if (priceIndexStale_)
+    {
+        priceIndex_.rebuild(store_.prices(), store_.ids());
+        priceIndexStale_ = false;
+    }
+    return priceIndex_;
+}
+
+/**
+ * @brief Lists the products whose price lies in [low, high].
+ *
+ * @param low The lowest price included.
+ * @param high The highest price included.
+ * @return std::vector<int> The product IDs, cheapest first.
+ */
+std::vector<int> Warehouse::productsInPriceRange(Money low, Money high) const
+{
+    std::vector<int> ids;
+    for (const PriceIndex::Entry &entry : priceIndex().range(low, high))
+    {
+        ids.push_back(entry.id);
+    }
+    return ids;
+}
+
+/**
+ * @brief Lists the k cheapest products.
+ *
+ * @param k The number of products wanted.
+ * @return std::vector<int> The product IDs, cheapest first.
+ */
+std::vector<int> Warehouse::cheapestProducts(std::size_t k) const
+{
+    return priceIndex().cheapest(k);
+}
+
+/**
+ * @brief Lists the k most expensive products.
+ *
+ * @param k The number of products wanted.
+ * @return std::vector<int> The product IDs, most expensive first.
+ */
+std::vector<int> Warehouse::mostExpensiveProducts(std::size_t k) const
+{
+    return priceIndex().mostExpensive(k);
 }
 
 /**
  * @brief Operator() overload for the Warehouse class, used to execute periodic operations on products.
- * * This method iterates through all products stored in the warehouse using std::for_each
- * and updates their prices. Currently, it implements a simple pricing strategy
- * where each product's price is reduced by 1% in each execution cycle.
+ * * This method reprices every product through the vectorised bulk kernel.
+ * Currently, it implements a simple pricing strategy where each product's price is
+ * reduced by 1% in each execution cycle. The Product view is refreshed lazily.
  * * Usage example:
  * Warehouse warehouse;
  * // ... add products ...
  * warehouse(); // Executes this operator, updating all product prices
  */
 void Warehouse::operator()() {
-    std::for_each(products_.begin(), products_.end(), [](std::unique_ptr<Product> &p_ptr)
-                  {
-        if (p_ptr) { // Check if the pointer is not null
-            double currentPrice = p_ptr->getPrice();
-            double newPrice = currentPrice * 0.99; // Reduce price by 1%
-            p_ptr->setPrice(newPrice);
-        } });
-}
\ No newline at end of file
+    reprice(PriceAdjustment::multiply(0.99)); // Reduce price by 1%
+}